@@ -17,6 +17,19 @@ std::string CONTROLLER_MAP_PATH;
 int FONT_SIZE;
 int CAMERA_X;
 int CAMERA_Y;
+int EVENT_STATS_INTERVAL;
+std::string STATE_TABLE_PATH = "etc/templates/state_tables/default.json";
+std::string ATLAS_SOURCE_DIR;
+int ATLAS_PAGE_SIZE = 2048;
+bool RENDER_THREAD = false;
+bool DEBUG_DRAW = false;
+int TEXTURE_DECODE_THREADS = 0;
+int TEXTURE_BUDGET_MB = 256;
+int SOUND_VOICES = 16;
+std::string ASSET_PACK;
+bool HOT_RELOAD = false;
+bool SCENE_PREFETCH = true;
+int SPLASH_MIN_MS = 2000;
 
 void loadConfig(const std::string& path) {
     /**
@@ -47,4 +60,17 @@ void loadConfig(const std::string& path) {
     CONTROLLER_MAP_PATH = j["CONTROLLER_MAP_PATH"];
     CAMERA_X = j["CAMERA_X"];
     CAMERA_Y = j["CAMERA_Y"];
+    EVENT_STATS_INTERVAL = j.value("EVENT_STATS_INTERVAL", 0);
+    STATE_TABLE_PATH = j.value("STATE_TABLE_PATH", STATE_TABLE_PATH);
+    ATLAS_SOURCE_DIR = j.value("ATLAS_SOURCE_DIR", ATLAS_SOURCE_DIR);
+    ATLAS_PAGE_SIZE = j.value("ATLAS_PAGE_SIZE", ATLAS_PAGE_SIZE);
+    RENDER_THREAD = j.value("RENDER_THREAD", RENDER_THREAD);
+    DEBUG_DRAW = j.value("DEBUG_DRAW", DEBUG_DRAW);
+    TEXTURE_DECODE_THREADS = j.value("TEXTURE_DECODE_THREADS", TEXTURE_DECODE_THREADS);
+    TEXTURE_BUDGET_MB = j.value("TEXTURE_BUDGET_MB", TEXTURE_BUDGET_MB);
+    SOUND_VOICES = j.value("SOUND_VOICES", SOUND_VOICES);
+    ASSET_PACK = j.value("ASSET_PACK", ASSET_PACK);
+    HOT_RELOAD = j.value("HOT_RELOAD", HOT_RELOAD);
+    SCENE_PREFETCH = j.value("SCENE_PREFETCH", SCENE_PREFETCH);
+    SPLASH_MIN_MS = j.value("SPLASH_MIN_MS", SPLASH_MIN_MS);
 }
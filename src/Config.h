@@ -16,6 +16,19 @@ extern std::string CONTROLLER_MAP_PATH;
 extern int FONT_SIZE;
 extern int CAMERA_X;
 extern int CAMERA_Y;
+extern int EVENT_STATS_INTERVAL;
+extern std::string STATE_TABLE_PATH;
+extern std::string ATLAS_SOURCE_DIR;
+extern int ATLAS_PAGE_SIZE;
+extern bool RENDER_THREAD;
+extern bool DEBUG_DRAW;
+extern int TEXTURE_DECODE_THREADS;
+extern int TEXTURE_BUDGET_MB;
+extern int SOUND_VOICES;
+extern std::string ASSET_PACK;
+extern bool HOT_RELOAD;
+extern bool SCENE_PREFETCH;
+extern int SPLASH_MIN_MS;
 
 void loadConfig(const std::string& path);
 
@@ -6,6 +6,8 @@
 
 #include <SDL2/SDL.h>
 
+#include "../Resources/TextureHandle.h"
+
 enum class playerState
 {
     IDLE,
@@ -23,6 +25,8 @@ enum class playerState
     BASIC_ATTACK
 };
 
+constexpr int PLAYER_STATE_COUNT = static_cast<int>(playerState::BASIC_ATTACK) + 1;  // keep in sync with playerState
+
 enum class Action
 {
     JUMP,
@@ -111,28 +115,41 @@ struct AnimationClip
 {
     /**
      * A struct representing an animation clip
-     * It contains a vector of SDL_Textures
-     * representing the frames of the animation
-     * This struct might be used to hold the running animation
+     * It contains the sprite sheet and the source rects
+     * of each frame of the animation
+     * Clips are immutable and shared through the AnimationLibrary
      */
     SDL_Texture *spriteSheet;
     std::vector<SDL_Rect> frames;
     int framesPerImage;
     bool loop;
     std::string spritePath;
-    AnimationClip(SDL_Texture *spriteSheet, std::vector<SDL_Rect> frames, int framesPerImage, bool loop, std::string spritePath)
-        : spriteSheet(spriteSheet), frames(frames), framesPerImage(framesPerImage), loop(loop), spritePath(spritePath) {}
+    TextureHandle spriteSheetHandle;  // each Animator using the clip holds a reference
+    AnimationClip(SDL_Texture *spriteSheet, std::vector<SDL_Rect> frames, int framesPerImage, bool loop, std::string spritePath, TextureHandle spriteSheetHandle = INVALID_TEXTURE_HANDLE)
+        : spriteSheet(spriteSheet), frames(frames), framesPerImage(framesPerImage), loop(loop), spritePath(spritePath), spriteSheetHandle(spriteSheetHandle) {}
+};
+
+struct ClipSet
+{
+    /**
+     * The clips loaded from one animator file, indexed by playerState
+     * A state without an animation has a nullptr clip
+     */
+    const AnimationClip* clips[PLAYER_STATE_COUNT];
 };
 
 struct Animator
 {
-    std::map<playerState, AnimationClip> animations;
+    const ClipSet* clipSet;  // owned by the AnimationLibrary and shared by every entity using the same animator file
     playerState currentAnimation;
     int currentFrame;
     int currentImage;
     bool isPlaying;
-    Animator(std::map<playerState, AnimationClip> animations, playerState currentAnimation, int currentFrame, int currentImage, bool isPlaying)
-        : animations(animations), currentAnimation(currentAnimation), currentFrame(currentFrame), currentImage(currentImage), isPlaying(isPlaying) {}
+    Animator(const ClipSet* clipSet, playerState currentAnimation, int currentFrame, int currentImage, bool isPlaying)
+        : clipSet(clipSet), currentAnimation(currentAnimation), currentFrame(currentFrame), currentImage(currentImage), isPlaying(isPlaying) {}
+    const AnimationClip* getClip(playerState state) const {
+        return clipSet != nullptr ? clipSet->clips[static_cast<int>(state)] : nullptr;
+    }
 };
 
 struct State
@@ -142,6 +159,18 @@ struct State
     State(playerState state, bool isFlying) : state(state), isFlying(isFlying) {}
 };
 
+struct StateTable
+{
+    int tableId;  // id in the EntityManager's TransitionTableLibrary
+    StateTable(int tableId) : tableId(tableId) {}
+};
+
+struct Prefab
+{
+    std::string templatePath;  // the template the entity was made from, for reloading it when the file changes
+    Prefab(std::string templatePath) : templatePath(templatePath) {}
+};
+
 struct Player
 {
     int playerNumber;
@@ -178,7 +207,17 @@ struct Sprite
 {
     SDL_Texture *texture;
     SDL_Rect srcRect;
-    Sprite(SDL_Texture *texture, SDL_Rect srcRect) : texture(texture), srcRect(srcRect) {}
+    TextureHandle textureHandle;  // a reference released when the entity is removed
+    TextureHandle drawnHandle;    // the handle of texture, an Animator switches both to its clip's sheet
+    Sprite(SDL_Texture *texture, SDL_Rect srcRect, TextureHandle textureHandle = INVALID_TEXTURE_HANDLE)
+        : texture(texture), srcRect(srcRect), textureHandle(textureHandle), drawnHandle(textureHandle) {}
+};
+
+struct RenderLayer
+{
+    int layer;  // higher layers are drawn on top
+    int depth;  // order within the layer, higher is drawn later
+    RenderLayer(int layer, int depth) : layer(layer), depth(depth) {}
 };
 
 struct Gravity
@@ -1,9 +1,9 @@
 #include <vector>
-#include <iostream>
 #include "../Resources/TextureManager.h"
 #include "../ECS/Components.h"
 
 #include "Entity.h"
+#include "../Logger.h"
 #include "../Utils.h"
 
 
@@ -25,7 +25,7 @@ void Entity::changeState(playerState newState) {
         animator.currentFrame = 0;
         animator.currentImage = 0;
         animator.isPlaying = true;
-        std::cout << "State changed to: " << Utils::playerStateToString(getComponent<State>().state) << std::endl;
+        LOG_DEBUG("state", "Entity " << id << " state changed to: " << Utils::playerStateToString(newState));
     }
 }
 
@@ -157,3 +157,15 @@ SDL_Rect Entity::getHitboxRect(Hitbox& hitbox) {
 }
 
 
+
+void Entity::destroyComponents() {
+    /**
+     * Delete the components, only for an entity no copy shares them with, like a throwaway one built to check a template
+     */
+    for (auto& [type, component] : components) {
+        if (component.destroy != nullptr) {
+            component.destroy(component.data);
+        }
+    }
+    components.clear();
+}
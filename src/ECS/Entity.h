@@ -37,27 +37,38 @@ public:
     SDL_Rect getColliderRect();
     SDL_Rect calculateColliderRect();
     SDL_Rect getHitboxRect(Hitbox& hitbox);
+    void destroyComponents();
     bool operator==(const Entity& other) const {
         return getID() == other.getID();
     }
 
 private:
-    std::unordered_map<std::type_index, void*> components;
+    struct StoredComponent {
+        void* data;
+        void (*destroy)(void*);  // knows the type data was created with
+    };
+    std::unordered_map<std::type_index, StoredComponent> components;
 };
 
 template <typename T>
 void Entity::addComponent(T component) {
-    components[std::type_index(typeid(T))] = new T(component);
+    // copies of the entity share its components, so an existing one is overwritten where it is
+    auto existing = components.find(std::type_index(typeid(T)));
+    if (existing != components.end()) {
+        *static_cast<T*>(existing->second.data) = component;
+        return;
+    }
+    components[std::type_index(typeid(T))] = {new T(component), [](void* data) { delete static_cast<T*>(data); }};
 }
 
 template <typename T>
 T& Entity::getComponent() {
-    return *static_cast<T*>(components[std::type_index(typeid(T))]);
+    return *static_cast<T*>(components[std::type_index(typeid(T))].data);
 }
 
 template <typename T>
 const T& Entity::getComponent() const {
-    return *static_cast<const T*>(components.at(std::type_index(typeid(T))));
+    return *static_cast<const T*>(components.at(std::type_index(typeid(T))).data);
 }
 
 template <typename T>
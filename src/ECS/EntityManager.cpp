@@ -1,8 +1,9 @@
-#include <fstream>
+#include <algorithm>
 #include <iostream>
 
 #include "EntityManager.h"
 #include "../Utils.h"
+#include "../Resources/AssetPack.h"
 
 std::map<std::string, playerState> EntityManager::playerStatesMap = {
         {"IDLE",              playerState::IDLE},
@@ -38,6 +39,7 @@ EntityManager::EntityManager(TextureManager* textureManager, SDL_Renderer* rende
             {"Collider", &EntityManager::addComponentCollider},
             {"Sprite", &EntityManager::addComponentSprite},
             {"State", &EntityManager::addComponentState},
+            {"StateTable", &EntityManager::addComponentStateTable},
             {"Velocity", &EntityManager::addComponentVelocity},
             {"Gravity", &EntityManager::addComponentGravity},
             {"Input", &EntityManager::addComponentInput},
@@ -46,21 +48,31 @@ EntityManager::EntityManager(TextureManager* textureManager, SDL_Renderer* rende
             {"Health", &EntityManager::addComponentHealth},
             {"AttackMap", &EntityManager::addComponentAttackMap},
             {"Animator", &EntityManager::addComponentAnimator},
-            {"AI", &EntityManager::addComponentAI}
+            {"AI", &EntityManager::addComponentAI},
+            {"RenderLayer", &EntityManager::addComponentRenderLayer}
     };
 }
 
 void EntityManager::clearEntities() {
     /**
-     * Clear the entities vector
+     * Clear the entities vector, releasing the textures they used
      */
+    for (Entity& entity : entities) {
+        releaseTextures(entity);
+    }
     entities.clear();
+    structureVersion++;
 }
 
 void EntityManager::removeEntity(int entityId) {
-    entities.erase(std::remove_if(entities.begin(), entities.end(), [&](const Entity& entity) {
-        return entity.getID() == entityId;
+    entities.erase(std::remove_if(entities.begin(), entities.end(), [&](Entity& entity) {
+        if (entity.getID() != entityId) {
+            return false;
+        }
+        releaseTextures(entity);
+        return true;
     }), entities.end());
+    structureVersion++;
 }
 
 Entity& EntityManager::createEntity() {
@@ -68,9 +80,36 @@ Entity& EntityManager::createEntity() {
      * Create a new entity, append it to the entities vector and return a reference to it
      */
     entities.emplace_back(Entity(entities.size()));
+    structureVersion++;
     return entities.back();
 }
 
+void EntityManager::releaseTextures(Entity& entity) {
+    /**
+     * Drop the texture references taken when the entity's Sprite and Animator were added
+     *
+     * @param entity: An entity about to be removed
+     */
+    if (entity.hasComponent<Sprite>()) {
+        textureManager->release(entity.getComponent<Sprite>().textureHandle);
+    }
+    if (entity.hasComponent<Animator>()) {
+        for (const AnimationClip* clip : entity.getComponent<Animator>().clipSet->clips) {
+            if (clip != nullptr) {
+                textureManager->release(clip->spriteSheetHandle);
+            }
+        }
+    }
+}
+
+unsigned int EntityManager::getStructureVersion() const {
+    /**
+     * A counter that changes whenever entities are created or removed, or reloaded in a way that moves what they draw
+     * Systems caching indices into the entities vector compare it to know when to rebuild
+     */
+    return structureVersion;
+}
+
 std::vector<Entity>& EntityManager::getEntities() {
     /**
      * Return a reference to the entities vector
@@ -130,6 +169,7 @@ Entity& EntityManager::createEntityFromTemplate(const std::string& templatePath)
      */
     Entity& entity = createEntity();
     ordered_json templateJson = loadTemplateFile(templatePath);
+    entity.addComponent<Prefab>({templatePath});
 
     if (templateJson.contains("components")) {
         ordered_json componentsJson = templateJson["components"];
@@ -143,18 +183,200 @@ Entity& EntityManager::createEntityFromTemplate(const std::string& templatePath)
     return entity;
 }
 
+int EntityManager::reloadTemplate(const std::string& templatePath) {
+    /**
+     * Apply a changed template to the live entities made from it
+     * Components are rebuilt from the template except for the state they pick up while the game runs,
+     * entities stay where they are, in the state they are in, with the health they have left
+     *
+     * @param templatePath: The path to the template file
+     * @return: The number of entities patched
+     * @throws runtime_error or a json exception if the template cannot be read, no entity is changed then
+     */
+    std::vector<Entity*> prefabEntities;
+    for (Entity& entity : entities) {
+        if (entity.hasComponent<Prefab>() && entity.getComponent<Prefab>().templatePath == templatePath) {
+            prefabEntities.push_back(&entity);
+        }
+    }
+    if (prefabEntities.empty()) {
+        return 0;
+    }
+    ordered_json templateJson = loadTemplateFile(templatePath);
+    ordered_json componentsJson = templateJson.value("components", ordered_json::object());
+
+    // a template saved half edited throws while building a throwaway entity, before any live one is touched
+    Entity scratch(-1);
+    try {
+        for (auto& [componentName, componentJson] : componentsJson.items()) {
+            if (componentAdders.count(componentName) > 0) {
+                (this->*componentAdders[componentName])(scratch, componentJson);
+            }
+        }
+    } catch (...) {
+        releaseTextures(scratch);
+        scratch.destroyComponents();
+        throw;
+    }
+    releaseTextures(scratch);
+    scratch.destroyComponents();
+
+    for (Entity* entity : prefabEntities) {
+        for (auto& [componentName, componentJson] : componentsJson.items()) {
+            patchComponent(*entity, componentName, componentJson);
+        }
+    }
+    // scale, rects and Velocity change where entities are drawn and whether they move, indices built on them are stale
+    structureVersion++;
+    return static_cast<int>(prefabEntities.size());
+}
+
+void EntityManager::patchComponent(Entity& entity, const std::string& componentName, const ordered_json& componentJson) {
+    /**
+     * Update one component of a live entity from its template
+     *
+     * @param entity: The entity
+     * @param componentName: The component's name in the template
+     * @param componentJson: The component's values in the template
+     */
+    if (componentName == "Player" || componentName == "Npc" || componentName == "Input" ||
+        componentName == "Intent" || componentName == "State") {
+        // nothing to tune, only what the entity is and what it is doing
+        return;
+    }
+    if (componentName == "Transform" && entity.hasComponent<Transform>()) {
+        entity.getComponent<Transform>().scale = componentJson["scale"];
+    } else if (componentName == "Velocity" && entity.hasComponent<Velocity>()) {
+        entity.getComponent<Velocity>().speed = componentJson["speed"];
+    } else if (componentName == "Jumps" && entity.hasComponent<Jumps>()) {
+        Jumps& jumps = entity.getComponent<Jumps>();
+        jumps.maxJumps = componentJson["maxJumps"];
+        jumps.jumpVelocity = componentJson["jumpVelocity"];
+        jumps.jumps = std::min(jumps.jumps, jumps.maxJumps);
+    } else if (componentName == "Dash" && entity.hasComponent<Dash>()) {
+        // a dash in progress runs out its current timers, the next one uses the new values
+        Dash& dash = entity.getComponent<Dash>();
+        dash.speed = componentJson["speed"];
+        dash.initDuration = componentJson["initDuration"];
+        dash.initCooldown = componentJson["initCooldown"];
+    } else if (componentName == "Gravity" && entity.hasComponent<Gravity>()) {
+        // the current pull keeps ramping from where it is, it goes back to baseGravity on the next jump
+        Gravity& gravity = entity.getComponent<Gravity>();
+        gravity.baseGravity = componentJson["baseGravity"];
+        gravity.ascendFactor = componentJson["ascendFactor"];
+        gravity.descendFactor = componentJson["descendFactor"];
+        gravity.ascendMin = componentJson["ascendMin"];
+        gravity.descendMax = componentJson["descendMax"];
+    } else if (componentName == "Health" && entity.hasComponent<Health>()) {
+        Health& health = entity.getComponent<Health>();
+        health.maxHealth = componentJson["maxHealth"];
+        health.invincibilityFrames = componentJson["invincibilityFrames"];
+        health.currentHealth = std::min(health.currentHealth, health.maxHealth);
+    } else if (componentName == "AI" && entity.hasComponent<AI>()) {
+        AI& ai = entity.getComponent<AI>();
+        ai.patrolRange = componentJson["patrolRange"];
+        ai.attackRange = componentJson["attackRange"];
+        ai.pursuitRange = componentJson["pursuitRange"];
+    } else if (componentName == "Sprite" && entity.hasComponent<Sprite>()) {
+        TextureHandle previous = entity.getComponent<Sprite>().textureHandle;
+        addComponentSprite(entity, componentJson);
+        textureManager->release(previous);
+    } else if (componentName == "Animator" && entity.hasComponent<Animator>()) {
+        Animator previous = entity.getComponent<Animator>();
+        addComponentAnimator(entity, componentJson);
+        for (const AnimationClip* clip : previous.clipSet->clips) {
+            if (clip != nullptr) {
+                textureManager->release(clip->spriteSheetHandle);
+            }
+        }
+        entity.getComponent<Animator>().currentAnimation = previous.currentAnimation;
+    } else if (componentAdders.count(componentName) > 0) {
+        (this->*componentAdders[componentName])(entity, componentJson);
+    }
+}
+
+int EntityManager::reloadAnimator(const std::string& animatorPath) {
+    /**
+     * Rebuild the clips of a changed animator file, the Animators using it play the new clips from their first image
+     *
+     * @param animatorPath: The path to the animator file
+     * @return: The number of entities animated by it
+     * @throws runtime_error or a json exception if the file cannot be read, the clips are left unchanged then
+     */
+    const ClipSet* clipSet = animationLibrary.findClipSet(animatorPath);
+    if (clipSet == nullptr) {
+        return 0;
+    }
+    std::vector<TextureHandle> previousHandles;
+    for (const AnimationClip* clip : clipSet->clips) {
+        if (clip != nullptr) {
+            previousHandles.push_back(clip->spriteSheetHandle);
+        }
+    }
+    animationLibrary.reloadClipSet(textureManager, renderer, animatorPath);
+
+    int animated = 0;
+    for (Entity& entity : entities) {
+        if (!entity.hasComponent<Animator>() || entity.getComponent<Animator>().clipSet != clipSet) {
+            continue;
+        }
+        // the clips may use other sprite sheets now, take the new references before dropping the old ones
+        for (const AnimationClip* clip : clipSet->clips) {
+            if (clip != nullptr) {
+                textureManager->acquire(clip->spriteSheetHandle);
+            }
+        }
+        for (TextureHandle handle : previousHandles) {
+            textureManager->release(handle);
+        }
+        // the current clip may have fewer images now
+        Animator& animator = entity.getComponent<Animator>();
+        animator.currentFrame = 0;
+        animator.currentImage = 0;
+        animated++;
+    }
+    return animated;
+}
+
+bool EntityManager::reloadTexture(const std::string& filePath) {
+    /**
+     * Load a changed image again under its handle and point Sprites and clips at its texture
+     *
+     * @param filePath: The path to the image
+     * @return: false if the image is not in use or could not be reloaded
+     */
+    if (!textureManager->reloadTexture(renderer, filePath)) {
+        return false;
+    }
+    // a texture that changed size was replaced, whatever holds the handle looks it up again
+    bool replaced = false;
+    for (Entity& entity : entities) {
+        if (entity.hasComponent<Sprite>()) {
+            Sprite& sprite = entity.getComponent<Sprite>();
+            SDL_Texture* texture = textureManager->getTexture(sprite.textureHandle);
+            if (texture != nullptr && texture != sprite.texture) {
+                sprite.texture = texture;
+                sprite.drawnHandle = sprite.textureHandle;
+                replaced = true;
+            }
+        }
+    }
+    if (replaced) {
+        structureVersion++;
+    }
+    animationLibrary.refreshTextures(textureManager);
+    return true;
+}
+
 ordered_json EntityManager::loadTemplateFile(const std::string& templatePath) {
-    // Open the template file
-    std::ifstream file(templatePath);
-    if (!file.is_open()) {
+    // Read the template file, from the asset pack if one is mounted
+    std::string contents;
+    if (!readAsset(templatePath, contents)) {
         throw std::runtime_error("Could not open template file: " + templatePath);
     }
 
     // Parse the JSON
-    ordered_json templateJson;
-    file >> templateJson;
-
-    return templateJson;
+    return ordered_json::parse(contents);
 }
 
 void EntityManager::addComponentPlayer(Entity& entity, const ordered_json& componentJson) {
@@ -182,13 +404,18 @@ void EntityManager::addComponentCollider(Entity& entity, const ordered_json& com
 }
 
 void EntityManager::addComponentSprite(Entity& entity, const ordered_json& componentJson) {
-    SDL_Texture* texture = textureManager->loadTexture(renderer, componentJson["texturePath"]);
-    int x = static_cast<int>(componentJson["srcRect"]["x"]);
-    int y = static_cast<int>(componentJson["srcRect"]["y"]);
+    // srcRect in the template is relative to the image, move it to wherever the image sits in its texture
+    TextureRegion region = textureManager->acquireRegion(renderer, componentJson["texturePath"]);
+    int x = static_cast<int>(componentJson["srcRect"]["x"]) + region.rect.x;
+    int y = static_cast<int>(componentJson["srcRect"]["y"]) + region.rect.y;
     int w = static_cast<int>(componentJson["srcRect"]["w"]);
     int h = static_cast<int>(componentJson["srcRect"]["h"]);
     SDL_Rect srcRect = {x, y, w, h};
-    entity.addComponent<Sprite>({texture, srcRect});
+    entity.addComponent<Sprite>({region.texture, srcRect, region.handle});
+}
+
+void EntityManager::addComponentRenderLayer(Entity& entity, const ordered_json& componentJson) {
+    entity.addComponent<RenderLayer>({componentJson.value("layer", 0), componentJson.value("depth", 0)});
 }
 
 void EntityManager::addComponentVelocity(Entity& entity, const ordered_json& componentJson) {
@@ -214,42 +441,14 @@ void EntityManager::addComponentInput(Entity& entity, const ordered_json& compon
 }
 
 void EntityManager::addComponentAnimator(Entity& entity, const ordered_json& componentJson) {
-
-    // open the animator file
-    std::string animatorPath = componentJson["animatorPath"];
-    std::ifstream animatorFile(animatorPath);
-    if (!animatorFile.is_open()) {
-        throw std::runtime_error("Could not open animator file: " + componentJson["animatorPath"].get<std::string>());
-    }
-    ordered_json animatorJson;
-    animatorFile >> animatorJson;
-
-    // iterate through the animator file and add the animations to the entity
-    std::map<playerState, AnimationClip> animations;
-    for (auto& [animation, animationClips] : animatorJson["Animations"].items()) {
-        playerState state = playerStatesMap[animation];
-        SDL_Texture *texture = textureManager->loadTexture(renderer, animationClips["spriteSheetPath"]);
-        std::vector<SDL_Rect> frames;
-        int framesPerImage = animationClips["framesPerImage"];
-        int startImage = animationClips["startImage"];
-        int imageCount = animationClips["imageCount"];
-        int imageWidth = animationClips["imageWidth"];
-        int imageHeight = animationClips["imageHeight"];
-        int imageY = animationClips["imageY"];
-        std::string spritePath = animationClips["spriteSheetPath"];
-
-
-        for (int i = 0; i < imageCount; i++) {
-            SDL_Rect frame = {startImage * imageWidth, imageY, imageWidth, imageHeight};
-            frames.push_back(frame);
-            startImage++;
+    const ClipSet* clipSet = animationLibrary.loadClipSet(textureManager, renderer, componentJson["animatorPath"]);
+    // one reference per clip, released clip by clip in releaseTextures()
+    for (const AnimationClip* clip : clipSet->clips) {
+        if (clip != nullptr) {
+            textureManager->acquire(clip->spriteSheetHandle);
         }
-        AnimationClip clip = {texture, frames, framesPerImage, true, spritePath};
-        animations.emplace(state, clip);
     }
-
-    entity.addComponent<Animator>({animations, playerState::IDLE, 0, 0, true});
-
+    entity.addComponent<Animator>({clipSet, playerState::IDLE, 0, 0, true});
 }
 
 void EntityManager::addComponentJumps(Entity& entity, const ordered_json& componentJson) {
@@ -280,12 +479,11 @@ void EntityManager::addComponentAttackMap(Entity& entity, const ordered_json& co
     std::map<std::string, AttackInfo> attacks;
 
     for (auto& [attackName, attackPath] : componentJson.items()) {
-        std::ifstream attackFile(attackPath.get<std::string>());
-        if (!attackFile.is_open()) {
+        std::string attackContents;
+        if (!readAsset(attackPath.get<std::string>(), attackContents)) {
             throw std::runtime_error("Could not open attack file: " + attackPath.get<std::string>());
         }
-        ordered_json attackInfoJson;
-        attackFile >> attackInfoJson;
+        ordered_json attackInfoJson = ordered_json::parse(attackContents);
 
         int damage = attackInfoJson["damage"];
         bool isActive = false;
@@ -306,6 +504,11 @@ void EntityManager::addComponentState(Entity& entity, const ordered_json& compon
     entity.addComponent<State>({state, false});
 }
 
+void EntityManager::addComponentStateTable(Entity& entity, const ordered_json& componentJson) {
+    int tableId = transitionTables.load(componentJson["path"]);
+    entity.addComponent<StateTable>({tableId});
+}
+
 void EntityManager::addComponentAI(Entity& entity, const ordered_json& componentJson) {
     Transform& transform = entity.getComponent<Transform>();
     std::pair<int, int> patrolStart = {transform.x, transform.y};
@@ -8,9 +8,11 @@
 
 #include <nlohmann/json.hpp>
 
+#include "../Resources/AnimationLibrary.h"
 #include "../Resources/TextureManager.h"
 #include "../ECS/Components.h"
 #include "Entity.h"
+#include "TransitionTable.h"
 
 using ordered_json = nlohmann::ordered_json;
 
@@ -29,9 +31,13 @@ public:
     std::vector<Entity>& getCollidableEntities();
     std::vector<Entity>& getMovableCollidableEntities();
     Entity& createPlayer(int x, int y, int w, int h);
-    void configureAnimator(Entity& entity, std::map<playerState, AnimationClip>& animations);
     Entity& getPlayer();
     Entity& getEntityById(int id);
+    unsigned int getStructureVersion() const;
+    void releaseTextures(Entity& entity);
+    int reloadTemplate(const std::string& templatePath);
+    int reloadAnimator(const std::string& animatorPath);
+    bool reloadTexture(const std::string& filePath);
 
     ordered_json loadTemplateFile(const std::string& templatePath);
     void addComponentAI(Entity& entity, const ordered_json& componentJson);
@@ -45,20 +51,26 @@ public:
     void addComponentIntent(Entity& entity, const ordered_json& componentJson);
     void addComponentJumps(Entity& entity, const ordered_json& componentJson);
     void addComponentPlayer(Entity& entity, const ordered_json& componentJson);
+    void addComponentRenderLayer(Entity& entity, const ordered_json& componentJson);
     void addComponentNpc(Entity& entity, const ordered_json& componentJson);
     void addComponentSound(Entity& entity, const ordered_json& componentJson);
     void addComponentSprite(Entity& entity, const ordered_json& componentJson);
     void addComponentState(Entity& entity, const ordered_json& componentJson);
+    void addComponentStateTable(Entity& entity, const ordered_json& componentJson);
     void addComponentTransform(Entity& entity, const ordered_json& componentJson);
     void addComponentVelocity(Entity& entity, const ordered_json& componentJson);
+    void patchComponent(Entity& entity, const std::string& componentName, const ordered_json& componentJson);
 
     static std::map<std::string, playerState> playerStatesMap;
     static std::map<std::string, Action> actionMap;
     std::vector<Entity> entities;
     TextureManager* textureManager;
     SDL_Renderer* renderer;
+    TransitionTableLibrary transitionTables;
+    AnimationLibrary animationLibrary;
     using ComponentAdder = void (EntityManager::*)(Entity&, const ordered_json&);
     std::unordered_map<std::string, ComponentAdder> componentAdders;
+    unsigned int structureVersion = 0;  // bumped whenever entities are added, removed or reloaded
 
 };
 
@@ -1,26 +1,337 @@
 #include "EventManager.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 
-EventManager& EventManager::getInstance() {
-    static EventManager instance;
-    return instance;
+EventSubscription::EventSubscription(EventManager* eventManager, std::string event, int id)
+    : eventManager(eventManager), event(std::move(event)), id(id) {}
+
+EventSubscription::EventSubscription(EventSubscription&& other) noexcept
+    : eventManager(other.eventManager), event(std::move(other.event)), id(other.id) {
+    other.eventManager = nullptr;
+}
+
+EventSubscription& EventSubscription::operator=(EventSubscription&& other) noexcept {
+    if (this != &other) {
+        unsubscribe();
+        eventManager = other.eventManager;
+        event = std::move(other.event);
+        id = other.id;
+        other.eventManager = nullptr;
+    }
+    return *this;
+}
+
+EventSubscription::~EventSubscription() {
+    unsubscribe();
+}
+
+void EventSubscription::unsubscribe() {
+    /**
+     * Remove the callback from its EventManager, if it is still subscribed
+     */
+    if (eventManager != nullptr) {
+        eventManager->unsubscribe(event, id);
+        eventManager = nullptr;
+    }
 }
 
-void EventManager::subscribe(const std::string &event, std::function<void(EventData)> callback)
+EventSubscription EventManager::subscribe(const std::string &event, std::function<void(EventData)> callback)
 {
-    if (eventMap.find(event) == eventMap.end())
-    {
-        eventMap[event] = std::vector<std::function<void(EventData)>>();
+    /**
+     * Subscribe a callback to an event
+     * While events are being dispatched the callback is only added once dispatch returns,
+     * it does not receive the event being dispatched
+     *
+     * @param event: The event name
+     * @param callback: The function to call when the event is published
+     * @return: A handle that unsubscribes the callback when destroyed
+     */
+    int id = nextSubscriberId++;
+    Subscriber subscriber{id, std::move(callback), SubscriberStats()};
+    subscriber.stats.id = id;
+    if (dispatchDepth > 0) {
+        addedSubscribers.emplace_back(event, std::move(subscriber));
+    }
+    else {
+        eventMap[event].subscribers.push_back(std::move(subscriber));
+    }
+    return EventSubscription(this, event, id);
+}
+
+void EventManager::unsubscribe(const std::string& event, int id) {
+    /**
+     * Remove a subscriber from an event
+     * While events are being dispatched the subscriber is only deactivated, and removed afterwards,
+     * its callback may be the one running
+     *
+     * @param event: The event name
+     * @param id: The subscriber id
+     */
+    for (auto added = addedSubscribers.begin(); added != addedSubscribers.end(); ++added) {
+        if (added->second.id == id) {
+            // never called yet, safe to drop straight away
+            addedSubscribers.erase(added);
+            return;
+        }
+    }
+    auto it = eventMap.find(event);
+    if (it == eventMap.end()) {
+        return;
+    }
+    auto& subscribers = it->second.subscribers;
+    for (auto subscriber = subscribers.begin(); subscriber != subscribers.end(); ++subscriber) {
+        if (subscriber->id == id) {
+            if (dispatchDepth > 0) {
+                subscriber->active = false;
+                hasRemovedSubscribers = true;
+            }
+            else {
+                subscribers.erase(subscriber);
+            }
+            return;
+        }
     }
-    eventMap[event].push_back(callback);
 }
 
 void EventManager::publish(const std::string& event, EventData data) {
     auto it = eventMap.find(event);
+    if (it == eventMap.end() && instrumentationEnabled) {
+        // track publishes nobody listens to as well
+        it = eventMap.emplace(event, EventChannel()).first;
+    }
     if (it != eventMap.end()) {
-        for (auto &callback : it->second) {
-            callback(data);
-//            std::cout << "Event: " << event << " published" << std::endl;
+        if (instrumentationEnabled) {
+            it->second.stats.publishCount++;
+            it->second.stats.framePublishCount++;
+        }
+        dispatchDepth++;
+        auto& subscribers = it->second.subscribers;
+        for (Subscriber& subscriber : subscribers) {
+            if (subscriber.active) {
+                call(subscriber, data);
+            }
+        }
+        dispatchDepth--;
+        applySubscriptionChanges();
+    }
+}
+
+void EventManager::queue(const std::string& event, EventData data) {
+    /**
+     * Queue an event to be dispatched at the next sync point instead of immediately
+     *
+     * Any Entity pointers in data must stay valid until flush() is called
+     *
+     * @param event: The event name
+     * @param data: The event data
+     */
+    EventQueue& eventQueue = eventQueues[event];
+    if (eventQueue.pending.empty()) {
+        queuedEvents.push_back(event);
+    }
+    eventQueue.pending.push_back(data);
+}
+
+void EventManager::flush() {
+    /**
+     * Dispatch all queued events, one batch per event type
+     *
+     * Only events queued before the flush started are dispatched. Events queued by
+     * handlers during the flush are held until the next call.
+     */
+    flushingEvents.swap(queuedEvents);
+    // take every batch before dispatching any, a handler may queue an event type that is flushed later on
+    for (const std::string& event : flushingEvents) {
+        EventQueue& eventQueue = eventQueues[event];
+        eventQueue.processing.swap(eventQueue.pending);
+    }
+    for (const std::string& event : flushingEvents) {
+        EventQueue& eventQueue = eventQueues[event];
+        dispatch(event, eventQueue.processing);
+        eventQueue.processing.clear();
+    }
+    flushingEvents.clear();
+}
+
+bool EventManager::hasQueuedEvents() const {
+    /**
+     * Check if there are events waiting for the next flush
+     */
+    return !queuedEvents.empty();
+}
+
+void EventManager::dispatch(const std::string& event, const std::vector<EventData>& batch) {
+    /**
+     * Dispatch a batch of events of the same type to its subscribers
+     *
+     * @param event: The event name
+     * @param batch: The queued event data
+     */
+    auto it = eventMap.find(event);
+    if (it == eventMap.end() && instrumentationEnabled) {
+        it = eventMap.emplace(event, EventChannel()).first;
+    }
+    if (it == eventMap.end()) {
+        return;
+    }
+    if (instrumentationEnabled) {
+        EventStats& stats = it->second.stats;
+        stats.publishCount += batch.size();
+        stats.framePublishCount += batch.size();
+        stats.lastQueueDepth = batch.size();
+        stats.maxQueueDepth = std::max(stats.maxQueueDepth, batch.size());
+    }
+    dispatchDepth++;
+    auto& subscribers = it->second.subscribers;
+    for (const EventData& data : batch) {
+        for (Subscriber& subscriber : subscribers) {
+            if (subscriber.active) {
+                call(subscriber, data);
+            }
+        }
+    }
+    dispatchDepth--;
+    applySubscriptionChanges();
+}
+
+void EventManager::call(Subscriber& subscriber, const EventData& data) {
+    /**
+     * Invoke a subscriber, timing the call when instrumentation is enabled
+     *
+     * Subscribing and erasing are deferred while dispatching, so the subscriber vector is never
+     * reallocated and the subscriber outlives its callback.
+     *
+     * @param subscriber: The subscriber to call
+     * @param data: The event data
+     */
+    if (!instrumentationEnabled) {
+        subscriber.callback(data);
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    subscriber.callback(data);
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    SubscriberStats& stats = subscriber.stats;
+    stats.calls++;
+    stats.totalMs += elapsedMs;
+    stats.maxMs = std::max(stats.maxMs, elapsedMs);
+}
+
+void EventManager::applySubscriptionChanges() {
+    /**
+     * Erase subscribers that were unsubscribed and add the ones subscribed while events were being dispatched
+     * Only done once the outermost dispatch has returned
+     */
+    if (dispatchDepth > 0) {
+        return;
+    }
+    if (hasRemovedSubscribers) {
+        for (auto& [event, channel] : eventMap) {
+            auto& subscribers = channel.subscribers;
+            subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(), [](const Subscriber& subscriber) {
+                return !subscriber.active;
+            }), subscribers.end());
+        }
+        hasRemovedSubscribers = false;
+    }
+    for (auto& [event, subscriber] : addedSubscribers) {
+        eventMap[event].subscribers.push_back(std::move(subscriber));
+    }
+    addedSubscribers.clear();
+}
+
+void EventManager::setInstrumentation(bool enabled) {
+    /**
+     * Enable or disable event traffic counters and subscriber timing
+     *
+     * @param enabled: Whether instrumentation is enabled
+     */
+    instrumentationEnabled = enabled;
+}
+
+void EventManager::setStatsDumpInterval(int frames) {
+    /**
+     * Dump event stats to stdout every n frames. A value of 0 disables the periodic dump.
+     * Setting an interval enables instrumentation.
+     *
+     * @param frames: The number of frames between dumps
+     */
+    statsDumpInterval = frames;
+    if (frames > 0) {
+        instrumentationEnabled = true;
+    }
+}
+
+void EventManager::endFrame() {
+    /**
+     * Close out the per-frame publish counters, dumping stats if the dump interval has elapsed
+     * Called once per frame from the game loop
+     */
+    if (!instrumentationEnabled) {
+        return;
+    }
+    for (auto& [event, channel] : eventMap) {
+        EventStats& stats = channel.stats;
+        stats.lastFramePublishCount = stats.framePublishCount;
+        stats.maxFramePublishCount = std::max(stats.maxFramePublishCount, stats.framePublishCount);
+        stats.framePublishCount = 0;
+    }
+    frameCount++;
+    if (statsDumpInterval > 0 && frameCount % statsDumpInterval == 0) {
+        dumpStats(std::cout);
+    }
+}
+
+std::map<std::string, EventStats> EventManager::getStats() const {
+    /**
+     * Get a snapshot of the traffic stats for every event seen so far
+     *
+     * @return: Stats keyed by event name, including per-subscriber timings
+     */
+    std::map<std::string, EventStats> snapshot;
+    for (const auto& [event, channel] : eventMap) {
+        EventStats stats = channel.stats;
+        for (const Subscriber& subscriber : channel.subscribers) {
+            if (subscriber.active) {
+                stats.subscribers.push_back(subscriber.stats);
+            }
+        }
+        snapshot.emplace(event, stats);
+    }
+    return snapshot;
+}
+
+void EventManager::dumpStats(std::ostream& out) const {
+    /**
+     * Write event stats, busiest events of the last frame first
+     *
+     * @param out: The stream to write to
+     */
+    auto stats = getStats();
+    std::vector<std::pair<std::string, EventStats>> sorted(stats.begin(), stats.end());
+    std::stable_sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        return a.second.lastFramePublishCount > b.second.lastFramePublishCount;
+    });
+
+    out << "Event stats after " << frameCount << " frames\n";
+    for (const auto& [event, eventStats] : sorted) {
+        out << "  " << event
+            << ": last frame " << eventStats.lastFramePublishCount
+            << ", max/frame " << eventStats.maxFramePublishCount
+            << ", total " << eventStats.publishCount
+            << ", fan-out " << eventStats.subscribers.size();
+        if (eventStats.maxQueueDepth > 0) {
+            out << ", queue depth " << eventStats.lastQueueDepth << " (max " << eventStats.maxQueueDepth << ")";
+        }
+        out << "\n";
+        for (const SubscriberStats& subscriber : eventStats.subscribers) {
+            out << "    subscriber " << subscriber.id
+                << ": calls " << subscriber.calls
+                << ", total " << subscriber.totalMs << "ms"
+                << ", max " << subscriber.maxMs << "ms\n";
         }
     }
-}
\ No newline at end of file
+    out.flush();
+}
@@ -4,6 +4,8 @@
 
 #include <map>
 #include <functional>
+#include <ostream>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
@@ -15,15 +17,102 @@ struct EventData {
     // Add other fields as needed
 };
 
+struct SubscriberStats {
+    int id = 0;
+    long calls = 0;
+    double totalMs = 0.0;  // cumulative time spent in the callback
+    double maxMs = 0.0;    // longest single call
+};
+
+struct EventStats {
+    long publishCount = 0;          // cumulative publishes, immediate and queued
+    int framePublishCount = 0;      // publishes so far in the current frame
+    int lastFramePublishCount = 0;  // publishes in the last completed frame
+    int maxFramePublishCount = 0;   // most publishes seen in a single frame
+    size_t lastQueueDepth = 0;      // events dispatched by the last flush
+    size_t maxQueueDepth = 0;       // most events dispatched by a single flush
+    std::vector<SubscriberStats> subscribers;
+};
+
+class EventManager;
+
+class EventSubscription {
+    /**
+     * RAII handle for an EventManager subscription
+     * The callback is unsubscribed when the handle is destroyed or reset
+     */
+public:
+    EventSubscription() = default;
+    EventSubscription(EventManager* eventManager, std::string event, int id);
+    EventSubscription(EventSubscription&& other) noexcept;
+    EventSubscription& operator=(EventSubscription&& other) noexcept;
+    EventSubscription(const EventSubscription&) = delete;
+    EventSubscription& operator=(const EventSubscription&) = delete;
+    ~EventSubscription();
+    void unsubscribe();
+
+private:
+    EventManager* eventManager = nullptr;
+    std::string event;
+    int id = 0;
+};
+
 class EventManager {
 public:
+    EventManager() = default;
+    EventManager(const EventManager&) = delete;
+    EventManager& operator=(const EventManager&) = delete;
 
-    static EventManager& getInstance();
-    void subscribe(const std::string& event, std::function<void(EventData)> callback);
+    [[nodiscard]] EventSubscription subscribe(const std::string& event, std::function<void(EventData)> callback);
+    void unsubscribe(const std::string& event, int id);
     void publish(const std::string& event, EventData data);
+    void queue(const std::string& event, EventData data);
+    void flush();
+    bool hasQueuedEvents() const;
+
+    void setInstrumentation(bool enabled);
+    void setStatsDumpInterval(int frames);
+    void endFrame();
+    std::map<std::string, EventStats> getStats() const;
+    void dumpStats(std::ostream& out) const;
 
 private:
-    std::map<std::string, std::vector<std::function<void(EventData)>>> eventMap;
+    struct Subscriber {
+        int id;
+        std::function<void(EventData)> callback;
+        SubscriberStats stats;
+        bool active = true;  // cleared when unsubscribed mid-dispatch, erased once dispatch returns
+    };
+
+    struct EventChannel {
+        std::vector<Subscriber> subscribers;
+        EventStats stats;  // subscriber stats are kept on each Subscriber and only collected by getStats()
+    };
+
+    struct EventQueue {
+        /**
+         * Double-buffered queue for a single event type
+         * Events are appended to pending and swapped into processing at flush time,
+         * so anything queued by a handler waits for the next sync point
+         */
+        std::vector<EventData> pending;
+        std::vector<EventData> processing;
+    };
+
+    std::map<std::string, EventChannel> eventMap;
+    std::unordered_map<std::string, EventQueue> eventQueues;
+    std::vector<std::string> queuedEvents;  // event types with pending data, in the order they were first queued
+    std::vector<std::string> flushingEvents;
+    std::vector<std::pair<std::string, Subscriber>> addedSubscribers;  // subscribed mid-dispatch, added once it returns
+    int nextSubscriberId = 0;
+    int dispatchDepth = 0;
+    bool hasRemovedSubscribers = false;
+    bool instrumentationEnabled = false;
+    int statsDumpInterval = 0;
+    long frameCount = 0;
+    void dispatch(const std::string& event, const std::vector<EventData>& batch);
+    void call(Subscriber& subscriber, const EventData& data);
+    void applySubscriptionChanges();
 };
 
-#endif //BUMMERENGINE_EVENTMANAGER_H
\ No newline at end of file
+#endif //BUMMERENGINE_EVENTMANAGER_H
@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <cctype>
+#include <exception>
+#include <filesystem>
+
+#include "HotReloader.h"
+#include "../Resources/AssetPack.h"
+#include "../Logger.h"
+
+HotReloader::HotReloader(EntityManager& entityManager, SceneManager& sceneManager)
+    : entityManager(entityManager), sceneManager(sceneManager) {
+    /**
+     * Constructor for the HotReloader, nothing is watched until watch() is called
+     *
+     * @param entityManager: The entities to patch, along with the textures and clips they use
+     * @param sceneManager: The scene whose tilemaps are baked again when their tileset changes
+     */
+}
+
+bool HotReloader::watch(const std::string& directory) {
+    /**
+     * Reload the files under a directory whenever they are saved
+     *
+     * @param directory: The directory, as the game's load paths start, like "assets" or "etc/templates"
+     * @return: false if the directory cannot be watched
+     */
+    if (AssetPack::getMounted().isMounted()) {
+        LOG_WARN("reload", "An asset pack is mounted, files packed in it are read from the pack and do not reload");
+    }
+    if (!watcher.watch(directory)) {
+        return false;
+    }
+    LOG_INFO("reload", "Watching " << directory << " for changes");
+    return true;
+}
+
+int HotReloader::update() {
+    /**
+     * Reload the files saved since the last call, call once per frame
+     *
+     * @return: The number of files reloaded
+     */
+    int reloaded = 0;
+    for (const std::string& path : watcher.poll()) {
+        if (reload(path)) {
+            reloaded++;
+        }
+    }
+    return reloaded;
+}
+
+bool HotReloader::reload(const std::string& path) {
+    /**
+     * Reload one file, whatever in the running game was loaded from it
+     *
+     * @param path: The file, as the game loaded it
+     * @return: false if nothing uses the file or it could not be loaded
+     */
+    std::string extension = std::filesystem::path(path).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+    try {
+        if (extension == ".png" || extension == ".jpg" || extension == ".bmp") {
+            if (!entityManager.reloadTexture(path)) {
+                return false;
+            }
+            int tilemaps = sceneManager.refreshTilesets(path);
+            LOG_INFO("reload", "Reloaded texture " << path << (tilemaps > 0 ? ", tilemaps rebaked" : ""));
+            return true;
+        }
+        if (extension == ".json") {
+            // one file is either an animator or a template, the call not owning it does nothing
+            bool isAnimator = entityManager.animationLibrary.findClipSet(path) != nullptr;
+            int animated = entityManager.reloadAnimator(path);
+            int patched = entityManager.reloadTemplate(path);
+            if (isAnimator) {
+                LOG_INFO("reload", "Reloaded animator " << path << ", " << animated << " entities animated by it");
+            }
+            if (patched > 0) {
+                LOG_INFO("reload", "Reloaded template " << path << ", " << patched << " entities patched");
+            }
+            return isAnimator || patched > 0;
+        }
+    } catch (const std::exception& error) {
+        LOG_ERROR("reload", "Could not reload " << path << ", keeping the previous version: " << error.what());
+    }
+    return false;
+}
@@ -0,0 +1,33 @@
+#pragma once
+#ifndef BUMMERENGINE_HOTRELOADER_H
+#define BUMMERENGINE_HOTRELOADER_H
+
+#include <string>
+
+#include "EntityManager.h"
+#include "SceneManager.h"
+#include "../Resources/FileWatcher.h"
+
+class HotReloader {
+    /**
+     * Reloads templates, animator files and images while the game runs, as they are saved
+     *
+     * Only the changed file is reloaded and the scene keeps running: entities made from a template get its new
+     * values, an animator file is rebuilt into the clip set its Animators already point at, and an image is loaded
+     * again under its texture handle. A file that fails to load is logged and its previous version kept.
+     * update() runs on the simulation thread, texture uploads go through the TextureManager's renderer invoker.
+     */
+public:
+    HotReloader(EntityManager& entityManager, SceneManager& sceneManager);
+
+    bool watch(const std::string& directory);
+    int update();
+    bool reload(const std::string& path);
+
+private:
+    EntityManager& entityManager;
+    SceneManager& sceneManager;
+    FileWatcher watcher;
+};
+
+#endif //BUMMERENGINE_HOTRELOADER_H
@@ -1,13 +1,16 @@
 #include "SceneManager.h"
+#include "../Resources/AssetPack.h"
+#include "../Logger.h"
 
 #include <fstream>
+#include <utility>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
 
 
 
-SceneManager::SceneManager(EntityManager& entityManager) : entityManager(entityManager) {
+SceneManager::SceneManager(EntityManager& entityManager) : entityManager(entityManager), tilemaps(std::make_shared<std::vector<Tilemap>>()) {
     // Create sceneTemplates from run_config.json
     std::ifstream file("etc/run_config.json");
     json configJson;
@@ -26,24 +29,171 @@ void SceneManager::nextScene() {
         currentSceneIndex = 0;
     }
     entityManager.clearEntities();
+    for (const Tilemap& tilemap : *tilemaps) {
+        entityManager.textureManager->release(tilemap.tilesetHandle);
+    }
+    tilemaps = std::make_shared<std::vector<Tilemap>>();
+
+    // a prefetched scene is instantiated from memory, waiting for the prefetch if it is not done yet
+    if (prefetching && prefetcher.getScenePath() == sceneTemplates[currentSceneIndex]) {
+        ScenePrefetcher::Prefetched prefetched = prefetcher.take();
+        adoptPrefetched(prefetched);
+    }
     loadSceneFromTemplate(sceneTemplates[currentSceneIndex]);
+    clearAssetCache();
+
+    // the new scene holds references to what it uses, anything left over may go if memory is tight
+    entityManager.textureManager->trimToBudget();
+    prefetchNextScene();
 }
 
 void SceneManager::loadSceneFromTemplate(const std::string& templatePath) {
-    // Load the template file
-    std::ifstream file(templatePath);
-    if (!file.is_open()) {
+    // Load the template file, from the asset pack if one is mounted
+    std::string contents;
+    if (!readAsset(templatePath, contents)) {
         throw std::runtime_error("Could not open scene template file: " + templatePath);
     }
 
     // Parse the JSON
-    json templateJson;
-    file >> templateJson;
+    json templateJson = json::parse(contents);
 
     // For each entity in the template, create the entity
     for (const auto& entityTemplate : templateJson["entities"]) {
         entityManager.createEntityFromTemplate(entityTemplate["templatePath"]);
     }
+
+    // Tilemaps are optional, most scenes are built from entities only
+    if (templateJson.contains("tilemaps")) {
+        // copy on write, a frame being drawn may still hold the current list
+        auto loaded = std::make_shared<std::vector<Tilemap>>(*tilemaps);
+        for (const auto& tilemapTemplate : templateJson["tilemaps"]) {
+            Tilemap tilemap = Tilemap::loadFromFile(tilemapTemplate["path"]);
+            TextureRegion region = entityManager.textureManager->acquireRegion(entityManager.renderer, tilemap.tilesetPath);
+            tilemap.tileset = region.texture;
+            tilemap.tilesetRegion = region.rect;
+            tilemap.tilesetHandle = region.handle;
+            loaded->push_back(tilemap);
+        }
+        tilemaps = loaded;
+    }
+
+    // Sounds are optional too, decoding them now keeps the disk out of the first time each one plays
+    if (templateJson.contains("sounds") && soundBank != nullptr) {
+        soundBank->preload(templateJson["sounds"].get<std::vector<std::string>>());
+    }
+
+    // A scene naming a different music or ambience track crossfades to it, one without keeps what is playing
+    if (musicPlayer != nullptr) {
+        const std::pair<const char*, MusicPlayer::Layer> layers[] = {{"music", MusicPlayer::MUSIC}, {"ambience", MusicPlayer::AMBIENCE}};
+        for (const auto& [key, layer] : layers) {
+            if (templateJson.contains(key)) {
+                const json& track = templateJson[key];
+                musicPlayer->play(layer, track["path"], track.value("volume", MIX_MAX_VOLUME));
+            }
+        }
+    }
+}
+
+const std::vector<Tilemap>& SceneManager::getTilemaps() const {
+    /**
+     * The tilemaps of the current scene
+     */
+    return *tilemaps;
 }
 
+std::shared_ptr<const std::vector<Tilemap>> SceneManager::shareTilemaps() const {
+    /**
+     * The tilemaps of the current scene, for readers that may outlive a scene change, like a queued frame
+     */
+    return tilemaps;
+}
 
+int SceneManager::refreshTilesets(const std::string& imagePath) {
+    /**
+     * Bake the tilemaps drawn from an image again after the image was reloaded
+     * Their textures may have been replaced, and chunks baked from the old pixels are dropped along with their ids
+     *
+     * @param imagePath: The tileset image
+     * @return: The number of tilemaps using it
+     */
+    // copy on write, a frame being drawn may still hold the current list
+    auto refreshed = std::make_shared<std::vector<Tilemap>>(*tilemaps);
+    int refreshedCount = 0;
+    for (Tilemap& tilemap : *refreshed) {
+        if (tilemap.tilesetPath == imagePath) {
+            tilemap.tileset = entityManager.textureManager->getTexture(tilemap.tilesetHandle);
+            tilemap.id = Tilemap::newId();
+            refreshedCount++;
+        }
+    }
+    if (refreshedCount > 0) {
+        tilemaps = refreshed;
+    }
+    return refreshedCount;
+}
+
+void SceneManager::setSoundBank(SoundBank* soundBank) {
+    /**
+     * Set the sound bank that the sounds listed by scene templates are loaded into
+     *
+     * @param soundBank: The sound bank, or nullptr to skip loading sounds
+     */
+    this->soundBank = soundBank;
+}
+
+void SceneManager::setMusicPlayer(MusicPlayer* musicPlayer) {
+    /**
+     * Set the music player that plays the music and ambience listed by scene templates
+     *
+     * @param musicPlayer: The music player, or nullptr to leave music alone
+     */
+    this->musicPlayer = musicPlayer;
+}
+
+void SceneManager::setPrefetching(bool enabled) {
+    /**
+     * Load the scene after the current one in the background, so nextScene() switches without reading the disk
+     *
+     * @param enabled: false stops prefetching and drops what was prefetched
+     */
+    prefetching = enabled;
+    if (!prefetching) {
+        prefetcher.cancel();
+    }
+}
+
+void SceneManager::prefetchNextScene() {
+    /**
+     * Start prefetching the scene nextScene() will load
+     */
+    if (!prefetching || sceneTemplates.size() < 2) {
+        // a single scene reloads itself, everything it uses is resident already
+        return;
+    }
+    size_t nextIndex = (currentSceneIndex + 1) % sceneTemplates.size();
+    prefetcher.start(sceneTemplates[nextIndex], entityManager.textureManager->getResidentPaths());
+}
+
+void SceneManager::adoptPrefetched(ScenePrefetcher::Prefetched& prefetched) {
+    /**
+     * Turn what the prefetcher loaded into cached files, textures and sounds, so loading the scene finds them all
+     *
+     * @param prefetched: Taken from the prefetcher, its images and sounds are freed or handed over
+     */
+    for (auto& [path, contents] : prefetched.files) {
+        cacheAsset(path, std::move(contents));
+    }
+    for (auto& [path, surface] : prefetched.images) {
+        entityManager.textureManager->preloadTexture(entityManager.renderer, path, surface);
+        SDL_FreeSurface(surface);
+    }
+    for (auto& [path, chunk] : prefetched.sounds) {
+        if (soundBank != nullptr) {
+            soundBank->adopt(path, chunk);
+        } else {
+            Mix_FreeChunk(chunk);
+        }
+    }
+    LOG_INFO("scene", "Switching to " << prefetched.manifest.scenePath << " from memory: " << prefetched.files.size()
+             << " files, " << prefetched.images.size() << " images, " << prefetched.sounds.size() << " sounds");
+}
@@ -2,20 +2,39 @@
 #ifndef BUMMERENGINE_SCENEMANAGER_H
 #define BUMMERENGINE_SCENEMANAGER_H
 
+#include <memory>
 #include <vector>
 
 #include "EntityManager.h"
+#include "ScenePrefetcher.h"
+#include "Tilemap.h"
+#include "../Resources/SoundBank.h"
+#include "../Systems/MusicPlayer.h"
 
 class SceneManager {
 public:
     SceneManager(EntityManager& entityManager);
     void nextScene();
     void loadSceneFromTemplate(const std::string& sceneTemplate);
+    const std::vector<Tilemap>& getTilemaps() const;
+    std::shared_ptr<const std::vector<Tilemap>> shareTilemaps() const;
+    void setSoundBank(SoundBank* soundBank);
+    void setMusicPlayer(MusicPlayer* musicPlayer);
+    int refreshTilesets(const std::string& imagePath);
+    void setPrefetching(bool enabled);
 
 private:
+    void prefetchNextScene();
+    void adoptPrefetched(ScenePrefetcher::Prefetched& prefetched);
+
     EntityManager& entityManager;
     std::vector<std::string> sceneTemplates;
+    std::shared_ptr<std::vector<Tilemap>> tilemaps;  // replaced, never modified, once shared
     int currentSceneIndex = 0;
+    SoundBank* soundBank = nullptr;  // preloads the sounds a scene lists, none if not set
+    MusicPlayer* musicPlayer = nullptr;  // plays the tracks a scene lists, none if not set
+    bool prefetching = false;
+    ScenePrefetcher prefetcher;  // loads the scene after the current one while it plays
 };
 
 #endif //BUMMERENGINE_SCENEMANAGER_H
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <exception>
+
+#include <nlohmann/json.hpp>
+
+#include "SceneManifest.h"
+#include "../Resources/AssetPack.h"
+#include "../Logger.h"
+
+namespace {
+    void addUnique(std::vector<std::string>& paths, const std::string& path) {
+        if (std::find(paths.begin(), paths.end(), path) == paths.end()) {
+            paths.push_back(path);
+        }
+    }
+
+    bool readJson(const std::string& path, nlohmann::json& json) {
+        // a file that cannot be read is left for the scene load to report
+        std::string contents;
+        if (path.empty()) {
+            return false;
+        }
+        if (!readAsset(path, contents)) {
+            LOG_WARN("scene", "Manifest: " << path << " not found");
+            return false;
+        }
+        try {
+            json = nlohmann::json::parse(contents);
+        } catch (const std::exception& error) {
+            LOG_WARN("scene", "Manifest: " << path << " is not valid JSON: " << error.what());
+            return false;
+        }
+        return true;
+    }
+}
+
+SceneManifest SceneManifest::build(const std::string& scenePath) {
+    /**
+     * Read a scene template and the files it names to list what loading the scene needs
+     * Only reads files, safe to call from any thread
+     *
+     * @param scenePath: The scene template
+     * @return: The manifest, missing or broken files are skipped
+     */
+    SceneManifest manifest;
+    manifest.scenePath = scenePath;
+    nlohmann::json sceneJson;
+    if (!readJson(scenePath, sceneJson)) {
+        return manifest;
+    }
+    manifest.files.push_back(scenePath);
+
+    for (const auto& entityTemplate : sceneJson.value("entities", nlohmann::json::array())) {
+        std::string prefabPath = entityTemplate.value("templatePath", "");
+        nlohmann::json prefabJson;
+        if (prefabPath.empty() || std::find(manifest.prefabs.begin(), manifest.prefabs.end(), prefabPath) != manifest.prefabs.end() ||
+            !readJson(prefabPath, prefabJson)) {
+            continue;
+        }
+        manifest.prefabs.push_back(prefabPath);
+        manifest.files.push_back(prefabPath);
+
+        const nlohmann::json components = prefabJson.value("components", nlohmann::json::object());
+        if (components.contains("Sprite")) {
+            addUnique(manifest.textures, components["Sprite"].value("texturePath", ""));
+        }
+        if (components.contains("Animator")) {
+            std::string animatorPath = components["Animator"].value("animatorPath", "");
+            nlohmann::json animatorJson;
+            if (readJson(animatorPath, animatorJson)) {
+                addUnique(manifest.files, animatorPath);
+                const nlohmann::json animations = animatorJson.value("Animations", nlohmann::json::object());
+                for (const auto& [state, clip] : animations.items()) {
+                    addUnique(manifest.textures, clip.value("spriteSheetPath", ""));
+                }
+            }
+        }
+        if (components.contains("AttackMap")) {
+            for (const auto& [attack, attackPath] : components["AttackMap"].items()) {
+                addUnique(manifest.files, attackPath.get<std::string>());
+            }
+        }
+        if (components.contains("StateTable")) {
+            addUnique(manifest.files, components["StateTable"].value("path", ""));
+        }
+    }
+
+    for (const auto& tilemapTemplate : sceneJson.value("tilemaps", nlohmann::json::array())) {
+        std::string tilemapPath = tilemapTemplate.value("path", "");
+        nlohmann::json tilemapJson;
+        if (readJson(tilemapPath, tilemapJson)) {
+            addUnique(manifest.files, tilemapPath);
+            addUnique(manifest.textures, tilemapJson.value("tileset", nlohmann::json::object()).value("texturePath", ""));
+        }
+    }
+
+    for (const auto& sound : sceneJson.value("sounds", nlohmann::json::array())) {
+        addUnique(manifest.sounds, sound.get<std::string>());
+    }
+
+    // components without a path leave an empty one behind
+    for (std::vector<std::string>* paths : {&manifest.files, &manifest.textures, &manifest.sounds}) {
+        paths->erase(std::remove(paths->begin(), paths->end(), std::string()), paths->end());
+    }
+    return manifest;
+}
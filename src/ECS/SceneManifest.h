@@ -0,0 +1,23 @@
+#pragma once
+#ifndef BUMMERENGINE_SCENEMANIFEST_H
+#define BUMMERENGINE_SCENEMANIFEST_H
+
+#include <string>
+#include <vector>
+
+struct SceneManifest {
+    /**
+     * Everything loading a scene reads, found by following its template through the files it names
+     *
+     * Music and ambience are left out, they are streamed while they play.
+     */
+    std::string scenePath;
+    std::vector<std::string> files;     // JSON: the scene, its prefabs, animators, attacks, state tables and tilemaps
+    std::vector<std::string> prefabs;   // the entity templates, also in files
+    std::vector<std::string> textures;
+    std::vector<std::string> sounds;
+
+    static SceneManifest build(const std::string& scenePath);
+};
+
+#endif //BUMMERENGINE_SCENEMANIFEST_H
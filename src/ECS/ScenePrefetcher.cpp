@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <exception>
+
+#include "ScenePrefetcher.h"
+#include "../Resources/AssetPack.h"
+#include "../Logger.h"
+
+ScenePrefetcher::ScenePrefetcher(DecodeImageFunction decodeImage, DecodeSoundFunction decodeSound)
+    : decodeImage(std::move(decodeImage)), decodeSound(std::move(decodeSound)) {
+    /**
+     * Constructor for the ScenePrefetcher
+     *
+     * @param decodeImage: Decodes one image, ImageDecoder::decodeRGBA32 unless replaced in tests
+     * @param decodeSound: Decodes one sound, SoundBank::loadWAV unless replaced in tests
+     */
+}
+
+ScenePrefetcher::~ScenePrefetcher() {
+    cancel();
+}
+
+void ScenePrefetcher::start(const std::string& scenePath, const std::vector<std::string>& residentTextures) {
+    /**
+     * Start loading a scene in the background, dropping whatever was prefetched before
+     *
+     * @param scenePath: The scene template
+     * @param residentTextures: Images that are loaded already and not decoded again
+     */
+    cancel();
+    this->scenePath = scenePath;
+    worker = std::thread(&ScenePrefetcher::run, this, residentTextures);
+}
+
+bool ScenePrefetcher::isReady() const {
+    /**
+     * Whether the worker is done, take() returns without waiting then
+     */
+    return ready;
+}
+
+const std::string& ScenePrefetcher::getScenePath() const {
+    /**
+     * The scene being prefetched, empty if none
+     */
+    return scenePath;
+}
+
+ScenePrefetcher::Prefetched ScenePrefetcher::take() {
+    /**
+     * Wait for the worker if it is still busy and take what it loaded
+     *
+     * @return: The scene's files, images and sounds, the caller frees the images and sounds
+     */
+    if (worker.joinable()) {
+        worker.join();
+    }
+    Prefetched taken = std::move(result);
+    result = Prefetched();
+    scenePath.clear();
+    ready = false;
+    return taken;
+}
+
+void ScenePrefetcher::cancel() {
+    /**
+     * Stop the worker at the next file and free what it loaded
+     */
+    cancelled = true;
+    if (worker.joinable()) {
+        worker.join();
+    }
+    freeLoaded(result);
+    result = Prefetched();
+    scenePath.clear();
+    ready = false;
+    cancelled = false;
+}
+
+void ScenePrefetcher::run(std::vector<std::string> residentTextures) {
+    /**
+     * Worker thread: load everything the scene's manifest lists
+     *
+     * @param residentTextures: Images that are loaded already
+     */
+    try {
+        result.manifest = SceneManifest::build(scenePath);
+        for (const std::string& path : result.manifest.files) {
+            std::string contents;
+            if (cancelled) {
+                return;
+            }
+            if (readAsset(path, contents)) {
+                result.files.emplace_back(path, std::move(contents));
+            }
+        }
+        for (const std::string& path : result.manifest.textures) {
+            if (cancelled) {
+                return;
+            }
+            if (std::find(residentTextures.begin(), residentTextures.end(), path) == residentTextures.end()) {
+                SDL_Surface* surface = decodeImage(path);
+                if (surface != nullptr) {
+                    result.images.emplace_back(path, surface);
+                }
+            }
+        }
+        for (const std::string& path : result.manifest.sounds) {
+            if (cancelled) {
+                return;
+            }
+            Mix_Chunk* chunk = decodeSound(path);
+            if (chunk != nullptr) {
+                result.sounds.emplace_back(path, chunk);
+            }
+        }
+        LOG_INFO("scene", "Prefetched " << scenePath << ": " << result.files.size() << " files, "
+                 << result.images.size() << " images, " << result.sounds.size() << " sounds");
+    } catch (const std::exception& error) {
+        // the scene loads from disk as before, where the error is reported properly
+        LOG_WARN("scene", "Prefetching " << scenePath << " failed: " << error.what());
+    }
+    ready = true;
+}
+
+void ScenePrefetcher::freeLoaded(Prefetched& prefetched) {
+    for (auto& [path, surface] : prefetched.images) {
+        SDL_FreeSurface(surface);
+    }
+    for (auto& [path, chunk] : prefetched.sounds) {
+        Mix_FreeChunk(chunk);
+    }
+    prefetched.images.clear();
+    prefetched.sounds.clear();
+}
@@ -0,0 +1,62 @@
+#pragma once
+#ifndef BUMMERENGINE_SCENEPREFETCHER_H
+#define BUMMERENGINE_SCENEPREFETCHER_H
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+
+#include "SceneManifest.h"
+#include "../Resources/ImageDecoder.h"
+#include "../Resources/SoundBank.h"
+
+class ScenePrefetcher {
+    /**
+     * Loads the files of the next scene on a background thread while the current scene plays
+     *
+     * The worker builds the scene's manifest, reads its JSON files into memory and decodes its images and sounds.
+     * None of that needs the renderer or the game's managers, so it runs beside the game. take() hands the
+     * results to the scene change, which turns them into textures, sounds and cached files before loading.
+     */
+public:
+    using DecodeImageFunction = ImageDecoder::DecodeFunction;
+    using DecodeSoundFunction = SoundBank::LoadFunction;
+
+    struct Prefetched {
+        SceneManifest manifest;
+        std::vector<std::pair<std::string, std::string>> files;
+        std::vector<std::pair<std::string, SDL_Surface*>> images;  // freed by whoever takes them
+        std::vector<std::pair<std::string, Mix_Chunk*>> sounds;    // freed by whoever takes them
+    };
+
+    explicit ScenePrefetcher(DecodeImageFunction decodeImage = ImageDecoder::decodeRGBA32,
+                             DecodeSoundFunction decodeSound = SoundBank::loadWAV);
+    ~ScenePrefetcher();
+    ScenePrefetcher(const ScenePrefetcher&) = delete;
+    ScenePrefetcher& operator=(const ScenePrefetcher&) = delete;
+
+    void start(const std::string& scenePath, const std::vector<std::string>& residentTextures);
+    bool isReady() const;
+    const std::string& getScenePath() const;
+    Prefetched take();
+    void cancel();
+
+private:
+    void run(std::vector<std::string> residentTextures);
+    static void freeLoaded(Prefetched& prefetched);
+
+    DecodeImageFunction decodeImage;
+    DecodeSoundFunction decodeSound;
+    std::string scenePath;  // empty when nothing is prefetched
+    Prefetched result;      // written by the worker until ready
+    std::atomic<bool> ready{false};
+    std::atomic<bool> cancelled{false};
+    std::thread worker;
+};
+
+#endif //BUMMERENGINE_SCENEPREFETCHER_H
@@ -0,0 +1,73 @@
+#include "SpatialGrid.h"
+
+SpatialGrid::SpatialGrid(int cellSize) : cellSize(cellSize > 0 ? cellSize : 1) {}
+
+void SpatialGrid::clear() {
+    /**
+     * Remove every item, keeping the cell buckets allocated for the next rebuild
+     */
+    items.clear();
+    for (auto& [key, cell] : cells) {
+        cell.clear();
+    }
+}
+
+void SpatialGrid::insert(int handle, const SDL_Rect& bounds) {
+    /**
+     * Add an item to every cell its bounds touch
+     *
+     * @param handle: The value reported back by query()
+     * @param bounds: The item's world space bounds
+     */
+    int itemIndex = static_cast<int>(items.size());
+    items.push_back({handle, bounds, queryStamp});
+
+    int lastX = toCell(bounds.x + bounds.w - 1);
+    int lastY = toCell(bounds.y + bounds.h - 1);
+    for (int cellY = toCell(bounds.y); cellY <= lastY; cellY++) {
+        for (int cellX = toCell(bounds.x); cellX <= lastX; cellX++) {
+            cells[cellKey(cellX, cellY)].push_back(itemIndex);
+        }
+    }
+}
+
+void SpatialGrid::query(const SDL_Rect& area, std::vector<int>& handles) {
+    /**
+     * Append the handles of all items whose bounds intersect an area
+     * Handles are appended in no particular order
+     *
+     * @param area: The world space area to search
+     * @param handles: The vector to append the results to
+     */
+    queryStamp++;
+    int lastX = toCell(area.x + area.w - 1);
+    int lastY = toCell(area.y + area.h - 1);
+    for (int cellY = toCell(area.y); cellY <= lastY; cellY++) {
+        for (int cellX = toCell(area.x); cellX <= lastX; cellX++) {
+            auto cell = cells.find(cellKey(cellX, cellY));
+            if (cell == cells.end()) {
+                continue;
+            }
+            for (int itemIndex : cell->second) {
+                Item& item = items[itemIndex];
+                if (item.queryStamp != queryStamp && SDL_HasIntersection(&item.bounds, &area)) {
+                    item.queryStamp = queryStamp;
+                    handles.push_back(item.handle);
+                }
+            }
+        }
+    }
+}
+
+size_t SpatialGrid::size() const {
+    return items.size();
+}
+
+int64_t SpatialGrid::cellKey(int cellX, int cellY) {
+    return (static_cast<int64_t>(cellX) << 32) | static_cast<uint32_t>(cellY);
+}
+
+int SpatialGrid::toCell(int coordinate) const {
+    // round towards negative infinity so negative coordinates land in the right cell
+    return coordinate >= 0 ? coordinate / cellSize : -((-coordinate - 1) / cellSize) - 1;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#ifndef BUMMERENGINE_SPATIALGRID_H
+#define BUMMERENGINE_SPATIALGRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+class SpatialGrid {
+    /**
+     * Uniform grid over world space answering "which items overlap this rect"
+     * Items are stored by an integer handle chosen by the caller, such as an index into the entities vector
+     * An item spanning several cells is listed in each of them and reported once per query
+     */
+public:
+    explicit SpatialGrid(int cellSize);
+    void clear();
+    void insert(int handle, const SDL_Rect& bounds);
+    void query(const SDL_Rect& area, std::vector<int>& handles);
+    size_t size() const;
+
+private:
+    struct Item {
+        int handle;
+        SDL_Rect bounds;
+        uint32_t queryStamp;
+    };
+
+    static int64_t cellKey(int cellX, int cellY);
+    int toCell(int coordinate) const;
+
+    int cellSize;
+    std::vector<Item> items;
+    std::unordered_map<int64_t, std::vector<int>> cells;  // cell -> indices into items
+    uint32_t queryStamp = 0;
+};
+
+#endif //BUMMERENGINE_SPATIALGRID_H
@@ -1,221 +1,77 @@
 #include "StateMachine.h"
 
-#include <iostream>
+#include "../Config.h"
 
-#include "EventManager.h"
-#include "../Utils.h"
-
-StateMachine::StateMachine(EntityManager& entityManager) : entityManager(entityManager) {
+StateMachine::StateMachine(EntityManager& entityManager, EventManager& eventManager)
+    : entityManager(entityManager), eventManager(eventManager) {
+    /**
+     * Constructor for the StateMachine
+     *
+     * Loads the default transition table and subscribes to every trigger event.
+     * Entities with a StateTable component use their own table instead of the default.
+     *
+     * @param entityManager: The entity manager that owns the transition tables
+     * @param eventManager: The event bus triggers are published on
+     */
+    defaultTableId = entityManager.transitionTables.load(STATE_TABLE_PATH);
+
+    for (int i = 0; i < TransitionTable::TRIGGER_COUNT; i++) {
+        auto trigger = static_cast<Trigger>(i);
+        subscriptions.push_back(eventManager.subscribe(TransitionTable::triggerName(trigger), [this, trigger](EventData data) {
+            handleTrigger(trigger, data);
+        }));
+    }
+}
 
-    EventManager::getInstance().subscribe("groundCollision", [&](EventData data) {
-        /**
-         * Handle the ground collision event
-         *
-         * @param data: The event data
-         */
-        try {
-            int entityId = data.primaryEntity->id;
-            Entity& entity = entityManager.getEntityById(entityId);
-            State& state = entity.getComponent<State>();
-            Velocity& vel = entity.getComponent<Velocity>();
+void StateMachine::handleTrigger(Trigger trigger, EventData data) {
+    /**
+     * Look up and apply the transition for a trigger
+     *
+     * @param trigger: The trigger
+     * @param data: The event data
+     */
+    Entity* entity = TransitionTable::targetsSecondary(trigger) ? data.secondaryEntity : data.primaryEntity;
+    if (entity == nullptr || !entity->hasComponent<State>()) {
+        return;
+    }
+
+    int tableId = entity->hasComponent<StateTable>() ? entity->getComponent<StateTable>().tableId : defaultTableId;
+    const Transition* transition = entityManager.transitionTables.get(tableId).find(trigger, *entity);
+    if (transition == nullptr) {
+        return;
+    }
+
+    if (transition->changesState) {
+        entity->changeState(transition->to);
+    }
+    for (const TransitionAction& action : transition->actions) {
+        applyAction(action, *entity);
+    }
+}
 
+void StateMachine::applyAction(const TransitionAction& action, Entity& entity) {
+    /**
+     * Apply a single transition action to an entity
+     *
+     * @param action: The action
+     * @param entity: The entity
+     */
+    switch (action.type) {
+        case TransitionActionType::PUBLISH:
+            eventManager.publish(action.event, {&entity});
+            break;
+        case TransitionActionType::RESET_JUMPS:
             if (entity.hasComponent<Jumps>()) {
-                entity.getComponent<Jumps>().jumps = 0;  // Reset the number of jumps
-            }
-
-            // if the player was falling, play the landed sound
-            if (state.state == playerState::JUMP_ASCEND ||
-                state.state == playerState::JUMP_DESCEND ||
-                state.state == playerState::JUMP_APEX ||
-                state.state == playerState::JUMP_APEX_DESCEND ||
-                state.state == playerState::JUMP_APEX_ASCEND ||
-                state.state == playerState::FLYING) {
-                EventManager::getInstance().publish("landed", {data.primaryEntity});
+                entity.getComponent<Jumps>().jumps = 0;
             }
-
-            // The entity is now grounded
+            break;
+        case TransitionActionType::SET_FLYING:
+            entity.changeFlyingState(true);
+            break;
+        case TransitionActionType::CLEAR_FLYING:
             entity.changeFlyingState(false);
-
-            // change the entity's state based on its velocity
-            if (vel.dx != 0 && state.state != playerState::STUNNED && state.state != playerState::BASIC_ATTACK && state.state != playerState::DASHING) {
-                // moving side to side, not stunned or attacking
-                if (state.state != playerState::RUN) {
-                    entity.changeState(playerState::RUN);
-                }
-            }
-            else if (state.state != playerState::STUNNED && state.state != playerState::BASIC_ATTACK && state.state != playerState::DASHING) {
-                // not moving, not stunned or attacking
-                if (state.state != playerState::IDLE) {
-                    entity.changeState(playerState::IDLE);
-                }
-            }
-
-        }
-        catch (const std::runtime_error& e) {
-            std::cout << "Could not find entity with id: " << data.primaryEntity->id << std::endl;
-
-        }
-
-    });
-
-    EventManager::getInstance().subscribe("moveLeft", [&](EventData data) {
-        Entity* entity = data.primaryEntity;
-        State& state = entity->getComponent<State>();
-        if (state.isFlying) {
-           state.state = playerState::FLYING;
-        }
-        else {
-            state.state = playerState::RUN;
-        }
-    });
-
-    EventManager::getInstance().subscribe("moveRight", [&](EventData data) {
-        Entity* entity = data.primaryEntity;
-        State& state = entity->getComponent<State>();
-        if (state.isFlying) {
-           state.state = playerState::FLYING;
-        }
-        else {
-            state.state = playerState::RUN;
-        }
-    });
-
-    EventManager::getInstance().subscribe("idle", [&](EventData data) {
-        Entity* entity = data.primaryEntity;
-        State& state = entity->getComponent<State>();
-        if (state.isFlying) {
-           state.state = playerState::FLYING;
-        }
-        else {
-            state.state = playerState::IDLE;
-        }
-    });
-
-    EventManager::getInstance().subscribe("basicAttack", [&](EventData data) {
-        /**
-         * Handle the basic attack event
-         *
-         * @param data: The event data
-         */
-
-        try {
-            Entity* entity = data.primaryEntity;
-            State& state = entity->getComponent<State>();
-            if (state.state != playerState::STUNNED && state.state != playerState::HIT && state.state != playerState::BASIC_ATTACK && state.state != playerState::DASHING) {
-                // not stunned or hit or currently attacking, can attack
-                entity->changeState(playerState::BASIC_ATTACK);
-                EventManager::getInstance().publish("basicAttackSound", {entity});
-            }
-        }
-        catch (const std::runtime_error& e) {
-            std::cout << "Could not find entity with id: " << data.primaryEntity->id << std::endl;
-        }
-    });
-
-    EventManager::getInstance().subscribe("attackEnd", [&](EventData data) {
-        /**
-         * Handle the basic attack end event
-         *
-         * @param data: The event data
-         */
-        try {
-            Entity* entity = data.primaryEntity;
-            auto& state = entity->getComponent<State>();
-            if (state.state == playerState::BASIC_ATTACK) {
-                auto& vel = entity->getComponent<Velocity>();
-                if (vel.dx == 0) {
-                    entity->changeState(playerState::IDLE);
-                }
-                else {
-                    entity->changeState(playerState::RUN);
-                }
-            }
-        }
-        catch (const std::runtime_error& e) {
-            std::cout << "Could not find entity with id: " << data.primaryEntity->id << std::endl;
-        }
-    });
-
-    EventManager::getInstance().subscribe("enemyHit", [&](EventData data) {
-        /**
-         * Handle the enemy hit event
-         *
-         * @param data: The event data
-         */
-        try {
-            Entity* other = data.secondaryEntity;
-            auto& state = other->getComponent<State>();
-            if (state.state != playerState::HIT) {
-                other->changeState(playerState::HIT);
-            }
-        }
-        catch (const std::runtime_error& e) {
-            std::cout << "Could not find entity with id: " << data.primaryEntity->id << std::endl;
-        }
-    });
-
-    EventManager::getInstance().subscribe("dash", [&](EventData data) {
-        try {
-            Entity* entity = data.primaryEntity;
-            entity->changeState(playerState::DASHING);
-            EventManager::getInstance().publish("dashSound", {entity});
-        }
-        catch (const std::runtime_error& e) {
-            std::cout << "Could not find entity with id: " << data.primaryEntity->id << std::endl;
-        }
-    });
-
-    EventManager::getInstance().subscribe("dashEnd", [&](EventData data) {
-        try {
-            Entity* entity = data.primaryEntity;
-            entity->changeState(playerState::IDLE);
-        }
-        catch (const std::runtime_error& e) {
-            std::cout << "Could not find entity with id: " << data.primaryEntity->id << std::endl;
-        }
-    });
-
-    EventManager::getInstance().subscribe("jump", [&](EventData data) {
-        try {
-            Entity* entity = data.primaryEntity;
-            entity->changeState(playerState::FLYING);
-            EventManager::getInstance().publish("jumpSound", {entity});
-
-        }
-        catch (const std::runtime_error& e) {
-            std::cout << "Could not find entity with id: " << data.primaryEntity->id << std::endl;
-        }
-    });
-
-    EventManager::getInstance().subscribe("airborne", [&](EventData data) {
-        try {
-            Entity* entity = data.primaryEntity;
-
-            if (entity->hasComponent<Velocity>() && entity->getComponent<State>().state != playerState::BASIC_ATTACK) {
-                if (entity->hasComponent<Dash>()) {
-                    if (entity->getComponent<Dash>().isDashing) {
-                        return;
-                    }
-                }
-                entity->changeFlyingState(true);
-                entity->changeState(playerState::FLYING);
-            }
-        }
-        catch (const std::runtime_error& e) {
-            std::cout << "Could not find entity with id: " << data.primaryEntity->id << std::endl;
-        }
-    });
-    EventManager::getInstance().subscribe("runLeft", [&](EventData data) {
-        try {
-            Entity* entity = data.primaryEntity;
-            if (entity->getComponent<State>().state != playerState::BASIC_ATTACK) {
-                entity->changeState(playerState::RUN);
-            }
-        }
-        catch (const std::runtime_error& e) {
-            std::cout << "Could not find entity with id: " << data.primaryEntity->id << std::endl;
-        }
-    });
+            break;
+    }
 }
 
 bool StateMachine::canMove(Entity &entity) {
@@ -232,4 +88,4 @@ bool StateMachine::canMove(Entity &entity) {
     bool notDashing = state.state != playerState::DASHING;
 
     return notStunned && notHit && notAttacking && notDashing;
-}
\ No newline at end of file
+}
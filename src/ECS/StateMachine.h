@@ -2,14 +2,23 @@
 #ifndef BUMMERENGINE_STATEMACHINE_H
 #define BUMMERENGINE_STATEMACHINE_H
 
+#include <vector>
+
 #include "EntityManager.h"
+#include "EventManager.h"
+#include "TransitionTable.h"
 
 class StateMachine {
 public:
-StateMachine(EntityManager& entityManager);
+StateMachine(EntityManager& entityManager, EventManager& eventManager);
 static bool canMove(Entity& entity);
+void handleTrigger(Trigger trigger, EventData data);
 private:
-    EntityManager entityManager;
+    EntityManager& entityManager;
+    EventManager& eventManager;
+    int defaultTableId;
+    std::vector<EventSubscription> subscriptions;
+    void applyAction(const TransitionAction& action, Entity& entity);
 };
 
 
@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <cmath>
+#include "Tilemap.h"
+#include "../Resources/AssetPack.h"
+
+Tilemap Tilemap::loadFromFile(const std::string& path) {
+    /**
+     * Load a tilemap from a JSON file. The tileset texture is left unset for the caller to load.
+     *
+     * @param path: The path to the tilemap file
+     * @throws runtime_error if the file cannot be opened or is malformed
+     */
+    std::string contents;
+    if (!readAsset(path, contents)) {
+        throw std::runtime_error("Could not open tilemap file: " + path);
+    }
+    return fromJson(nlohmann::json::parse(contents));
+}
+
+Tilemap Tilemap::fromJson(const nlohmann::json& tilemapJson) {
+    /**
+     * Build a tilemap from JSON
+     *
+     * @param tilemapJson: The tilemap JSON, see etc/templates/tilemaps/README.md
+     * @throws runtime_error if a layer does not have width * height tiles
+     */
+    Tilemap tilemap;
+    tilemap.id = newId();
+    tilemap.x = tilemapJson.value("x", 0);
+    tilemap.y = tilemapJson.value("y", 0);
+    tilemap.scale = tilemapJson.value("scale", 1.0f);
+    tilemap.width = tilemapJson["width"];
+    tilemap.height = tilemapJson["height"];
+
+    const nlohmann::json& tilesetJson = tilemapJson["tileset"];
+    tilemap.tilesetPath = tilesetJson["texturePath"];
+    tilemap.tileWidth = tilesetJson["tileWidth"];
+    tilemap.tileHeight = tilesetJson["tileHeight"];
+    tilemap.tilesetColumns = tilesetJson["columns"];
+    tilemap.tileset = nullptr;
+    tilemap.tilesetRegion = {0, 0, 0, 0};
+
+    if (tilemap.width <= 0 || tilemap.height <= 0 || tilemap.tileWidth <= 0 || tilemap.tileHeight <= 0 || tilemap.tilesetColumns <= 0) {
+        throw std::runtime_error("Tilemap sizes must be positive");
+    }
+
+    for (const auto& layerJson : tilemapJson["layers"]) {
+        TileLayer layer = {layerJson.value("name", ""), layerJson.value("solid", false), layerJson["tiles"].get<std::vector<int>>()};
+        if (layer.tiles.size() != static_cast<size_t>(tilemap.width * tilemap.height)) {
+            throw std::runtime_error("Tilemap layer '" + layer.name + "' has " + std::to_string(layer.tiles.size())
+                                     + " tiles, expected " + std::to_string(tilemap.width * tilemap.height));
+        }
+        tilemap.layers.push_back(layer);
+    }
+
+    tilemap.solidCells.assign(tilemap.width * tilemap.height, 0);
+    for (const TileLayer& layer : tilemap.layers) {
+        if (!layer.solid) {
+            continue;
+        }
+        for (size_t cell = 0; cell < layer.tiles.size(); cell++) {
+            if (layer.tiles[cell] != EMPTY_TILE) {
+                tilemap.solidCells[cell] = 1;
+            }
+        }
+    }
+    return tilemap;
+}
+
+int Tilemap::newId() {
+    /**
+     * A tilemap id not used before. A tilemap given a new id is baked again, like a newly loaded one.
+     */
+    static int nextId = 0;
+    return nextId++;
+}
+
+int Tilemap::getTile(int layer, int column, int row) const {
+    /**
+     * The tile at a grid position, EMPTY_TILE outside the map
+     *
+     * @param layer: The layer index
+     * @param column: The column, in tiles
+     * @param row: The row, in tiles
+     */
+    if (column < 0 || row < 0 || column >= width || row >= height) {
+        return EMPTY_TILE;
+    }
+    return layers[layer].tiles[row * width + column];
+}
+
+SDL_Rect Tilemap::getTileSourceRect(int tile) const {
+    /**
+     * The part of the tileset texture a tile index is cut from
+     *
+     * @param tile: A tile index
+     */
+    int column = tile % tilesetColumns;
+    int row = tile / tilesetColumns;
+    return {tilesetRegion.x + column * tileWidth, tilesetRegion.y + row * tileHeight, tileWidth, tileHeight};
+}
+
+SDL_Rect Tilemap::getWorldRect() const {
+    /**
+     * The world space area covered by the map
+     */
+    return {x, y, static_cast<int>(width * tileWidth * scale), static_cast<int>(height * tileHeight * scale)};
+}
+
+bool Tilemap::isSolid(int column, int row) const {
+    /**
+     * Whether a cell blocks movers, false outside the map
+     *
+     * @param column: The column, in tiles
+     * @param row: The row, in tiles
+     */
+    if (column < 0 || row < 0 || column >= width || row >= height) {
+        return false;
+    }
+    return solidCells[row * width + column] != 0;
+}
+
+SDL_Rect Tilemap::getCellRect(int column, int row) const {
+    /**
+     * The world space rect of a cell
+     * Edges are rounded from the unscaled grid so neighbouring cells share their edges exactly
+     *
+     * @param column: The column, in tiles
+     * @param row: The row, in tiles
+     */
+    float cellW = tileWidth * scale;
+    float cellH = tileHeight * scale;
+    int x0 = x + static_cast<int>(std::lround(column * cellW));
+    int y0 = y + static_cast<int>(std::lround(row * cellH));
+    int x1 = x + static_cast<int>(std::lround((column + 1) * cellW));
+    int y1 = y + static_cast<int>(std::lround((row + 1) * cellH));
+    return {x0, y0, x1 - x0, y1 - y0};
+}
+
+void Tilemap::getTouchedCells(const SDL_Rect& area, int& firstColumn, int& firstRow, int& lastColumn, int& lastRow) const {
+    /**
+     * The inclusive range of cells overlapping or touching an area, clamped to the map
+     * Touching counts, like CollisionSystem::isTouchingXaxis/isTouchingYaxis, so a mover standing on a tile finds it
+     * The range is empty (first > last) if the area is away from the map
+     *
+     * @param area: The world space area
+     */
+    float cellW = tileWidth * scale;
+    float cellH = tileHeight * scale;
+    firstColumn = std::max(0, static_cast<int>(std::floor((area.x - x) / cellW)) - 1);
+    firstRow = std::max(0, static_cast<int>(std::floor((area.y - y) / cellH)) - 1);
+    lastColumn = std::min(width - 1, static_cast<int>(std::floor((area.x + area.w - x) / cellW)));
+    lastRow = std::min(height - 1, static_cast<int>(std::floor((area.y + area.h - y) / cellH)));
+}
@@ -0,0 +1,57 @@
+#pragma once
+#ifndef BUMMERENGINE_TILEMAP_H
+#define BUMMERENGINE_TILEMAP_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <SDL2/SDL.h>
+#include <nlohmann/json.hpp>
+
+#include "../Resources/TextureHandle.h"
+
+struct TileLayer
+{
+    std::string name;
+    bool solid;  // non-empty tiles of this layer block movers
+    std::vector<int> tiles;  // row major, width * height tile indices into the tileset, -1 for empty
+};
+
+class Tilemap {
+    /**
+     * A grid of tiles drawn from one tileset image, placed in the world at (x, y)
+     * Layers are drawn in file order and are static: they are baked once by the TilemapRenderer
+     */
+public:
+    static constexpr int EMPTY_TILE = -1;
+
+    static Tilemap loadFromFile(const std::string& path);
+    static Tilemap fromJson(const nlohmann::json& tilemapJson);
+    static int newId();
+
+    int getTile(int layer, int column, int row) const;
+    SDL_Rect getTileSourceRect(int tile) const;
+    SDL_Rect getWorldRect() const;
+    bool isSolid(int column, int row) const;
+    SDL_Rect getCellRect(int column, int row) const;
+    void getTouchedCells(const SDL_Rect& area, int& firstColumn, int& firstRow, int& lastColumn, int& lastRow) const;
+
+    int id;  // unique per loaded tilemap, used to key cached render data
+    int x;
+    int y;
+    float scale;
+    int width;   // in tiles
+    int height;  // in tiles
+    int tileWidth;
+    int tileHeight;
+    std::string tilesetPath;
+    int tilesetColumns;
+    SDL_Texture* tileset;
+    SDL_Rect tilesetRegion;  // where the tileset image sits inside the tileset texture
+    TextureHandle tilesetHandle = INVALID_TEXTURE_HANDLE;  // a reference held while the tilemap is in the scene
+    std::vector<TileLayer> layers;
+    std::vector<uint8_t> solidCells;  // width * height, 1 where any solid layer has a tile
+};
+
+#endif //BUMMERENGINE_TILEMAP_H
@@ -0,0 +1,221 @@
+#include "TransitionTable.h"
+
+#include <stdexcept>
+
+#include "EntityManager.h"
+#include "../Resources/AssetPack.h"
+
+namespace {
+    const std::vector<std::string> triggerNames = {
+            "groundCollision",
+            "moveLeft",
+            "moveRight",
+            "idle",
+            "basicAttack",
+            "attackEnd",
+            "enemyHit",
+            "dash",
+            "dashEnd",
+            "jump",
+            "airborne",
+            "runLeft"
+    };
+
+    const std::unordered_map<std::string, TransitionGuard> guardMap = {
+            {"moving",  TransitionGuard::MOVING},
+            {"flying",  TransitionGuard::FLYING},
+            {"dashing", TransitionGuard::DASHING}
+    };
+
+    Trigger stringToTrigger(const std::string& trigger) {
+        for (size_t i = 0; i < triggerNames.size(); i++) {
+            if (triggerNames[i] == trigger) {
+                return static_cast<Trigger>(i);
+            }
+        }
+        throw std::runtime_error("Unknown state machine trigger: " + trigger);
+    }
+
+    playerState stringToState(const std::string& state) {
+        auto it = EntityManager::playerStatesMap.find(state);
+        if (it == EntityManager::playerStatesMap.end()) {
+            throw std::runtime_error("Unknown state in state machine: " + state);
+        }
+        return it->second;
+    }
+
+    TransitionAction stringToAction(const std::string& action) {
+        const std::string publishPrefix = "publish:";
+        if (action.rfind(publishPrefix, 0) == 0) {
+            return {TransitionActionType::PUBLISH, action.substr(publishPrefix.size())};
+        }
+        if (action == "resetJumps") {
+            return {TransitionActionType::RESET_JUMPS, ""};
+        }
+        if (action == "setFlying") {
+            return {TransitionActionType::SET_FLYING, ""};
+        }
+        if (action == "clearFlying") {
+            return {TransitionActionType::CLEAR_FLYING, ""};
+        }
+        throw std::runtime_error("Unknown state machine action: " + action);
+    }
+}
+
+TransitionTable TransitionTable::loadFromFile(const std::string& path) {
+    /**
+     * Load and compile a transition table from a JSON file
+     *
+     * @param path: The path to the state table file
+     * @throws runtime_error if the file cannot be opened or references unknown triggers, states or actions
+     */
+    std::string contents;
+    if (!readAsset(path, contents)) {
+        throw std::runtime_error("Could not open state table file: " + path);
+    }
+    return fromJson(ordered_json::parse(contents));
+}
+
+TransitionTable TransitionTable::fromJson(const ordered_json& tableJson) {
+    /**
+     * Compile a transition table from JSON
+     *
+     * Each transition names a trigger, the states it applies to ("*" for all),
+     * an optional guard, an optional target state and a list of actions.
+     *
+     * @param tableJson: The state table JSON
+     */
+    std::vector<std::vector<Transition>> cellTransitions(TRIGGER_COUNT * STATE_COUNT);
+
+    for (const auto& transitionJson : tableJson["transitions"]) {
+        Trigger trigger = stringToTrigger(transitionJson["trigger"]);
+
+        Transition transition = {TransitionGuard::NONE, false, playerState::IDLE, {}};
+        if (transitionJson.contains("guard")) {
+            auto guard = guardMap.find(transitionJson["guard"].get<std::string>());
+            if (guard == guardMap.end()) {
+                throw std::runtime_error("Unknown state machine guard: " + transitionJson["guard"].get<std::string>());
+            }
+            transition.guard = guard->second;
+        }
+        if (transitionJson.contains("to")) {
+            transition.changesState = true;
+            transition.to = stringToState(transitionJson["to"]);
+        }
+        if (transitionJson.contains("actions")) {
+            for (const auto& action : transitionJson["actions"]) {
+                transition.actions.push_back(stringToAction(action));
+            }
+        }
+
+        std::vector<playerState> fromStates;
+        const auto& fromJson = transitionJson["from"];
+        if (fromJson.is_string() && fromJson.get<std::string>() == "*") {
+            for (int state = 0; state < STATE_COUNT; state++) {
+                fromStates.push_back(static_cast<playerState>(state));
+            }
+        }
+        else {
+            for (const auto& state : fromJson) {
+                fromStates.push_back(stringToState(state));
+            }
+        }
+
+        for (playerState state : fromStates) {
+            int cell = static_cast<int>(trigger) * STATE_COUNT + static_cast<int>(state);
+            cellTransitions[cell].push_back(transition);
+        }
+    }
+
+    // flatten so that each cell is a contiguous run in transitions
+    TransitionTable table;
+    for (int cell = 0; cell < TRIGGER_COUNT * STATE_COUNT; cell++) {
+        table.cells[cell].first = static_cast<int>(table.transitions.size());
+        table.cells[cell].count = static_cast<int>(cellTransitions[cell].size());
+        table.transitions.insert(table.transitions.end(), cellTransitions[cell].begin(), cellTransitions[cell].end());
+    }
+    return table;
+}
+
+const std::string& TransitionTable::triggerName(Trigger trigger) {
+    /**
+     * Get the event name a trigger is published under
+     *
+     * @param trigger: The trigger
+     */
+    return triggerNames[static_cast<int>(trigger)];
+}
+
+bool TransitionTable::targetsSecondary(Trigger trigger) {
+    /**
+     * Check if the trigger applies to the event's secondary entity rather than the primary one
+     * e.g. enemyHit is published by the attacker but changes the state of the entity that was hit
+     *
+     * @param trigger: The trigger
+     */
+    return trigger == Trigger::ENEMY_HIT;
+}
+
+const Transition* TransitionTable::find(Trigger trigger, Entity& entity) const {
+    /**
+     * Find the transition to take for an entity in its current state
+     *
+     * @param trigger: The trigger
+     * @param entity: The entity, which must have a State component
+     * @return: The first transition whose guard passes, or nullptr if there is none
+     */
+    int state = static_cast<int>(entity.getComponent<State>().state);
+    const Cell& cell = cells[static_cast<int>(trigger) * STATE_COUNT + state];
+    for (int i = cell.first; i < cell.first + cell.count; i++) {
+        if (passes(transitions[i].guard, entity)) {
+            return &transitions[i];
+        }
+    }
+    return nullptr;
+}
+
+bool TransitionTable::passes(TransitionGuard guard, Entity& entity) {
+    /**
+     * Evaluate a transition guard against an entity
+     *
+     * @param guard: The guard
+     * @param entity: The entity
+     */
+    switch (guard) {
+        case TransitionGuard::NONE:
+            return true;
+        case TransitionGuard::MOVING:
+            return entity.hasComponent<Velocity>() && entity.getComponent<Velocity>().dx != 0;
+        case TransitionGuard::FLYING:
+            return entity.getComponent<State>().isFlying;
+        case TransitionGuard::DASHING:
+            return entity.hasComponent<Dash>() && entity.getComponent<Dash>().isDashing;
+    }
+    return false;
+}
+
+int TransitionTableLibrary::load(const std::string& path) {
+    /**
+     * Load a transition table, reusing it if the file was already loaded
+     *
+     * @param path: The path to the state table file
+     * @return: The id of the table
+     */
+    auto it = tableIds.find(path);
+    if (it != tableIds.end()) {
+        return it->second;
+    }
+    tables.push_back(TransitionTable::loadFromFile(path));
+    int tableId = static_cast<int>(tables.size()) - 1;
+    tableIds[path] = tableId;
+    return tableId;
+}
+
+const TransitionTable& TransitionTableLibrary::get(int tableId) const {
+    /**
+     * Get a loaded transition table by id
+     *
+     * @param tableId: The id returned by load()
+     */
+    return tables.at(tableId);
+}
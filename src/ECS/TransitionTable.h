@@ -0,0 +1,107 @@
+#pragma once
+#ifndef BUMMERENGINE_TRANSITIONTABLE_H
+#define BUMMERENGINE_TRANSITIONTABLE_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "Components.h"
+#include "Entity.h"
+
+using ordered_json = nlohmann::ordered_json;
+
+// Events the StateMachine reacts to. Each one is published by a system, so the set is fixed in code.
+enum class Trigger
+{
+    GROUND_COLLISION,
+    MOVE_LEFT,
+    MOVE_RIGHT,
+    IDLE,
+    BASIC_ATTACK,
+    ATTACK_END,
+    ENEMY_HIT,
+    DASH,
+    DASH_END,
+    JUMP,
+    AIRBORNE,
+    RUN_LEFT,
+    COUNT
+};
+
+enum class TransitionGuard
+{
+    NONE,
+    MOVING,   // Velocity.dx != 0
+    FLYING,   // State.isFlying
+    DASHING   // Dash.isDashing
+};
+
+enum class TransitionActionType
+{
+    PUBLISH,
+    RESET_JUMPS,
+    SET_FLYING,
+    CLEAR_FLYING
+};
+
+struct TransitionAction
+{
+    TransitionActionType type;
+    std::string event;  // only used by PUBLISH
+};
+
+struct Transition
+{
+    TransitionGuard guard;
+    bool changesState;
+    playerState to;
+    std::vector<TransitionAction> actions;
+};
+
+class TransitionTable {
+    /**
+     * A state machine compiled from JSON into a dense [trigger][state] lookup
+     *
+     * Each cell holds the transitions authored for that trigger and state, in file order.
+     * The first transition whose guard passes is taken; a cell with no match leaves the state alone.
+     */
+public:
+    static constexpr int STATE_COUNT = PLAYER_STATE_COUNT;
+    static constexpr int TRIGGER_COUNT = static_cast<int>(Trigger::COUNT);
+
+    static TransitionTable loadFromFile(const std::string& path);
+    static TransitionTable fromJson(const ordered_json& tableJson);
+    static const std::string& triggerName(Trigger trigger);
+    static bool targetsSecondary(Trigger trigger);
+
+    const Transition* find(Trigger trigger, Entity& entity) const;
+
+private:
+    struct Cell {
+        int first = 0;
+        int count = 0;
+    };
+
+    std::vector<Transition> transitions;  // grouped by cell
+    Cell cells[TRIGGER_COUNT * STATE_COUNT];
+
+    static bool passes(TransitionGuard guard, Entity& entity);
+};
+
+class TransitionTableLibrary {
+    /**
+     * Owns every TransitionTable loaded so far, each one loaded once per file
+     */
+public:
+    int load(const std::string& path);
+    const TransitionTable& get(int tableId) const;
+
+private:
+    std::vector<TransitionTable> tables;
+    std::unordered_map<std::string, int> tableIds;
+};
+
+#endif //BUMMERENGINE_TRANSITIONTABLE_H
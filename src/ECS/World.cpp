@@ -0,0 +1,34 @@
+#include "World.h"
+
+World::World(TextureManager* textureManager, SDL_Renderer* renderer)
+    : entityManager(textureManager, renderer),
+      sceneManager(entityManager),
+      stateMachine(entityManager, eventManager) {
+    /**
+     * Constructor for the World
+     *
+     * @param textureManager: The texture manager
+     * @param renderer: The SDL renderer
+     */
+}
+
+EventManager& World::getEventManager() {
+    /**
+     * Return a reference to the world's event bus
+     */
+    return eventManager;
+}
+
+EntityManager& World::getEntityManager() {
+    /**
+     * Return a reference to the world's entity manager
+     */
+    return entityManager;
+}
+
+SceneManager& World::getSceneManager() {
+    /**
+     * Return a reference to the world's scene manager
+     */
+    return sceneManager;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#ifndef BUMMERENGINE_WORLD_H
+#define BUMMERENGINE_WORLD_H
+
+#include "EntityManager.h"
+#include "EventManager.h"
+#include "SceneManager.h"
+#include "StateMachine.h"
+
+class World {
+    /**
+     * A self-contained simulation: entities, scenes and the event bus they communicate over
+     * Worlds share no state, so several can run side by side
+     */
+public:
+    World(TextureManager* textureManager, SDL_Renderer* renderer);
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+
+    EventManager& getEventManager();
+    EntityManager& getEntityManager();
+    SceneManager& getSceneManager();
+
+private:
+    // eventManager is declared first so that it outlives every subscription made by the members below
+    EventManager eventManager;
+    EntityManager entityManager;
+    SceneManager sceneManager;
+    StateMachine stateMachine;
+};
+
+#endif //BUMMERENGINE_WORLD_H
@@ -1,4 +1,10 @@
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <thread>
+
 #include "GameEngine.h"
+#include "RenderThread.h"
 #include "../UI/SplashScreen.h"
 #include "../UI/Menu.h"
 #include "../Systems/RenderSystem.h"
@@ -6,13 +12,16 @@
 #include "../Systems/InputSystem.h"
 #include "../Systems/PhysicsSystem.h"
 #include "../Systems/SoundSystem.h"
+#include "../Systems/MusicPlayer.h"
 #include "../Systems/AttackSystem.h"
 #include "../Systems/AISystem.h"
 #include "../Systems/CooldownSystem.h"
+#include "../Systems/DebugDraw.h"
 
 #include "../Config.h"
-#include "../ECS/StateMachine.h"
-#include "../ECS/EventManager.h"
+#include "../Logger.h"
+#include "../ECS/World.h"
+#include "../ECS/HotReloader.h"
 #include "../Utils.cpp"
 
 void game_loop(SDL_Renderer* renderer, TTF_Font* font) {
@@ -22,32 +31,77 @@ void game_loop(SDL_Renderer* renderer, TTF_Font* font) {
      * @param renderer: The SDL renderer
      * @param font: The TTF font
      */
+    // This thread keeps the renderer and the event queue. Loading behind the splash screen, and the simulation
+    // later on when RENDER_THREAD is set, reach the renderer through renderThread.
+    RenderThread renderThread;
     render_splash_screen(renderer, font);
 
     Menu menu(renderer, font);
 
     TextureManager textureManager;
-    EntityManager entityManager(&textureManager, renderer);
-    SceneManager sceneManager(entityManager);
-    StateMachine stateMachine(entityManager);
-    
+    // decode images on worker threads, 0 threads keeps loading synchronous
+    textureManager.enableAsyncLoading(TEXTURE_DECODE_THREADS);
+    textureManager.setMemoryBudget(static_cast<size_t>(TEXTURE_BUDGET_MB) * 1024 * 1024);
+    textureManager.setRendererInvoker([&renderThread](const std::function<void()>& task) {
+        renderThread.invoke(task);
+    });
+    SoundBank soundBank;
+    // music and ambience are streamed in the mixer's own format
+    int audioFrequency = 0;
+    Uint16 audioFormat = 0;
+    int audioChannels = 0;
+    Mix_QuerySpec(&audioFrequency, &audioFormat, &audioChannels);
+    MusicPlayer musicPlayer(audioFrequency, audioFormat, audioChannels);
+    musicPlayer.install();
+    World world(&textureManager, renderer);
+    EventManager& eventManager = world.getEventManager();
+    EntityManager& entityManager = world.getEntityManager();
+    SceneManager& sceneManager = world.getSceneManager();
+    sceneManager.setSoundBank(&soundBank);
+    sceneManager.setMusicPlayer(&musicPlayer);
+    sceneManager.setPrefetching(SCENE_PREFETCH);
+    // saved templates, animators and images are picked up without restarting
+    HotReloader hotReloader(entityManager, sceneManager);
+    if (HOT_RELOAD) {
+        hotReloader.watch("assets");
+        hotReloader.watch("etc/templates");
+    }
+
     AnimationSystem animationSystem;
-    CollisionSystem collisionSystem;
+    CollisionSystem collisionSystem(eventManager);
     CooldownSystem cooldownSystem;
     InputSystem inputSystem;
-    MovementSystem movementSystem;
-    PhysicsSystem physicsSystem;
+    MovementSystem movementSystem(eventManager);
+    PhysicsSystem physicsSystem(eventManager);
     RenderSystem renderSystem;
-//    SoundSystem soundSystem;
-    AttackSystem attackSystem;
+    // baked tilemap chunks are redrawn if the renderer loses its render targets
+    renderSystem.watchRendererEvents();
+    AttackSystem attackSystem(eventManager);
     AISystem aiSystem;
 
-    // Setup controller
+    // Setup controller, only touched by the thread that polls events
     SDL_GameController* controller = nullptr;
 
-    // entity manager testing sandbox, just for testing new features
-    sandbox(sceneManager);
-    EventManager::getInstance().publish("start", {});
+    // The atlas and the first scene load while the splash screen is up: images decode on the decoder's threads,
+    // templates parse and sounds decode on the loading thread, and only texture uploads come back to this one
+    bool windowOpen = loadBehindSplashScreen(renderer, font, renderThread, textureManager, [&]() {
+        // pack sprites before any entity loads them so their rects point into the atlas pages
+        textureManager.buildAtlas(renderer, TextureManager::listImageFiles(ATLAS_SOURCE_DIR), ATLAS_PAGE_SIZE);
+        // the SoundBank is not thread safe, nothing else touches it until the loader has joined
+        soundBank.preload(SoundSystem::getEffectFiles());
+        // entity manager testing sandbox, just for testing new features
+        sandbox(sceneManager);
+    });
+    if (!windowOpen) {
+        textureManager.setRendererInvoker(nullptr);
+        return;
+    }
+    // only looks up the effects preloaded above
+    SoundSystem soundSystem(eventManager, soundBank, SOUND_VOICES);
+    eventManager.setStatsDumpInterval(EVENT_STATS_INTERVAL);
+    // F1 toggles the overlay at runtime
+    DebugDraw::getInstance().setEnabled(DEBUG_DRAW);
+    eventManager.publish("start", {});
 
     bool quit = false;
     bool startMenu = true;
@@ -55,34 +109,161 @@ void game_loop(SDL_Renderer* renderer, TTF_Font* font) {
     float deltaTime = 0.0f;
     SDL_RenderSetLogicalSize(renderer, VIRTUAL_WIDTH, VIRTUAL_HEIGHT);
 
-    while (!quit) {
-        // handle frame timing
-        std::tie(lastTime, deltaTime) = incrementTime(lastTime, deltaTime);
-
-        // Open controller if added during runtime
-        if (SDL_NumJoysticks() > 0) {
-            controller = SDL_GameControllerOpen(0);
+    auto simulate = [&]() {
+        // Perform game logic updates, input is handled by the caller
+        if (HOT_RELOAD) {
+            hotReloader.update();
         }
-
-        // Show Start Menu if necessary
-        if (startMenu) {
-            menu.update(startMenu, quit);
-        }
-
-        // Perform game logic updates
-        inputSystem.update(entityManager, startMenu);
         aiSystem.update(entityManager);
         cooldownSystem.update(entityManager, deltaTime);
         attackSystem.update(entityManager);
         physicsSystem.update(sceneManager, entityManager, movementSystem, collisionSystem, deltaTime);
         animationSystem.update(entityManager);
+        // music is read from disk here, the audio thread only mixes what is ready
+        musicPlayer.update();
+
+        // sync point: dispatch anything still queued before rendering
+        eventManager.flush();
+    };
+
+    if (!RENDER_THREAD) {
+        // everything runs on this thread from here on
+        textureManager.setRendererInvoker(nullptr);
+        while (!quit) {
+            // handle frame timing
+            std::tie(lastTime, deltaTime) = incrementTime(lastTime, deltaTime);
+
+            // Open controller if added during runtime
+            openController(controller);
 
-        // Render updates
-        SDL_SetRenderDrawColor(renderer, 124, 200, 255, 255);  // sky blue
-        SDL_RenderClear(renderer);
-        renderSystem.render(renderer, entityManager, font);
-        SDL_RenderPresent(renderer);
+            // Show Start Menu if necessary
+            if (startMenu) {
+                menu.update(startMenu, quit);
+            }
+
+            inputSystem.update(entityManager, startMenu);
+            simulate();
+
+            // Render updates
+            textureManager.uploadDecodedTextures(TextureManager::UPLOADS_PER_FRAME);
+            renderSystem.render(renderer, entityManager, sceneManager.shareTilemaps(), font);
+            SDL_RenderPresent(renderer);
+            textureManager.destroyRetiredTextures();
+
+            eventManager.endFrame();
+        }
+        return;
+    }
+
+    // Simulation moves to a worker thread so frame N+1 is simulated while frame N is presented.
+    // This thread keeps the renderer and the event queue, as SDL requires, and draws the command lists handed to it.
+    std::exception_ptr simulationError;
+    std::thread simulation([&]() {
+        try {
+            RenderCommandList commands;
+            while (!quit && !renderThread.isStopping()) {
+                std::tie(lastTime, deltaTime) = incrementTime(lastTime, deltaTime);
+
+                // the menu polls events and draws by itself, so it runs on the render thread
+                if (startMenu) {
+                    renderThread.invoke([&]() { menu.update(startMenu, quit); });
+                }
+
+                inputSystem.update(entityManager, startMenu, renderThread.takeEvents());
+                simulate();
+
+                renderSystem.buildCommands(entityManager, sceneManager.shareTilemaps(), commands);
+                renderThread.submit(commands);
+
+                eventManager.endFrame();
+            }
+        } catch (...) {
+            simulationError = std::current_exception();
+        }
+        renderThread.stop();
+    });
 
+    try {
+        renderThread.run([&](const RenderCommandList& commands) {
+            openController(controller);
+            textureManager.uploadDecodedTextures(TextureManager::UPLOADS_PER_FRAME);
+            renderSystem.execute(renderer, commands, font);
+            SDL_RenderPresent(renderer);
+            textureManager.destroyRetiredTextures();
+        });
+    } catch (...) {
+        renderThread.stop();
+        simulation.join();
+        throw;
+    }
+    simulation.join();
+    textureManager.setRendererInvoker(nullptr);
+
+    if (simulationError) {
+        std::rethrow_exception(simulationError);
+    }
+}
+
+bool loadBehindSplashScreen(SDL_Renderer* renderer, TTF_Font* font, RenderThread& renderThread, TextureManager& textureManager,
+                            const std::function<void()>& load) {
+    /**
+     * Run load on another thread while the splash screen stays up, serving the renderer calls it makes
+     * The splash ends once load is done, every decoded texture is uploaded and SPLASH_MIN_MS have passed
+     *
+     * @param renderer: The SDL renderer
+     * @param font: The TTF font
+     * @param renderThread: Runs the tasks load invokes, must belong to this thread
+     * @param textureManager: Its decoded images are uploaded while waiting
+     * @param load: The startup work
+     * @return: false if the window was closed during the splash
+     * @throws whatever load throws
+     */
+    Uint32 splashStart = SDL_GetTicks();
+    std::atomic<bool> loaded(false);
+    std::exception_ptr loadError;
+    std::thread loader([&]() {
+        try {
+            load();
+        } catch (...) {
+            loadError = std::current_exception();
+        }
+        loaded = true;
+    });
+
+    bool windowOpen = true;
+    auto noFrames = [](const RenderCommandList&) {};
+    while (true) {
+        renderThread.runOnce(noFrames, RenderThread::EVENT_POLL_MS);
+        textureManager.uploadDecodedTextures(TextureManager::UPLOADS_PER_FRAME);
+        for (const SDL_Event& event : renderThread.takeEvents()) {
+            if (event.type == SDL_QUIT) {
+                windowOpen = false;
+            } else if (event.type == SDL_WINDOWEVENT) {
+                // the window may have been uncovered or resized
+                render_splash_screen(renderer, font);
+            }
+        }
+        bool ready = loaded && textureManager.getPendingUploadCount() == 0;
+        if (ready && (!windowOpen || SDL_GetTicks() - splashStart >= static_cast<Uint32>(SPLASH_MIN_MS))) {
+            break;
+        }
+    }
+    loader.join();
+    LOG_INFO("engine", "Loaded in " << SDL_GetTicks() - splashStart << " ms behind the splash screen");
+    if (loadError) {
+        std::rethrow_exception(loadError);
+    }
+    return windowOpen;
+}
+
+void openController(SDL_GameController*& controller) {
+    /**
+     * Open the first game controller if one was plugged in since the last call
+     *
+     * @param controller: The open controller, or nullptr
+     */
+    if (controller == nullptr && SDL_NumJoysticks() > 0) {
+        controller = SDL_GameControllerOpen(0);
     }
 }
 
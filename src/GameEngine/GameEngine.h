@@ -5,13 +5,19 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 
+#include <functional>
+
 #include "../ECS/EntityManager.h"
 #include "../ECS/SceneManager.h"
+#include "RenderThread.h"
 #include "../Systems/CollisionSystem.h"
 #include "../Systems/MovementSystem.h"
 
 void game_loop(SDL_Renderer* renderer, TTF_Font* font);
+bool loadBehindSplashScreen(SDL_Renderer* renderer, TTF_Font* font, RenderThread& renderThread, TextureManager& textureManager,
+                            const std::function<void()>& load);
 void sandbox(SceneManager& SceneManager);
+void openController(SDL_GameController*& controller);
 std::tuple<Uint32, float> incrementTime(Uint32 lastTime, float deltaTime);
 
 #endif //BUMMERENGINE_GAMEENGINE_H
@@ -0,0 +1,180 @@
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+
+#include "RenderThread.h"
+
+RenderThread::RenderThread() : renderThreadId(std::this_thread::get_id()), hasPending(false), stopping(false), framesDrawn(0) {
+    /**
+     * Constructor for the RenderThread, the calling thread becomes the render thread
+     */
+}
+
+void RenderThread::submit(RenderCommandList& commands) {
+    /**
+     * Hand a frame to the render thread, waiting while the previously submitted frame has not been picked up
+     * commands is swapped with an already drawn list and cleared, so its vectors keep their capacity
+     *
+     * @param commands: The frame to draw
+     */
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [this] { return !hasPending || stopping; });
+    if (stopping) {
+        return;
+    }
+    std::swap(pending, commands);
+    hasPending = true;
+    lock.unlock();
+    condition.notify_all();
+    commands.clear();
+}
+
+void RenderThread::invoke(const std::function<void()>& task) {
+    /**
+     * Run a task on the render thread and wait for it to finish
+     * Runs it straight away when called from the render thread itself
+     * Exceptions thrown by the task are rethrown here
+     *
+     * @param task: The work to run, e.g. creating a texture
+     */
+    if (isRenderThread()) {
+        task();
+        return;
+    }
+    Task queued = {&task, nullptr, false};
+    std::unique_lock<std::mutex> lock(mutex);
+    if (stopping) {
+        throw std::runtime_error("Render thread stopped, cannot run task");
+    }
+    tasks.push_back(&queued);
+    condition.notify_all();
+    condition.wait(lock, [&queued] { return queued.done; });
+    if (queued.error) {
+        std::rethrow_exception(queued.error);
+    }
+}
+
+std::vector<SDL_Event> RenderThread::takeEvents() {
+    /**
+     * The events polled by the render thread since the last call, oldest first
+     */
+    std::vector<SDL_Event> taken;
+    std::lock_guard<std::mutex> lock(mutex);
+    taken.swap(events);
+    return taken;
+}
+
+void RenderThread::stop() {
+    /**
+     * Make run() return once queued tasks are done and submit() return without waiting
+     * Called by the simulation when it exits, or by the render thread when it fails,
+     * in which case queued tasks are not run and invoke() throws instead
+     * A frame already submitted is still drawn
+     */
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        if (isRenderThread()) {
+            for (Task* task : tasks) {
+                task->error = std::make_exception_ptr(std::runtime_error("Render thread stopped, cannot run task"));
+                task->done = true;
+            }
+            tasks.clear();
+        }
+    }
+    condition.notify_all();
+}
+
+bool RenderThread::isStopping() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stopping;
+}
+
+void RenderThread::run(const FrameCallback& drawFrame) {
+    /**
+     * Draw submitted frames and run invoked tasks until stop() is called
+     *
+     * @param drawFrame: Draws and presents one frame, called on this thread
+     */
+    while (runOnce(drawFrame, EVENT_POLL_MS)) {
+    }
+}
+
+bool RenderThread::runOnce(const FrameCallback& drawFrame, int timeoutMs) {
+    /**
+     * Run one invoked task, or poll events and draw the pending frame, waiting up to timeoutMs for work
+     * Tasks go first since the simulation is blocked on them. Events are left in the SDL queue while a task
+     * runs, a task like the start menu reads its own input.
+     *
+     * @param drawFrame: Draws and presents one frame
+     * @param timeoutMs: How long to wait for work
+     * @return: false once stopped and there is nothing left to run or draw
+     */
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] {
+        return !tasks.empty() || hasPending || stopping;
+    });
+
+    if (!tasks.empty()) {
+        Task* task = tasks.front();
+        tasks.pop_front();
+        lock.unlock();
+        try {
+            (*task->work)();
+        } catch (...) {
+            task->error = std::current_exception();
+        }
+        lock.lock();
+        task->done = true;
+        lock.unlock();
+        condition.notify_all();
+        return true;
+    }
+
+    lock.unlock();
+    pollEvents();
+    lock.lock();
+
+    if (stopping && !hasPending) {
+        return false;
+    }
+
+    if (hasPending) {
+        std::swap(presenting, pending);
+        hasPending = false;
+        lock.unlock();
+        // the simulation can start filling the next frame while this one is drawn
+        condition.notify_all();
+        drawFrame(presenting);
+        lock.lock();
+        framesDrawn++;
+    }
+    return true;
+}
+
+bool RenderThread::isRenderThread() const {
+    return std::this_thread::get_id() == renderThreadId;
+}
+
+uint64_t RenderThread::getFramesDrawn() const {
+    /**
+     * Only meaningful on the render thread, or after the simulation has stopped
+     */
+    return framesDrawn;
+}
+
+void RenderThread::pollEvents() {
+    /**
+     * Move pending SDL events into the inbox read by takeEvents()
+     */
+    SDL_Event e;
+    std::vector<SDL_Event> polled;
+    while (SDL_PollEvent(&e) != 0) {
+        polled.push_back(e);
+    }
+    if (polled.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    events.insert(events.end(), polled.begin(), polled.end());
+}
@@ -0,0 +1,72 @@
+#pragma once
+#ifndef BUMMERENGINE_RENDERTHREAD_H
+#define BUMMERENGINE_RENDERTHREAD_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+#include "../Systems/RenderCommands.h"
+
+class RenderThread {
+    /**
+     * Hands finished frames from the simulation to the thread that owns the SDL_Renderer
+     *
+     * SDL only allows rendering and event polling on the thread that created the window, so the render thread is
+     * whichever thread constructs this object and calls run(), normally main, and the simulation runs on another.
+     * One submitted frame can wait while the previous one is drawn; submit() blocks past that, which keeps the
+     * simulation at most a frame ahead of what is on screen. Simulation work that needs the renderer, like loading
+     * textures, is run on the render thread through invoke(). Events polled here are collected for takeEvents().
+     */
+public:
+    using FrameCallback = std::function<void(const RenderCommandList&)>;
+
+    static constexpr int EVENT_POLL_MS = 4;  // longest the render thread sleeps without polling events
+
+    RenderThread();
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    // simulation side
+    void submit(RenderCommandList& commands);
+    void invoke(const std::function<void()>& task);
+    std::vector<SDL_Event> takeEvents();
+    void stop();
+    bool isStopping();
+
+    // render side
+    void run(const FrameCallback& drawFrame);
+    bool runOnce(const FrameCallback& drawFrame, int timeoutMs);
+
+    bool isRenderThread() const;
+    uint64_t getFramesDrawn() const;
+
+private:
+    struct Task {
+        const std::function<void()>* work;
+        std::exception_ptr error;
+        bool done;
+    };
+
+    void pollEvents();
+
+    std::thread::id renderThreadId;
+    std::mutex mutex;
+    std::condition_variable condition;
+    RenderCommandList pending;     // submitted, not yet drawn
+    RenderCommandList presenting;  // being drawn, swapped back to the simulation on the next submit
+    bool hasPending;
+    bool stopping;
+    std::deque<Task*> tasks;
+    std::vector<SDL_Event> events;
+    uint64_t framesDrawn;
+};
+
+#endif //BUMMERENGINE_RENDERTHREAD_H
@@ -0,0 +1,215 @@
+#include "Logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    const char* levelToString(LogLevel level) {
+        switch (level) {
+            case LogLevel::DEBUG:
+                return "DEBUG";
+            case LogLevel::INFO:
+                return "INFO";
+            case LogLevel::WARN:
+                return "WARN";
+            case LogLevel::ERROR:
+                return "ERROR";
+        }
+        return "?";
+    }
+}
+
+Logger& Logger::getInstance() {
+    static Logger instance;
+    return instance;
+}
+
+Logger::Logger() : slots(QUEUE_CAPACITY), startTime(std::chrono::steady_clock::now()) {
+    /**
+     * Constructor sets up the ring buffer and starts the writer thread
+     */
+    for (size_t i = 0; i < QUEUE_CAPACITY; i++) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+#if BUMMER_MIN_LOG_LEVEL <= 0
+    minLevel = static_cast<int>(LogLevel::DEBUG);
+#endif
+    worker = std::thread(&Logger::drain, this);
+}
+
+Logger::~Logger() {
+    /**
+     * Stop the writer thread after it has written everything already queued
+     */
+    running = false;
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void Logger::setLevel(LogLevel level) {
+    /**
+     * Set the lowest level that is logged at runtime
+     * Levels below BUMMER_MIN_LOG_LEVEL are compiled out and cannot be re-enabled here
+     *
+     * @param level: The minimum level
+     */
+    minLevel = static_cast<int>(level);
+}
+
+bool Logger::shouldLog(LogLevel level, RateLimit& rateLimit) {
+    /**
+     * Check the level and the call site's rate limit
+     * Messages over the limit are counted and reported with the next message that gets through
+     *
+     * @param level: The message level
+     * @param rateLimit: The call site's rate limit
+     */
+    if (static_cast<int>(level) < minLevel.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    uint32_t now = elapsedMs();
+    uint32_t windowStart = rateLimit.windowStartMs.load(std::memory_order_relaxed);
+    if (now - windowStart >= 1000) {
+        if (rateLimit.windowStartMs.compare_exchange_strong(windowStart, now, std::memory_order_relaxed)) {
+            rateLimit.windowCount.store(0, std::memory_order_relaxed);
+        }
+    }
+    if (rateLimit.windowCount.fetch_add(1, std::memory_order_relaxed) < MESSAGES_PER_SECOND) {
+        return true;
+    }
+    rateLimit.suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void Logger::log(LogLevel level, const char* category, const std::string& message, uint32_t suppressed) {
+    /**
+     * Queue a message for the writer thread. Long messages are truncated.
+     *
+     * @param level: The message level
+     * @param category: The subsystem the message comes from. Must outlive the logger, e.g. a string literal
+     * @param message: The message text
+     * @param suppressed: How many messages from the same call site were rate limited since the last one
+     */
+    LogMessage logMessage;
+    logMessage.level = level;
+    logMessage.category = category;
+    logMessage.timeMs = elapsedMs();
+    logMessage.suppressed = suppressed;
+    size_t length = std::min(message.size(), MAX_MESSAGE_LENGTH - 1);
+    std::memcpy(logMessage.text, message.data(), length);
+    logMessage.text[length] = '\0';
+
+    if (!push(logMessage)) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Logger::flush() {
+    /**
+     * Block until everything queued so far has been written
+     * Only meant for shutdown and tests, never for the game loop
+     */
+    size_t target = enqueuePos.load(std::memory_order_acquire);
+    while (written.load(std::memory_order_acquire) < target && running) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+uint64_t Logger::getDroppedCount() const {
+    /**
+     * Get the number of messages dropped because the queue was full
+     */
+    return dropped.load(std::memory_order_relaxed);
+}
+
+bool Logger::push(const LogMessage& message) {
+    /**
+     * Bounded multi-producer, multi-consumer ring buffer push
+     * Each slot's sequence number tells producers and the consumer whose turn it is
+     *
+     * @param message: The message to queue
+     * @return: False if the queue is full
+     */
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+        Slot& slot = slots[pos & (QUEUE_CAPACITY - 1)];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.message = message;
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0) {
+            return false;
+        }
+        else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool Logger::pop(LogMessage& message) {
+    /**
+     * Ring buffer pop, only called from the writer thread
+     *
+     * @param message: Receives the message
+     * @return: False if the queue is empty
+     */
+    size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    Slot& slot = slots[pos & (QUEUE_CAPACITY - 1)];
+    size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1) < 0) {
+        return false;
+    }
+    message = slot.message;
+    dequeuePos.store(pos + 1, std::memory_order_relaxed);
+    slot.sequence.store(pos + QUEUE_CAPACITY, std::memory_order_release);
+    return true;
+}
+
+void Logger::drain() {
+    /**
+     * Writer thread: write queued messages in batches, flushing stdout once per batch
+     */
+    LogMessage message;
+    while (true) {
+        bool wroteAny = false;
+        while (pop(message)) {
+            write(message);
+            written.fetch_add(1, std::memory_order_release);
+            wroteAny = true;
+        }
+        if (wroteAny) {
+            std::cout.flush();
+        }
+        else if (!running) {
+            return;
+        }
+        else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+}
+
+void Logger::write(const LogMessage& message) {
+    /**
+     * Write a single message to stdout
+     *
+     * @param message: The message
+     */
+    std::cout << "[" << message.timeMs << "ms] " << levelToString(message.level) << " " << message.category << ": " << message.text;
+    if (message.suppressed > 0) {
+        std::cout << " (" << message.suppressed << " similar messages suppressed)";
+    }
+    std::cout << '\n';
+}
+
+uint32_t Logger::elapsedMs() const {
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count());
+}
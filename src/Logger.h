@@ -0,0 +1,108 @@
+#pragma once
+#ifndef BUMMERENGINE_LOGGER_H
+#define BUMMERENGINE_LOGGER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Messages below this level are compiled out. Debug builds define it as 0 to keep LOG_DEBUG.
+#ifndef BUMMER_MIN_LOG_LEVEL
+#define BUMMER_MIN_LOG_LEVEL 1
+#endif
+
+enum class LogLevel
+{
+    DEBUG = 0,
+    INFO = 1,
+    WARN = 2,
+    ERROR = 3
+};
+
+class Logger {
+    /**
+     * Asynchronous logger
+     *
+     * Producers format into a fixed-size slot of a lock-free ring buffer and return immediately.
+     * A background thread drains the ring and writes to stdout, so the game thread never flushes.
+     * If the ring is full the message is dropped and counted instead of blocking.
+     */
+public:
+    struct RateLimit {
+        /**
+         * Per call site limit of messages per second, shared by every thread that hits the call site
+         */
+        std::atomic<uint32_t> windowStartMs{0};
+        std::atomic<uint32_t> windowCount{0};
+        std::atomic<uint32_t> suppressed{0};
+    };
+
+    static constexpr int MESSAGES_PER_SECOND = 10;
+    static constexpr size_t QUEUE_CAPACITY = 1024;  // must be a power of two
+    static constexpr size_t MAX_MESSAGE_LENGTH = 240;
+
+    static Logger& getInstance();
+    ~Logger();
+
+    void setLevel(LogLevel level);
+    bool shouldLog(LogLevel level, RateLimit& rateLimit);
+    void log(LogLevel level, const char* category, const std::string& message, uint32_t suppressed = 0);
+    void flush();
+    uint64_t getDroppedCount() const;
+
+private:
+    struct LogMessage {
+        LogLevel level;
+        const char* category;
+        uint32_t timeMs;
+        uint32_t suppressed;
+        char text[MAX_MESSAGE_LENGTH];
+    };
+
+    struct Slot {
+        std::atomic<size_t> sequence;
+        LogMessage message;
+    };
+
+    Logger();
+    bool push(const LogMessage& message);
+    bool pop(LogMessage& message);
+    void drain();
+    void write(const LogMessage& message);
+    uint32_t elapsedMs() const;
+
+    std::vector<Slot> slots;
+    alignas(64) std::atomic<size_t> enqueuePos{0};
+    alignas(64) std::atomic<size_t> dequeuePos{0};
+    std::atomic<int> minLevel{static_cast<int>(LogLevel::INFO)};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> written{0};
+    std::atomic<bool> running{true};
+    std::chrono::steady_clock::time_point startTime;
+    std::thread worker;
+};
+
+#define BUMMER_LOG(level, category, message) \
+    do { \
+        static Logger::RateLimit bummerLogRateLimit; \
+        if (Logger::getInstance().shouldLog(level, bummerLogRateLimit)) { \
+            std::ostringstream bummerLogStream; \
+            bummerLogStream << message; \
+            Logger::getInstance().log(level, category, bummerLogStream.str(), bummerLogRateLimit.suppressed.exchange(0)); \
+        } \
+    } while (0)
+
+#if BUMMER_MIN_LOG_LEVEL <= 0
+#define LOG_DEBUG(category, message) BUMMER_LOG(LogLevel::DEBUG, category, message)
+#else
+#define LOG_DEBUG(category, message) do {} while (0)
+#endif
+#define LOG_INFO(category, message) BUMMER_LOG(LogLevel::INFO, category, message)
+#define LOG_WARN(category, message) BUMMER_LOG(LogLevel::WARN, category, message)
+#define LOG_ERROR(category, message) BUMMER_LOG(LogLevel::ERROR, category, message)
+
+#endif //BUMMERENGINE_LOGGER_H
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+
+#include "AnimationLibrary.h"
+#include "AssetPack.h"
+#include "../ECS/EntityManager.h"
+
+const ClipSet* AnimationLibrary::loadClipSet(TextureManager* textureManager, SDL_Renderer* renderer, const std::string& animatorPath) {
+    /**
+     * Get the clip set for an animator file, loading it if this is the first time it is used
+     *
+     * @param textureManager: The texture manager used to load the sprite sheets
+     * @param renderer: The SDL renderer
+     * @param animatorPath: The path to the animator file
+     * @return: The shared clip set
+     * @throws runtime_error if the animator file cannot be opened
+     */
+    auto loaded = clipSetsByPath.find(animatorPath);
+    if (loaded != clipSetsByPath.end()) {
+        // sprite sheets of a set nobody used may have been evicted since, load them again
+        for (AnimationClip* clip : clipsByPath[animatorPath]) {
+            if (textureManager->getTexture(clip->spriteSheetHandle) == nullptr) {
+                clip->spriteSheet = textureManager->loadTexture(renderer, clip->spritePath);
+            }
+        }
+        return loaded->second;
+    }
+
+    ClipSet clipSet = {};
+    storeClips(animatorPath, parseClips(textureManager, renderer, animatorPath), clipSet);
+    clipSets.push_back(clipSet);
+    ClipSet* shared = &clipSets.back();
+    clipSetsByPath[animatorPath] = shared;
+    return shared;
+}
+
+const ClipSet* AnimationLibrary::reloadClipSet(TextureManager* textureManager, SDL_Renderer* renderer, const std::string& animatorPath) {
+    /**
+     * Parse an animator file again after it changed and rebuild its clip set in place,
+     * so every Animator pointing at the set plays the new clips
+     * Clips may now use other sprite sheets, callers holding references move them to the new handles
+     *
+     * @param textureManager: The texture manager used to load the sprite sheets
+     * @param renderer: The SDL renderer
+     * @param animatorPath: The path to the animator file
+     * @return: The rebuilt clip set, nullptr if the file was never loaded
+     * @throws runtime_error or a json exception if the file cannot be read, the set is left unchanged then
+     */
+    auto loaded = clipSetsByPath.find(animatorPath);
+    if (loaded == clipSetsByPath.end()) {
+        return nullptr;
+    }
+    std::vector<std::pair<playerState, AnimationClip>> parsed = parseClips(textureManager, renderer, animatorPath);
+    storeClips(animatorPath, std::move(parsed), *loaded->second);
+    return loaded->second;
+}
+
+const ClipSet* AnimationLibrary::findClipSet(const std::string& animatorPath) const {
+    /**
+     * The clip set of an animator file, nullptr if it is not loaded
+     */
+    auto loaded = clipSetsByPath.find(animatorPath);
+    return loaded != clipSetsByPath.end() ? loaded->second : nullptr;
+}
+
+void AnimationLibrary::refreshTextures(const TextureManager* textureManager) {
+    /**
+     * Point every clip at the texture now behind its sprite sheet handle, after a texture was replaced
+     *
+     * @param textureManager: The texture manager the sprite sheets were loaded with
+     */
+    for (auto& [path, pathClips] : clipsByPath) {
+        for (AnimationClip* clip : pathClips) {
+            SDL_Texture* texture = textureManager->getTexture(clip->spriteSheetHandle);
+            if (texture != nullptr) {
+                clip->spriteSheet = texture;
+            }
+        }
+    }
+}
+
+std::vector<std::pair<playerState, AnimationClip>> AnimationLibrary::parseClips(TextureManager* textureManager, SDL_Renderer* renderer, const std::string& animatorPath) {
+    /**
+     * Read the clips of an animator file, loading their sprite sheets
+     *
+     * @param textureManager: The texture manager used to load the sprite sheets
+     * @param renderer: The SDL renderer
+     * @param animatorPath: The path to the animator file
+     * @return: Each clip with the state it plays in
+     * @throws runtime_error if the animator file cannot be opened
+     */
+    std::string contents;
+    if (!readAsset(animatorPath, contents)) {
+        throw std::runtime_error("Could not open animator file: " + animatorPath);
+    }
+    nlohmann::ordered_json animatorJson = nlohmann::ordered_json::parse(contents);
+
+    std::vector<std::pair<playerState, AnimationClip>> parsed;
+    for (auto& [animation, animationClips] : animatorJson["Animations"].items()) {
+        playerState state = EntityManager::playerStatesMap[animation];
+        TextureRegion region = textureManager->loadRegion(renderer, animationClips["spriteSheetPath"]);
+        std::vector<SDL_Rect> frames;
+        int framesPerImage = animationClips["framesPerImage"];
+        int startImage = animationClips["startImage"];
+        int imageCount = animationClips["imageCount"];
+        int imageWidth = animationClips["imageWidth"];
+        int imageHeight = animationClips["imageHeight"];
+        int imageY = animationClips["imageY"];
+        std::string spritePath = animationClips["spriteSheetPath"];
+
+        for (int i = 0; i < imageCount; i++) {
+            SDL_Rect frame = {region.rect.x + startImage * imageWidth, region.rect.y + imageY, imageWidth, imageHeight};
+            frames.push_back(frame);
+            startImage++;
+        }
+        parsed.emplace_back(state, AnimationClip(region.texture, frames, framesPerImage, true, spritePath, region.handle));
+    }
+    return parsed;
+}
+
+void AnimationLibrary::storeClips(const std::string& animatorPath, std::vector<std::pair<playerState, AnimationClip>> parsed, ClipSet& clipSet) {
+    /**
+     * Fill a clip set, reusing the clips the file had before so a reload does not grow the library
+     *
+     * @param animatorPath: The path to the animator file
+     * @param parsed: The clips from parseClips()
+     * @param clipSet: The set to fill, states without a clip are cleared
+     */
+    std::vector<AnimationClip*>& pathClips = clipsByPath[animatorPath];
+    std::fill(std::begin(clipSet.clips), std::end(clipSet.clips), nullptr);
+    size_t used = 0;
+    for (auto& [state, clip] : parsed) {
+        if (used < pathClips.size()) {
+            *pathClips[used] = std::move(clip);
+        } else {
+            clips.push_back(std::move(clip));
+            pathClips.push_back(&clips.back());
+        }
+        clipSet.clips[static_cast<int>(state)] = pathClips[used];
+        used++;
+    }
+    // clips the file no longer has stay in the deque until clear(), nothing points at them anymore
+    pathClips.resize(used);
+}
+
+void AnimationLibrary::clear() {
+    /**
+     * Drop every loaded clip. Any Animator still pointing at a clip set is left dangling,
+     * so only call this once the entities using them are gone.
+     */
+    clipSetsByPath.clear();
+    clipsByPath.clear();
+    clipSets.clear();
+    clips.clear();
+}
@@ -0,0 +1,40 @@
+#pragma once
+#ifndef BUMMERENGINE_ANIMATIONLIBRARY_H
+#define BUMMERENGINE_ANIMATIONLIBRARY_H
+
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+#include "TextureManager.h"
+#include "../ECS/Components.h"
+
+class AnimationLibrary {
+    /**
+     * Loads each animator file once into immutable clips shared by every Animator that uses it
+     * Clips and clip sets are stored in deques so the pointers handed out stay valid as more files are loaded
+     * Clips do not hold texture references themselves, a cached set whose sheets were evicted is reloaded in place
+     * A changed animator file is rebuilt into the same ClipSet by reloadClipSet(), so Animators pick it up as they are
+     */
+public:
+    const ClipSet* loadClipSet(TextureManager* textureManager, SDL_Renderer* renderer, const std::string& animatorPath);
+    const ClipSet* reloadClipSet(TextureManager* textureManager, SDL_Renderer* renderer, const std::string& animatorPath);
+    const ClipSet* findClipSet(const std::string& animatorPath) const;
+    void refreshTextures(const TextureManager* textureManager);
+    void clear();
+
+private:
+    std::vector<std::pair<playerState, AnimationClip>> parseClips(TextureManager* textureManager, SDL_Renderer* renderer, const std::string& animatorPath);
+    void storeClips(const std::string& animatorPath, std::vector<std::pair<playerState, AnimationClip>> parsed, ClipSet& clipSet);
+
+    std::deque<AnimationClip> clips;
+    std::deque<ClipSet> clipSets;
+    std::unordered_map<std::string, ClipSet*> clipSetsByPath;
+    std::unordered_map<std::string, std::vector<AnimationClip*>> clipsByPath;
+};
+
+#endif //BUMMERENGINE_ANIMATIONLIBRARY_H
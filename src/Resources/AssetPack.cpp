@@ -0,0 +1,486 @@
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <zlib.h>
+
+#include "AssetPack.h"
+#include "../Logger.h"
+
+namespace {
+    // files read ahead of time by cacheAsset(), consulted before the pack and the disk
+    std::mutex cacheMutex;
+    std::unordered_map<std::string, std::string> cachedAssets;
+
+    constexpr char MAGIC[4] = {'B', 'P', 'A', 'K'};
+    constexpr size_t HEADER_SIZE = 32;
+    constexpr size_t INDEX_ENTRY_SIZE = 32;  // before the path bytes
+    constexpr uint64_t MAX_INFLATE_RATIO = 1032;  // deflate never expands data further than this
+
+    // the pack is little endian like every platform we build for, fields are copied as they are
+    template <typename T>
+    T readField(const Uint8* bytes) {
+        T value;
+        std::memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    void writeField(std::ofstream& out, T value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    // An SDL_RWops over bytes it owns, for entries that had to be inflated
+    struct OwnedBytes {
+        std::vector<Uint8> bytes;
+        Sint64 position = 0;
+    };
+
+    OwnedBytes* ownedBytesOf(SDL_RWops* rw) {
+        return static_cast<OwnedBytes*>(rw->hidden.unknown.data1);
+    }
+
+    Sint64 SDLCALL ownedSize(SDL_RWops* rw) {
+        return static_cast<Sint64>(ownedBytesOf(rw)->bytes.size());
+    }
+
+    Sint64 SDLCALL ownedSeek(SDL_RWops* rw, Sint64 offset, int whence) {
+        OwnedBytes* owned = ownedBytesOf(rw);
+        Sint64 base = whence == RW_SEEK_SET ? 0 : whence == RW_SEEK_CUR ? owned->position : ownedSize(rw);
+        owned->position = std::clamp<Sint64>(base + offset, 0, ownedSize(rw));
+        return owned->position;
+    }
+
+    size_t SDLCALL ownedRead(SDL_RWops* rw, void* destination, size_t size, size_t count) {
+        OwnedBytes* owned = ownedBytesOf(rw);
+        if (size == 0) {
+            return 0;
+        }
+        size_t available = static_cast<size_t>(ownedSize(rw) - owned->position) / size;
+        count = std::min(count, available);
+        std::memcpy(destination, owned->bytes.data() + owned->position, count * size);
+        owned->position += static_cast<Sint64>(count * size);
+        return count;
+    }
+
+    size_t SDLCALL ownedWrite(SDL_RWops*, const void*, size_t, size_t) {
+        SDL_SetError("Asset pack entries are read only");
+        return 0;
+    }
+
+    int SDLCALL ownedClose(SDL_RWops* rw) {
+        delete ownedBytesOf(rw);
+        SDL_FreeRW(rw);
+        return 0;
+    }
+
+    SDL_RWops* rwFromOwnedBytes(std::vector<Uint8>&& bytes) {
+        SDL_RWops* rw = SDL_AllocRW();
+        if (rw == nullptr) {
+            return nullptr;
+        }
+        rw->size = ownedSize;
+        rw->seek = ownedSeek;
+        rw->read = ownedRead;
+        rw->write = ownedWrite;
+        rw->close = ownedClose;
+        rw->type = SDL_RWOPS_UNKNOWN;
+        rw->hidden.unknown.data1 = new OwnedBytes{std::move(bytes), 0};
+        return rw;
+    }
+}
+
+AssetPack::~AssetPack() {
+    unmount();
+}
+
+bool AssetPack::mount(const std::string& packPath) {
+    /**
+     * Map a pack into memory and read its index, any pack mounted before is unmounted
+     *
+     * @param packPath: The pack file
+     * @return: false if the file is missing or not a valid pack
+     */
+    unmount();
+#ifdef _WIN32
+    std::ifstream file(packPath, std::ios::binary);
+    if (!file) {
+        LOG_WARN("assets", "Asset pack " << packPath << " could not be opened");
+        return false;
+    }
+    fileBytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data = fileBytes.data();
+    size = fileBytes.size();
+#else
+    int descriptor = ::open(packPath.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        LOG_WARN("assets", "Asset pack " << packPath << " could not be opened");
+        return false;
+    }
+    struct stat status {};
+    void* mapped = MAP_FAILED;
+    if (fstat(descriptor, &status) == 0 && status.st_size > 0) {
+        mapped = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+    }
+    // the mapping stays valid once the descriptor is closed
+    ::close(descriptor);
+    if (mapped == MAP_FAILED) {
+        LOG_WARN("assets", "Asset pack " << packPath << " could not be mapped");
+        return false;
+    }
+    data = static_cast<const Uint8*>(mapped);
+    size = static_cast<size_t>(status.st_size);
+#endif
+
+    uint64_t indexOffset = 0;
+    uint64_t indexSize = 0;
+    uint32_t entryCount = 0;
+    bool valid = size >= HEADER_SIZE && std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0 && readField<uint32_t>(data + 4) == VERSION;
+    if (valid) {
+        entryCount = readField<uint32_t>(data + 8);
+        indexOffset = readField<uint64_t>(data + 16);
+        indexSize = readField<uint64_t>(data + 24);
+        valid = indexOffset <= size && indexSize <= size - indexOffset;
+        // every entry takes at least its fixed fields, a count the index cannot hold is damage, not a reserve size
+        valid = valid && entryCount <= indexSize / INDEX_ENTRY_SIZE;
+    }
+
+    const Uint8* cursor = data + indexOffset;
+    const Uint8* indexEnd = cursor + indexSize;
+    entries.reserve(valid ? entryCount : 0);
+    for (uint32_t i = 0; valid && i < entryCount; i++) {
+        if (static_cast<size_t>(indexEnd - cursor) < INDEX_ENTRY_SIZE) {
+            valid = false;
+            break;
+        }
+        Entry entry;
+        entry.offset = readField<uint64_t>(cursor);
+        entry.storedSize = readField<uint64_t>(cursor + 8);
+        entry.size = readField<uint64_t>(cursor + 16);
+        entry.flags = readField<uint32_t>(cursor + 24);
+        uint32_t pathLength = readField<uint32_t>(cursor + 28);
+        cursor += INDEX_ENTRY_SIZE;
+        if (static_cast<size_t>(indexEnd - cursor) < pathLength || entry.offset > size || entry.storedSize > size - entry.offset) {
+            valid = false;
+            break;
+        }
+        // open() and read() trust size: a stored file is exactly its bytes in the pack, and an inflated one is
+        // capped before inflate() allocates it
+        bool compressed = (entry.flags & COMPRESSED) != 0;
+        if (compressed ? entry.size > entry.storedSize * MAX_INFLATE_RATIO : entry.size != entry.storedSize) {
+            valid = false;
+            break;
+        }
+        entry.path.assign(reinterpret_cast<const char*>(cursor), pathLength);
+        cursor += pathLength;
+        valid = entries.empty() || entries.back().path < entry.path;
+        entries.push_back(std::move(entry));
+    }
+    if (!valid) {
+        LOG_ERROR("assets", "Asset pack " << packPath << " is damaged or from another version");
+        unmount();
+        return false;
+    }
+    LOG_INFO("assets", "Mounted " << packPath << " with " << entries.size() << " files");
+    return true;
+}
+
+void AssetPack::unmount() {
+    /**
+     * Release the pack, RWops opened on entries that were not compressed must be closed before this
+     */
+#ifndef _WIN32
+    if (data != nullptr && fileBytes.empty()) {
+        munmap(const_cast<Uint8*>(data), size);
+    }
+#endif
+    data = nullptr;
+    size = 0;
+    fileBytes.clear();
+    entries.clear();
+}
+
+bool AssetPack::isMounted() const {
+    return data != nullptr;
+}
+
+const AssetPack::Entry* AssetPack::find(const std::string& path) const {
+    /**
+     * Look a file up in the index
+     *
+     * @param path: The path the file was packed under
+     * @return: The entry, or nullptr if the pack does not have it
+     */
+    auto found = std::lower_bound(entries.begin(), entries.end(), path, [](const Entry& entry, const std::string& key) {
+        return entry.path < key;
+    });
+    if (found == entries.end() || found->path != path) {
+        return nullptr;
+    }
+    return &*found;
+}
+
+SDL_RWops* AssetPack::open(const std::string& path) const {
+    /**
+     * Open a packed file for SDL loaders like IMG_Load_RW and Mix_LoadWAV_RW
+     * Uncompressed files are read straight from the mapped pack, compressed ones are inflated into memory the
+     * RWops owns
+     *
+     * @param path: The path the file was packed under
+     * @return: The RWops, closed by the caller, or nullptr if the pack does not have the file
+     */
+    const Entry* entry = find(path);
+    if (entry == nullptr) {
+        return nullptr;
+    }
+    if ((entry->flags & COMPRESSED) == 0) {
+        return SDL_RWFromConstMem(data + entry->offset, static_cast<int>(entry->size));
+    }
+    std::vector<Uint8> bytes;
+    if (!inflate(*entry, bytes)) {
+        return nullptr;
+    }
+    return rwFromOwnedBytes(std::move(bytes));
+}
+
+bool AssetPack::read(const std::string& path, std::string& contents) const {
+    /**
+     * Read a whole packed file, for text like templates
+     *
+     * @param path: The path the file was packed under
+     * @param contents: Set to the file's bytes
+     * @return: false if the pack does not have the file
+     */
+    const Entry* entry = find(path);
+    if (entry == nullptr) {
+        return false;
+    }
+    if ((entry->flags & COMPRESSED) == 0) {
+        contents.assign(reinterpret_cast<const char*>(data + entry->offset), entry->size);
+        return true;
+    }
+    std::vector<Uint8> bytes;
+    if (!inflate(*entry, bytes)) {
+        return false;
+    }
+    contents.assign(bytes.begin(), bytes.end());
+    return true;
+}
+
+std::vector<std::string> AssetPack::list(const std::string& directory, const std::string& extension) const {
+    /**
+     * The packed files under a directory with an extension, in path order
+     *
+     * @param directory: Like "assets/sprites"
+     * @param extension: Like ".png"
+     */
+    std::string prefix = directory.empty() || directory.back() == '/' ? directory : directory + "/";
+    std::vector<std::string> paths;
+    auto entry = std::lower_bound(entries.begin(), entries.end(), prefix, [](const Entry& entry, const std::string& key) {
+        return entry.path < key;
+    });
+    for (; entry != entries.end() && entry->path.compare(0, prefix.size(), prefix) == 0; ++entry) {
+        const std::string& path = entry->path;
+        if (path.size() >= extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0) {
+            paths.push_back(path);
+        }
+    }
+    return paths;
+}
+
+size_t AssetPack::getEntryCount() const {
+    return entries.size();
+}
+
+bool AssetPack::build(const std::string& packPath, std::vector<SourceFile> files) {
+    /**
+     * Write a pack
+     * Files read with open() straight from the mapped pack, like streamed music, should not be compressed,
+     * opening a compressed file inflates all of it
+     *
+     * @param packPath: The pack file to write
+     * @param files: The files to pack, in any order
+     * @return: false if a file could not be read or the pack could not be written
+     */
+    std::sort(files.begin(), files.end(), [](const SourceFile& a, const SourceFile& b) {
+        return a.path < b.path;
+    });
+    std::ofstream out(packPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        LOG_ERROR("assets", "Could not write asset pack " << packPath);
+        return false;
+    }
+    out.write(std::string(HEADER_SIZE, '\0').data(), HEADER_SIZE);
+
+    std::vector<Entry> written;
+    for (size_t i = 0; i < files.size(); i++) {
+        const auto& [path, sourcePath, compress] = files[i];
+        if (i > 0 && files[i - 1].path == path) {
+            LOG_ERROR("assets", "Asset pack " << packPath << " lists " << path << " twice");
+            return false;
+        }
+        std::ifstream source(sourcePath, std::ios::binary);
+        if (!source) {
+            LOG_ERROR("assets", "Could not read " << sourcePath << " for asset pack " << packPath);
+            return false;
+        }
+        std::vector<Uint8> bytes((std::istreambuf_iterator<char>(source)), std::istreambuf_iterator<char>());
+        Entry entry = {path, 0, bytes.size(), bytes.size(), 0};
+
+        if (compress && !bytes.empty()) {
+            uLongf compressedSize = compressBound(static_cast<uLong>(bytes.size()));
+            std::vector<Uint8> compressed(compressedSize);
+            if (compress2(compressed.data(), &compressedSize, bytes.data(), static_cast<uLong>(bytes.size()), Z_BEST_COMPRESSION) == Z_OK &&
+                compressedSize <= bytes.size() - bytes.size() / 8) {
+                compressed.resize(compressedSize);
+                bytes = std::move(compressed);
+                entry.storedSize = bytes.size();
+                entry.flags |= COMPRESSED;
+            }
+        }
+
+        uint64_t position = static_cast<uint64_t>(out.tellp());
+        uint64_t padding = (ALIGNMENT - position % ALIGNMENT) % ALIGNMENT;
+        out.write(std::string(padding, '\0').data(), static_cast<std::streamsize>(padding));
+        entry.offset = position + padding;
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        written.push_back(std::move(entry));
+    }
+
+    uint64_t indexOffset = static_cast<uint64_t>(out.tellp());
+    for (const Entry& entry : written) {
+        writeField<uint64_t>(out, entry.offset);
+        writeField<uint64_t>(out, entry.storedSize);
+        writeField<uint64_t>(out, entry.size);
+        writeField<uint32_t>(out, entry.flags);
+        writeField<uint32_t>(out, static_cast<uint32_t>(entry.path.size()));
+        out.write(entry.path.data(), static_cast<std::streamsize>(entry.path.size()));
+    }
+    uint64_t indexSize = static_cast<uint64_t>(out.tellp()) - indexOffset;
+
+    out.seekp(0);
+    out.write(MAGIC, sizeof(MAGIC));
+    writeField<uint32_t>(out, VERSION);
+    writeField<uint32_t>(out, static_cast<uint32_t>(written.size()));
+    writeField<uint32_t>(out, 0);
+    writeField<uint64_t>(out, indexOffset);
+    writeField<uint64_t>(out, indexSize);
+    if (!out.flush()) {
+        LOG_ERROR("assets", "Could not write asset pack " << packPath);
+        return false;
+    }
+    return true;
+}
+
+AssetPack& AssetPack::getMounted() {
+    /**
+     * The pack the game's loaders read from, empty until mounted
+     */
+    static AssetPack instance;
+    return instance;
+}
+
+bool AssetPack::inflate(const Entry& entry, std::vector<Uint8>& bytes) const {
+    bytes.resize(entry.size);
+    uLongf inflatedSize = static_cast<uLongf>(entry.size);
+    if (uncompress(bytes.data(), &inflatedSize, data + entry.offset, static_cast<uLong>(entry.storedSize)) != Z_OK ||
+        inflatedSize != entry.size) {
+        LOG_ERROR("assets", "Asset pack entry " << entry.path << " could not be inflated");
+        return false;
+    }
+    return true;
+}
+
+SDL_RWops* openAsset(const std::string& path) {
+    /**
+     * Open an asset from the mounted pack, or from disk if the pack does not have it
+     *
+     * @param path: The asset, relative to the working directory
+     * @return: The RWops, closed by the caller, or nullptr with the SDL error set
+     */
+    SDL_RWops* rw = AssetPack::getMounted().open(path);
+    if (rw != nullptr) {
+        return rw;
+    }
+    return SDL_RWFromFile(path.c_str(), "rb");
+}
+
+bool readAsset(const std::string& path, std::string& contents) {
+    /**
+     * Read a whole asset from the cache, the mounted pack, or from disk if neither has it
+     *
+     * @param path: The asset, relative to the working directory
+     * @param contents: Set to the file's bytes
+     * @return: false if it could not be found anywhere
+     */
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto cached = cachedAssets.find(path);
+        if (cached != cachedAssets.end()) {
+            contents = cached->second;
+            return true;
+        }
+    }
+    if (AssetPack::getMounted().read(path, contents)) {
+        return true;
+    }
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+std::vector<std::string> listAssets(const std::string& directory, const std::string& extension) {
+    /**
+     * Recursively list the assets under a directory with an extension, in the pack or on disk, in a stable order
+     *
+     * @param directory: Like "assets/sprites"
+     * @param extension: Like ".png"
+     */
+    std::vector<std::string> paths = AssetPack::getMounted().list(directory, extension);
+    std::error_code error;
+    if (std::filesystem::is_directory(directory, error)) {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(directory, error)) {
+            if (entry.is_regular_file() && entry.path().extension() == extension) {
+                paths.push_back(entry.path().generic_string());
+            }
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+    return paths;
+}
+
+void cacheAsset(const std::string& path, std::string contents) {
+    /**
+     * Keep a file's bytes in memory so readAsset() returns them without touching the pack or the disk
+     * Safe to call from any thread
+     *
+     * @param path: The asset, as it is loaded
+     * @param contents: The file's bytes
+     */
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    cachedAssets[path] = std::move(contents);
+}
+
+void clearAssetCache() {
+    /**
+     * Drop every cached file, readAsset() reads from the pack or the disk again
+     */
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    cachedAssets.clear();
+}
@@ -0,0 +1,75 @@
+#pragma once
+#ifndef BUMMERENGINE_ASSETPACK_H
+#define BUMMERENGINE_ASSETPACK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+class AssetPack {
+    /**
+     * A single archive holding many asset files, memory mapped and read without opening the files one by one
+     *
+     * Layout, little endian:
+     *   header  "BPAK", u32 version, u32 entry count, u32 reserved, u64 index offset, u64 index size
+     *   data    one blob per entry, each starting on an ALIGNMENT boundary, zlib compressed if flagged
+     *   index   per entry: u64 offset, u64 stored size, u64 size, u32 flags, u32 path length, path bytes
+     * Index entries are sorted by path, paths are the ones the game loads them by, like "assets/sprites/a.png".
+     */
+public:
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint64_t ALIGNMENT = 16;
+    static constexpr uint32_t COMPRESSED = 1;
+
+    struct SourceFile {
+        std::string path;        // what the game loads it by
+        std::string sourcePath;  // where to read it from when building
+        bool compress;           // kept compressed only if it shrinks by at least an eighth
+    };
+
+    struct Entry {
+        std::string path;
+        uint64_t offset;
+        uint64_t storedSize;
+        uint64_t size;
+        uint32_t flags;
+    };
+
+    AssetPack() = default;
+    ~AssetPack();
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    bool mount(const std::string& packPath);
+    void unmount();
+    bool isMounted() const;
+    const Entry* find(const std::string& path) const;
+    SDL_RWops* open(const std::string& path) const;
+    bool read(const std::string& path, std::string& contents) const;
+    std::vector<std::string> list(const std::string& directory, const std::string& extension) const;
+    size_t getEntryCount() const;
+
+    static bool build(const std::string& packPath, std::vector<SourceFile> files);
+    static AssetPack& getMounted();
+
+private:
+    bool inflate(const Entry& entry, std::vector<Uint8>& bytes) const;
+
+    const Uint8* data = nullptr;
+    size_t size = 0;
+    std::vector<Uint8> fileBytes;  // where mmap is unavailable the pack is read into memory instead
+    std::vector<Entry> entries;    // sorted by path
+};
+
+// Loaders go through these, they read from the mounted pack and fall back to loose files
+// readAsset() serves files cached ahead of a scene change first
+SDL_RWops* openAsset(const std::string& path);
+bool readAsset(const std::string& path, std::string& contents);
+std::vector<std::string> listAssets(const std::string& directory, const std::string& extension);
+void cacheAsset(const std::string& path, std::string contents);
+void clearAssetCache();
+
+#endif //BUMMERENGINE_ASSETPACK_H
@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "FileWatcher.h"
+#include "../Logger.h"
+
+namespace {
+    bool isScratchFile(const std::string& name) {
+        // editor swap, backup and lock files, never loaded by the game
+        return name.empty() || name[0] == '.' || name[0] == '#' || name.back() == '~' ||
+               (name.size() > 4 && name.compare(name.size() - 4, 4, ".swp") == 0);
+    }
+}
+
+FileWatcher::FileWatcher() {
+#ifdef __linux__
+    descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (descriptor < 0) {
+        LOG_ERROR("reload", "File watcher: inotify unavailable: " << std::strerror(errno));
+    }
+#endif
+}
+
+FileWatcher::~FileWatcher() {
+#ifdef __linux__
+    if (descriptor >= 0) {
+        close(descriptor);
+    }
+#endif
+}
+
+bool FileWatcher::watch(const std::string& directory) {
+    /**
+     * Watch a directory and everything below it
+     *
+     * @param directory: The directory, changed files are reported with it as their prefix
+     * @return: false if the directory does not exist or watching is not supported
+     */
+    if (descriptor < 0) {
+        LOG_WARN("reload", "File watcher: cannot watch " << directory << ", file watching is not supported here");
+        return false;
+    }
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error)) {
+        LOG_WARN("reload", "File watcher: " << directory << " is not a directory");
+        return false;
+    }
+    if (!watchDirectory(directory)) {
+        return false;
+    }
+    for (std::filesystem::recursive_directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        if (it->is_directory(error)) {
+            watchDirectory(it->path().generic_string());
+        }
+    }
+    return true;
+}
+
+std::vector<std::string> FileWatcher::poll() {
+    /**
+     * Collect the files written or moved into place since the last call, without blocking
+     * A file saved several times in between is reported once
+     *
+     * @return: The paths of the changed files, each prefixed with the watched directory it is under
+     */
+    std::vector<std::string> changed;
+#ifdef __linux__
+    if (descriptor < 0) {
+        return changed;
+    }
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+        ssize_t length = read(descriptor, buffer, sizeof(buffer));
+        if (length <= 0) {
+            // EAGAIN once the queue is drained
+            break;
+        }
+        for (char* cursor = buffer; cursor < buffer + length;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(cursor);
+            cursor += sizeof(inotify_event) + event->len;
+
+            auto directory = directoriesByWatch.find(event->wd);
+            if (directory == directoriesByWatch.end() || event->len == 0) {
+                continue;
+            }
+            std::string name = event->name;
+            std::string path = directory->second + "/" + name;
+            if (event->mask & IN_ISDIR) {
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    watch(path);
+                }
+                continue;
+            }
+            // a created file may still be half written, it is reported once closed
+            bool written = event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO);
+            if (written && !isScratchFile(name) && std::find(changed.begin(), changed.end(), path) == changed.end()) {
+                changed.push_back(path);
+            }
+        }
+    }
+#endif
+    return changed;
+}
+
+bool FileWatcher::isWatching() const {
+    return !directoriesByWatch.empty();
+}
+
+bool FileWatcher::watchDirectory(const std::string& directory) {
+#ifdef __linux__
+    int watchId = inotify_add_watch(descriptor, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR);
+    if (watchId < 0) {
+        LOG_ERROR("reload", "File watcher: cannot watch " << directory << ": " << std::strerror(errno));
+        return false;
+    }
+    directoriesByWatch[watchId] = directory;
+    return true;
+#else
+    return false;
+#endif
+}
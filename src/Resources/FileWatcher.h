@@ -0,0 +1,34 @@
+#pragma once
+#ifndef BUMMERENGINE_FILEWATCHER_H
+#define BUMMERENGINE_FILEWATCHER_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class FileWatcher {
+    /**
+     * Reports files written under a set of directories, through inotify
+     *
+     * Directories are watched rather than files, editors often save by writing a new file and renaming it over
+     * the old one, which would end a watch on the file itself. Subdirectories are watched too, including ones
+     * created later. Only available on Linux, elsewhere watch() fails and poll() never reports anything.
+     */
+public:
+    FileWatcher();
+    ~FileWatcher();
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    bool watch(const std::string& directory);
+    std::vector<std::string> poll();
+    bool isWatching() const;
+
+private:
+    bool watchDirectory(const std::string& directory);
+
+    int descriptor = -1;
+    std::unordered_map<int, std::string> directoriesByWatch;
+};
+
+#endif //BUMMERENGINE_FILEWATCHER_H
@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <utility>
+
+#include <SDL2/SDL_image.h>
+
+#include "ImageDecoder.h"
+#include "AssetPack.h"
+#include "../Logger.h"
+
+ImageDecoder::ImageDecoder(int workerCount, DecodeFunction decode) : decode(std::move(decode)), nextSerial(0), inFlight(0), stopping(false) {
+    /**
+     * Constructor for the ImageDecoder, starts the worker threads
+     *
+     * @param workerCount: The number of decode threads, at least one is started
+     * @param decode: Decodes one file, decodeRGBA32 unless replaced in tests
+     */
+    workerCount = std::max(1, workerCount);
+    for (int i = 0; i < workerCount; i++) {
+        workers.emplace_back(&ImageDecoder::workerLoop, this);
+    }
+}
+
+ImageDecoder::~ImageDecoder() {
+    /**
+     * Stop the workers once the images they are decoding are done, and free anything not taken
+     */
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        jobs.clear();
+    }
+    jobAvailable.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (DecodedImage& image : decoded) {
+        SDL_FreeSurface(image.surface);
+    }
+}
+
+void ImageDecoder::request(const std::string& path, SDL_Texture* target) {
+    /**
+     * Queue an image to be decoded for a texture
+     *
+     * @param path: The image file
+     * @param target: The texture the image will be uploaded to, handed back by takeDecoded()
+     */
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // a newer request for the same texture supersedes one still queued or being decoded
+        uint64_t serial = ++nextSerial;
+        liveRequests[target] = serial;
+        jobs.push_back({path, target, serial, nullptr, 0});
+    }
+    jobAvailable.notify_one();
+}
+
+std::vector<SDL_Surface*> ImageDecoder::decodeAll(const std::vector<std::string>& paths) {
+    /**
+     * Decode images in parallel and wait for all of them
+     *
+     * @param paths: The image files
+     * @return: One surface per path, in order, nullptr where decoding failed. The caller frees them.
+     */
+    Batch batch = {std::vector<SDL_Surface*>(paths.size(), nullptr), paths.size()};
+    if (paths.empty()) {
+        return batch.surfaces;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    for (size_t i = 0; i < paths.size(); i++) {
+        jobs.push_back({paths[i], nullptr, 0, &batch, i});
+    }
+    jobAvailable.notify_all();
+    jobFinished.wait(lock, [&batch] { return batch.remaining == 0; });
+    return std::move(batch.surfaces);
+}
+
+bool ImageDecoder::takeDecoded(DecodedImage& image) {
+    /**
+     * Take the oldest decoded image requested with request(), without waiting
+     *
+     * @param image: Set to the decoded image
+     * @return: false if none is ready
+     */
+    std::lock_guard<std::mutex> lock(mutex);
+    if (decoded.empty()) {
+        return false;
+    }
+    image = std::move(decoded.front());
+    decoded.pop_front();
+    return true;
+}
+
+void ImageDecoder::discard(SDL_Texture* target) {
+    /**
+     * Forget the pending image of a texture that is about to be destroyed
+     *
+     * @param target: The texture
+     */
+    std::lock_guard<std::mutex> lock(mutex);
+    jobs.erase(std::remove_if(jobs.begin(), jobs.end(), [target](const Job& job) {
+        return job.batch == nullptr && job.target == target;
+    }), jobs.end());
+    for (auto image = decoded.begin(); image != decoded.end();) {
+        if (image->target == target) {
+            SDL_FreeSurface(image->surface);
+            image = decoded.erase(image);
+        } else {
+            ++image;
+        }
+    }
+    // a worker may be decoding it right now, the result is dropped when it lands without a live request
+    liveRequests.erase(target);
+}
+
+void ImageDecoder::waitIdle() {
+    /**
+     * Wait until every queued image has been decoded
+     */
+    std::unique_lock<std::mutex> lock(mutex);
+    jobFinished.wait(lock, [this] { return jobs.empty() && inFlight == 0; });
+}
+
+size_t ImageDecoder::getPendingCount() {
+    /**
+     * Images requested but not taken yet, whether queued, being decoded or waiting for upload
+     */
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t pending = decoded.size() + inFlight;
+    for (const Job& job : jobs) {
+        if (job.batch == nullptr) {
+            pending++;
+        }
+    }
+    return pending;
+}
+
+int ImageDecoder::getWorkerCount() const {
+    return static_cast<int>(workers.size());
+}
+
+void ImageDecoder::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        jobAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+        if (jobs.empty()) {
+            return;
+        }
+        Job job = std::move(jobs.front());
+        jobs.pop_front();
+        inFlight++;
+
+        lock.unlock();
+        SDL_Surface* surface = decode(job.path);
+        lock.lock();
+
+        inFlight--;
+        if (job.batch != nullptr) {
+            job.batch->surfaces[job.index] = surface;
+            job.batch->remaining--;
+        } else {
+            // the texture may have been discarded, or destroyed and its address reused by a newer request
+            auto live = liveRequests.find(job.target);
+            if (live == liveRequests.end() || live->second != job.serial || stopping) {
+                SDL_FreeSurface(surface);
+            } else {
+                liveRequests.erase(live);
+                decoded.push_back({job.path, job.target, surface});
+            }
+        }
+        jobFinished.notify_all();
+    }
+}
+
+SDL_Surface* ImageDecoder::decodeRGBA32(const std::string& path) {
+    /**
+     * Load an image and convert it to RGBA32, the layout textures are created with
+     * Safe to call from any thread, it does not touch the renderer
+     *
+     * @param path: The image file
+     * @return: The surface, or nullptr on failure
+     */
+    SDL_Surface* loaded = IMG_Load_RW(openAsset(path), 1);
+    if (loaded == nullptr) {
+        // SDL errors are per thread, read it here
+        LOG_ERROR("texture", "Failed to decode " << path << "! SDL_image Error: " << IMG_GetError());
+        return nullptr;
+    }
+    if (loaded->format->format == SDL_PIXELFORMAT_RGBA32) {
+        return loaded;
+    }
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(loaded);
+    if (converted == nullptr) {
+        LOG_ERROR("texture", "Failed to convert " << path << "! SDL Error: " << SDL_GetError());
+    }
+    return converted;
+}
+
+int ImageDecoder::defaultWorkerCount() {
+    /**
+     * One thread per core, leaving one for the simulation and one for the render thread
+     */
+    int cores = static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(1, cores - 2);
+}
@@ -0,0 +1,79 @@
+#pragma once
+#ifndef BUMMERENGINE_IMAGEDECODER_H
+#define BUMMERENGINE_IMAGEDECODER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+class ImageDecoder {
+    /**
+     * Decodes image files into SDL_Surfaces on a pool of worker threads
+     *
+     * Decoding needs no renderer, so it runs off the render thread and several images are decoded at once.
+     * request() queues an image meant for an existing texture and returns immediately, the result is collected
+     * with takeDecoded() by whoever uploads it. decodeAll() decodes a list of images in parallel and waits for them.
+     */
+public:
+    using DecodeFunction = std::function<SDL_Surface*(const std::string&)>;
+
+    struct DecodedImage {
+        std::string path;
+        SDL_Texture* target;
+        SDL_Surface* surface;  // nullptr if decoding failed, owned by the caller once taken
+    };
+
+    explicit ImageDecoder(int workerCount, DecodeFunction decode = decodeRGBA32);
+    ~ImageDecoder();
+    ImageDecoder(const ImageDecoder&) = delete;
+    ImageDecoder& operator=(const ImageDecoder&) = delete;
+
+    void request(const std::string& path, SDL_Texture* target);
+    std::vector<SDL_Surface*> decodeAll(const std::vector<std::string>& paths);
+    bool takeDecoded(DecodedImage& image);
+    void discard(SDL_Texture* target);
+    void waitIdle();
+    size_t getPendingCount();
+    int getWorkerCount() const;
+
+    static SDL_Surface* decodeRGBA32(const std::string& path);
+    static int defaultWorkerCount();
+
+private:
+    struct Batch {
+        std::vector<SDL_Surface*> surfaces;
+        size_t remaining;
+    };
+    struct Job {
+        std::string path;
+        SDL_Texture* target;  // for request()
+        uint64_t serial;      // tells a request from an older one for a texture at the same address
+        Batch* batch;         // for decodeAll()
+        size_t index;
+    };
+
+    void workerLoop();
+
+    DecodeFunction decode;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable jobAvailable;
+    std::condition_variable jobFinished;
+    std::deque<Job> jobs;
+    std::deque<DecodedImage> decoded;
+    std::unordered_map<SDL_Texture*, uint64_t> liveRequests;  // the serial of each target's latest request, until delivered
+    uint64_t nextSerial;
+    size_t inFlight;
+    bool stopping;
+};
+
+#endif //BUMMERENGINE_IMAGEDECODER_H
@@ -5,6 +5,7 @@
 
 #include "../Config.h"
 #include "ResourceUtils.h"
+#include "AssetPack.h"
 
 int initialize_resource(SDL_Window*& window, SDL_Renderer*& renderer, TTF_Font*& font) {
     /**
@@ -25,7 +26,7 @@ int initialize_resource(SDL_Window*& window, SDL_Renderer*& renderer, TTF_Font*&
     }
 
     // Initialize renderer
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_TARGETTEXTURE);
     if (renderer == nullptr) {
         std::cout << "Renderer could not be initialized! \nError: " << SDL_GetError() << std::endl;
         return 3;
@@ -43,7 +44,7 @@ int initialize_resource(SDL_Window*& window, SDL_Renderer*& renderer, TTF_Font*&
         return 5;
     }
 
-    font = TTF_OpenFont(FONT_PATH.c_str(), FONT_SIZE);
+    font = TTF_OpenFontRW(openAsset(FONT_PATH), 1, FONT_SIZE);
     if (font == nullptr) {
         std::cout << "Failed to load font! \nError: " << TTF_GetError() << std::endl;
         return 6;
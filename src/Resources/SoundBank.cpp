@@ -0,0 +1,166 @@
+#include <utility>
+
+#include "SoundBank.h"
+#include "AssetPack.h"
+#include "../Logger.h"
+
+SoundBank::SoundBank(LoadFunction loadChunk) : loadChunk(std::move(loadChunk)) {
+    /**
+     * Constructor for the SoundBank
+     *
+     * @param loadChunk: Decodes one file, loadWAV unless replaced in tests
+     */
+    entries.push_back({"", nullptr});
+}
+
+SoundBank::~SoundBank() {
+    clear();
+}
+
+SoundHandle SoundBank::load(const std::string& path) {
+    /**
+     * Decode a sound the first time it is asked for, afterwards return the same handle
+     *
+     * @param path: The sound file
+     * @return: The handle, or INVALID_SOUND_HANDLE if the file could not be loaded
+     */
+    auto found = handlesByPath.find(path);
+    if (found != handlesByPath.end()) {
+        return found->second;
+    }
+    Mix_Chunk* chunk = loadChunk(path);
+    if (chunk == nullptr) {
+        // remember the failure so a missing file is not looked up again on every play
+        handlesByPath[path] = INVALID_SOUND_HANDLE;
+        return INVALID_SOUND_HANDLE;
+    }
+    SoundHandle handle = static_cast<SoundHandle>(entries.size());
+    entries.push_back({path, chunk});
+    handlesByPath[path] = handle;
+    return handle;
+}
+
+SoundHandle SoundBank::find(const std::string& path) const {
+    /**
+     * The handle of a sound that was already loaded, never decodes anything
+     *
+     * @param path: The sound file
+     * @return: The handle, or INVALID_SOUND_HANDLE if the file was not loaded or failed to load
+     */
+    auto found = handlesByPath.find(path);
+    if (found == handlesByPath.end()) {
+        return INVALID_SOUND_HANDLE;
+    }
+    return found->second;
+}
+
+void SoundBank::preload(const std::vector<std::string>& paths) {
+    /**
+     * Decode a list of sounds up front, like the ones a scene uses
+     *
+     * @param paths: The sound files
+     */
+    for (const std::string& path : paths) {
+        load(path);
+    }
+}
+
+SoundHandle SoundBank::adopt(const std::string& path, Mix_Chunk* chunk) {
+    /**
+     * Take a sound decoded elsewhere, like on a prefetch thread, as if load() had decoded it
+     * The bank owns the chunk from now on, it is freed straight away if the path is already loaded
+     *
+     * @param path: The sound file the chunk was decoded from
+     * @param chunk: The decoded sound, nullptr is ignored
+     * @return: The handle of the path, INVALID_SOUND_HANDLE if it has none and chunk is nullptr
+     */
+    auto found = handlesByPath.find(path);
+    if (found != handlesByPath.end() && found->second != INVALID_SOUND_HANDLE) {
+        if (chunk != nullptr) {
+            Mix_FreeChunk(chunk);
+        }
+        return found->second;
+    }
+    if (chunk == nullptr) {
+        return INVALID_SOUND_HANDLE;
+    }
+    SoundHandle handle = static_cast<SoundHandle>(entries.size());
+    entries.push_back({path, chunk});
+    handlesByPath[path] = handle;
+    return handle;
+}
+
+Mix_Chunk* SoundBank::getChunk(SoundHandle handle) const {
+    /**
+     * The decoded sound of a handle, nullptr for INVALID_SOUND_HANDLE or a handle from another bank
+     */
+    if (handle == INVALID_SOUND_HANDLE || handle >= entries.size()) {
+        return nullptr;
+    }
+    return entries[handle].chunk;
+}
+
+const std::string& SoundBank::getPath(SoundHandle handle) const {
+    /**
+     * The file a handle was loaded from, empty for an invalid handle
+     */
+    if (handle >= entries.size()) {
+        return entries[INVALID_SOUND_HANDLE].path;
+    }
+    return entries[handle].path;
+}
+
+int SoundBank::play(SoundHandle handle, int volume) {
+    /**
+     * Play a sound once on a free channel
+     * The volume is set on the channel rather than the chunk, the chunk is shared by every instance of the sound
+     *
+     * @param handle: The sound
+     * @param volume: 0 to MIX_MAX_VOLUME
+     * @return: The channel, or -1 if the sound is invalid or no channel was free
+     */
+    Mix_Chunk* chunk = getChunk(handle);
+    if (chunk == nullptr) {
+        return -1;
+    }
+    int channel = Mix_PlayChannel(-1, chunk, 0);
+    if (channel < 0) {
+        LOG_WARN("sound", "Sound: " << entries[handle].path << " could not play: " << Mix_GetError());
+        return -1;
+    }
+    Mix_Volume(channel, volume);
+    return channel;
+}
+
+void SoundBank::clear() {
+    /**
+     * Free every decoded sound, channels still playing one are halted by the mixer
+     * Handles handed out before are no longer valid
+     */
+    for (SoundEntry& entry : entries) {
+        if (entry.chunk != nullptr) {
+            Mix_FreeChunk(entry.chunk);
+        }
+    }
+    entries.clear();
+    entries.push_back({"", nullptr});
+    handlesByPath.clear();
+}
+
+size_t SoundBank::getLoadedCount() const {
+    return entries.size() - 1;
+}
+
+Mix_Chunk* SoundBank::loadWAV(const std::string& path) {
+    /**
+     * Load and decode a sound file into the mixer's output format
+     *
+     * @param path: The sound file
+     * @return: The chunk, or nullptr on failure
+     */
+    Mix_Chunk* chunk = Mix_LoadWAV_RW(openAsset(path), 1);
+    if (chunk == nullptr) {
+        LOG_ERROR("sound", "Sound: " << path << " failed to load: " << Mix_GetError());
+    }
+    return chunk;
+}
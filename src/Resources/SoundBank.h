@@ -0,0 +1,56 @@
+#pragma once
+#ifndef BUMMERENGINE_SOUNDBANK_H
+#define BUMMERENGINE_SOUNDBANK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL2/SDL_mixer.h>
+
+// index of a sound in the SoundBank, stable for a path for the lifetime of the bank
+using SoundHandle = uint32_t;
+constexpr SoundHandle INVALID_SOUND_HANDLE = 0;
+
+class SoundBank {
+    /**
+     * Decodes each sound effect once and keeps the Mix_Chunk for as long as the bank lives
+     *
+     * Sounds are loaded ahead of time with load() or preload() and played by handle, so playing one never touches
+     * the disk. A path that failed to load is remembered and not retried.
+     */
+public:
+    using LoadFunction = std::function<Mix_Chunk*(const std::string&)>;
+
+    explicit SoundBank(LoadFunction loadChunk = loadWAV);
+    ~SoundBank();
+    SoundBank(const SoundBank&) = delete;
+    SoundBank& operator=(const SoundBank&) = delete;
+
+    SoundHandle load(const std::string& path);
+    SoundHandle find(const std::string& path) const;
+    void preload(const std::vector<std::string>& paths);
+    SoundHandle adopt(const std::string& path, Mix_Chunk* chunk);
+    Mix_Chunk* getChunk(SoundHandle handle) const;
+    const std::string& getPath(SoundHandle handle) const;
+    int play(SoundHandle handle, int volume);
+    void clear();
+    size_t getLoadedCount() const;
+
+    static Mix_Chunk* loadWAV(const std::string& path);
+
+private:
+    struct SoundEntry {
+        std::string path;
+        Mix_Chunk* chunk;
+    };
+
+    LoadFunction loadChunk;
+    std::vector<SoundEntry> entries;  // indexed by handle, entry 0 is INVALID_SOUND_HANDLE
+    std::unordered_map<std::string, SoundHandle> handlesByPath;  // failed paths map to INVALID_SOUND_HANDLE
+};
+
+#endif //BUMMERENGINE_SOUNDBANK_H
@@ -0,0 +1,74 @@
+#include "TextureAtlas.h"
+
+AtlasPacker::AtlasPacker(int pageWidth, int pageHeight, int padding)
+    : pageWidth(pageWidth), pageHeight(pageHeight), padding(padding) {}
+
+bool AtlasPacker::insert(int width, int height, AtlasPlacement& placement) {
+    /**
+     * Find a spot for an image, opening a new page if no existing page has room
+     *
+     * @param width: The image width
+     * @param height: The image height
+     * @param placement: Set to the page and rect of the image on success
+     * @return: false if the image is too large to fit on an empty page
+     */
+    if (width + 2 * padding > pageWidth || height + 2 * padding > pageHeight) {
+        return false;
+    }
+
+    for (int i = 0; i < static_cast<int>(pages.size()); i++) {
+        if (insertIntoPage(pages[i], width, height, placement.rect)) {
+            placement.page = i;
+            return true;
+        }
+    }
+
+    pages.push_back({{}, 0});
+    insertIntoPage(pages.back(), width, height, placement.rect);
+    placement.page = static_cast<int>(pages.size()) - 1;
+    return true;
+}
+
+bool AtlasPacker::insertIntoPage(Page& page, int width, int height, SDL_Rect& rect) {
+    /**
+     * Place an image on the first shelf it fits on, or on a new shelf below the last one
+     * Every image keeps a padding gap on all sides so filtering never samples a neighbour
+     *
+     * @param page: The page to place the image on
+     * @param width: The image width
+     * @param height: The image height
+     * @param rect: Set to the placed rect on success
+     * @return: true if the image was placed
+     */
+    int paddedWidth = width + 2 * padding;
+    int paddedHeight = height + 2 * padding;
+
+    for (Shelf& shelf : page.shelves) {
+        if (paddedHeight <= shelf.height && shelf.nextX + paddedWidth <= pageWidth) {
+            rect = {shelf.nextX + padding, shelf.y + padding, width, height};
+            shelf.nextX += paddedWidth;
+            return true;
+        }
+    }
+
+    if (page.usedHeight + paddedHeight > pageHeight) {
+        return false;
+    }
+    page.shelves.push_back({page.usedHeight, paddedHeight, paddedWidth});
+    rect = {padding, page.usedHeight + padding, width, height};
+    page.usedHeight += paddedHeight;
+    return true;
+}
+
+int AtlasPacker::getPageCount() const {
+    return static_cast<int>(pages.size());
+}
+
+int AtlasPacker::getUsedHeight(int page) const {
+    /**
+     * The height actually covered by shelves, so the last page can be allocated smaller than a full page
+     *
+     * @param page: The page index
+     */
+    return pages[page].usedHeight;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#ifndef BUMMERENGINE_TEXTUREATLAS_H
+#define BUMMERENGINE_TEXTUREATLAS_H
+
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+struct AtlasPlacement {
+    int page;
+    SDL_Rect rect;
+};
+
+class AtlasPacker {
+    /**
+     * Shelf packer that places images into fixed size atlas pages
+     * Images are placed left to right on horizontal shelves, and a new page is opened once a page is full
+     * Insert images tallest first for the tightest packing
+     */
+public:
+    AtlasPacker(int pageWidth, int pageHeight, int padding);
+    bool insert(int width, int height, AtlasPlacement& placement);
+    int getPageCount() const;
+    int getUsedHeight(int page) const;
+    int getPageWidth() const { return pageWidth; }
+
+private:
+    struct Shelf {
+        int y;
+        int height;
+        int nextX;
+    };
+    struct Page {
+        std::vector<Shelf> shelves;
+        int usedHeight;
+    };
+
+    bool insertIntoPage(Page& page, int width, int height, SDL_Rect& rect);
+
+    int pageWidth;
+    int pageHeight;
+    int padding;
+    std::vector<Page> pages;
+};
+
+#endif //BUMMERENGINE_TEXTUREATLAS_H
@@ -0,0 +1,11 @@
+#pragma once
+#ifndef BUMMERENGINE_TEXTUREHANDLE_H
+#define BUMMERENGINE_TEXTUREHANDLE_H
+
+#include <cstdint>
+
+// index of a texture in the TextureManager, stable for a path even while the texture is evicted
+using TextureHandle = uint32_t;
+constexpr TextureHandle INVALID_TEXTURE_HANDLE = 0;
+
+#endif //BUMMERENGINE_TEXTUREHANDLE_H
@@ -1,50 +1,648 @@
-#include <iostream>
+#include <algorithm>
+#include <utility>
 
 #include <SDL2/SDL_image.h>
 
+#include "AssetPack.h"
+#include "TextureAtlas.h"
 #include "TextureManager.h"
+#include "../Logger.h"
+
+namespace {
+    bool copyPixels(SDL_Texture* texture, const SDL_Rect& rect, SDL_Surface* surface) {
+        // the texture keeps its own pixel format, the image is converted to it
+        Uint32 format = 0;
+        SDL_QueryTexture(texture, &format, nullptr, nullptr, nullptr);
+        SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, format, 0);
+        if (converted == nullptr) {
+            return false;
+        }
+        int result = SDL_UpdateTexture(texture, &rect, converted->pixels, converted->pitch);
+        SDL_FreeSurface(converted);
+        return result == 0;
+    }
+}
 
 SDL_Texture* TextureManager::loadTexture(SDL_Renderer* renderer, const std::string& filePath) {
     /**
      * Load a texture from a file and return it
      * If the texture is already loaded, return it
+     * With async loading enabled, PNGs come back as a transparent texture of the right size that is
+     * filled in by uploadDecodedTextures() once decoded
      *
      * @param renderer The renderer to use
      * @param filePath The path to the file
      */
     // Check if the texture is already loaded
-    auto tex = textures.find(filePath);
-    if (tex != textures.end()) {
-        // If the texture is found, return it
-        return tex->second;  // t->first is the key and t->second is the value
+    TextureHandle handle = getHandle(filePath);
+    if (entries[handle].texture != nullptr) {
+        return entries[handle].texture;
+    }
+
+    // PNGs give their size in the header, so a placeholder can be handed out while the image decodes
+    int width = 0;
+    int height = 0;
+    if (decoder && readPngSize(filePath, width, height)) {
+        return loadTextureAsync(renderer, filePath, width, height);
     }
 
     // If the texture is not found, load it
-    SDL_Texture* newTexture = IMG_LoadTexture(renderer, filePath.c_str());
-    if (newTexture == nullptr) {
-        std::cout << "Failed to load texture from " << filePath << "! SDL_image Error: " << IMG_GetError() << std::endl;
-    } else {
-        // If the texture is successfully loaded, store it in the map
-        SDL_SetTextureScaleMode(newTexture, SDL_ScaleModeNearest);
-        textures[filePath] = newTexture;
+    SDL_Texture* newTexture = nullptr;
+    onRendererThread([&] {
+        newTexture = IMG_LoadTexture_RW(renderer, openAsset(filePath), 1);
+        if (newTexture == nullptr) {
+            // SDL errors are per thread, read it where the call failed
+            LOG_ERROR("texture", "Failed to load texture from " << filePath << "! SDL_image Error: " << IMG_GetError());
+        } else {
+            SDL_SetTextureScaleMode(newTexture, SDL_ScaleModeNearest);
+            SDL_QueryTexture(newTexture, nullptr, nullptr, &width, &height);
+        }
+    });
+    if (newTexture != nullptr) {
+        storeTexture(handle, newTexture, width, height);
     }
 
     return newTexture;
 }
 
+TextureRegion TextureManager::loadRegion(SDL_Renderer* renderer, const std::string& filePath) {
+    /**
+     * Get the texture and source rect holding an image
+     * Images packed by buildAtlas() resolve to their atlas page, anything else is loaded as its own texture
+     * Callers offset their source rects by rect.x and rect.y to address the image inside the texture
+     *
+     * @param renderer The renderer to use
+     * @param filePath The path to the file
+     */
+    auto region = atlasRegions.find(filePath);
+    if (region != atlasRegions.end()) {
+        return region->second;
+    }
+
+    SDL_Texture* texture = loadTexture(renderer, filePath);
+    TextureHandle handle = getHandle(filePath);
+    SDL_Rect rect = {0, 0, 0, 0};
+    if (texture != nullptr) {
+        rect.w = entries[handle].width;
+        rect.h = entries[handle].height;
+    }
+    return {texture, rect, handle};
+}
+
+bool TextureManager::preloadTexture(SDL_Renderer* renderer, const std::string& filePath, SDL_Surface* surface) {
+    /**
+     * Create the texture of an image decoded ahead of time, so the next loadTexture() of it needs no disk access
+     * The texture stays unreferenced until someone acquires it
+     *
+     * @param renderer The renderer to use
+     * @param filePath The path the image is loaded by
+     * @param surface The decoded image, still owned by the caller
+     * @return false if the image was already resident or the texture could not be created
+     */
+    if (atlasRegions.count(filePath) > 0) {
+        return false;
+    }
+    TextureHandle handle = getHandle(filePath);
+    if (entries[handle].texture != nullptr) {
+        return false;
+    }
+    SDL_Texture* texture = nullptr;
+    onRendererThread([&] {
+        texture = SDL_CreateTextureFromSurface(renderer, surface);
+        if (texture == nullptr) {
+            LOG_ERROR("texture", "Failed to create texture for " << filePath << "! SDL Error: " << SDL_GetError());
+        } else {
+            SDL_SetTextureScaleMode(texture, SDL_ScaleModeNearest);
+        }
+    });
+    if (texture == nullptr) {
+        return false;
+    }
+    storeTexture(handle, texture, surface->w, surface->h);
+    return true;
+}
+
+std::vector<std::string> TextureManager::getResidentPaths() const {
+    /**
+     * The images that load without touching the disk, packed in the atlas or loaded as their own texture
+     */
+    std::vector<std::string> paths;
+    for (const auto& [path, region] : atlasRegions) {
+        paths.push_back(path);
+    }
+    for (const auto& [path, handle] : handlesByPath) {
+        if (entries[handle].texture != nullptr) {
+            paths.push_back(path);
+        }
+    }
+    return paths;
+}
+
+bool TextureManager::reloadTexture(SDL_Renderer* renderer, const std::string& filePath) {
+    /**
+     * Load an image again after it changed on disk, under the same handle
+     * An image of the same size is copied into its texture, so everything drawing the texture shows it
+     * without being touched. A loose image that changed size gets a new texture, callers holding the old
+     * pointer look it up again with getTexture(). Atlas images must keep their size, the atlas is not repacked.
+     *
+     * @param renderer The renderer to use
+     * @param filePath The path to the file
+     * @return false if the image is not loaded or could not be reloaded
+     */
+    auto region = atlasRegions.find(filePath);
+    auto handle = handlesByPath.find(filePath);
+    bool inAtlas = region != atlasRegions.end();
+    if (!inAtlas && (handle == handlesByPath.end() || entries[handle->second].texture == nullptr)) {
+        // nothing holds the image, whoever loads it next reads the new file anyway
+        return false;
+    }
+
+    SDL_Surface* surface = IMG_Load_RW(openAsset(filePath), 1);
+    if (surface == nullptr) {
+        LOG_ERROR("texture", "Failed to reload " << filePath << "! SDL_image Error: " << IMG_GetError());
+        return false;
+    }
+
+    SDL_Texture* texture = inAtlas ? region->second.texture : entries[handle->second].texture;
+    SDL_Rect rect = inAtlas ? region->second.rect : SDL_Rect{0, 0, entries[handle->second].width, entries[handle->second].height};
+    bool reloaded = false;
+    if (surface->w == rect.w && surface->h == rect.h) {
+        if (decoder && !inAtlas) {
+            // an upload still queued for the texture would overwrite the new pixels
+            decoder->discard(texture);
+        }
+        onRendererThread([&] {
+            reloaded = copyPixels(texture, rect, surface);
+        });
+    } else if (inAtlas) {
+        LOG_WARN("texture", filePath << " changed size, restart to repack the atlas");
+        SDL_FreeSurface(surface);
+        return false;
+    } else {
+        SDL_Texture* replacement = nullptr;
+        onRendererThread([&] {
+            replacement = SDL_CreateTextureFromSurface(renderer, surface);
+            if (replacement != nullptr) {
+                SDL_SetTextureScaleMode(replacement, SDL_ScaleModeNearest);
+            }
+        });
+        if (replacement != nullptr) {
+            // the old texture is retired like an evicted one, frames in flight may still draw it
+            evict(handle->second);
+            storeTexture(handle->second, replacement, surface->w, surface->h);
+            reloaded = true;
+        }
+    }
+    if (!reloaded) {
+        LOG_ERROR("texture", "Failed to reload " << filePath << "! SDL Error: " << SDL_GetError());
+    }
+    SDL_FreeSurface(surface);
+    return reloaded;
+}
+
+TextureRegion TextureManager::acquireRegion(SDL_Renderer* renderer, const std::string& filePath) {
+    /**
+     * loadRegion() for a new user of the image, which must release() the handle once done with it
+     *
+     * @param renderer The renderer to use
+     * @param filePath The path to the file
+     */
+    TextureRegion region = loadRegion(renderer, filePath);
+    if (region.texture != nullptr) {
+        acquire(region.handle);
+    }
+    return region;
+}
+
+int TextureManager::buildAtlas(SDL_Renderer* renderer, const std::vector<std::string>& imagePaths, int pageSize) {
+    /**
+     * Pack images into shared atlas pages so sprites from different files can be drawn from one texture
+     * Must run before entities load their textures, since Sprite and AnimationClip rects are remapped at load time
+     * Images that fail to load or do not fit on a page are left for loadTexture() to load on their own
+     *
+     * @param renderer The renderer to use
+     * @param imagePaths The images to pack
+     * @param pageSize The width and height of an atlas page
+     * @return The number of pages created
+     */
+    struct PendingImage {
+        std::string path;
+        SDL_Surface* surface;
+        AtlasPlacement placement;
+    };
+    std::vector<std::string> newPaths;
+    for (const std::string& path : imagePaths) {
+        if (atlasRegions.count(path) == 0 && (handlesByPath.count(path) == 0 || entries[handlesByPath[path]].texture == nullptr)) {
+            newPaths.push_back(path);
+        }
+    }
+    std::vector<SDL_Surface*> surfaces = decodeImages(newPaths);
+
+    std::vector<PendingImage> images;
+    for (size_t i = 0; i < newPaths.size(); i++) {
+        if (surfaces[i] == nullptr) {
+            LOG_ERROR("texture", "Failed to load atlas image " << newPaths[i]);
+            continue;
+        }
+        images.push_back({newPaths[i], surfaces[i], {}});
+    }
+
+    // tallest first keeps shelves tight
+    std::sort(images.begin(), images.end(), [](const PendingImage& a, const PendingImage& b) {
+        return a.surface->h > b.surface->h;
+    });
+
+    AtlasPacker packer(pageSize, pageSize, 1);
+    for (PendingImage& image : images) {
+        if (!packer.insert(image.surface->w, image.surface->h, image.placement)) {
+            LOG_WARN("texture", image.path << " is larger than an atlas page, loading it separately");
+            image.placement.page = -1;
+        }
+    }
+
+    size_t firstPage = atlasPages.size();
+    std::vector<SDL_Surface*> pageSurfaces;
+    for (int page = 0; page < packer.getPageCount(); page++) {
+        pageSurfaces.push_back(SDL_CreateRGBSurfaceWithFormat(0, packer.getPageWidth(), packer.getUsedHeight(page), 32, SDL_PIXELFORMAT_RGBA32));
+    }
+
+    for (PendingImage& image : images) {
+        if (image.placement.page >= 0 && pageSurfaces[image.placement.page] != nullptr) {
+            // copy alpha as is instead of blending it onto the empty page
+            SDL_SetSurfaceBlendMode(image.surface, SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(image.surface, nullptr, pageSurfaces[image.placement.page], &image.placement.rect);
+        }
+    }
+
+    // surfaces are built on the calling thread, only the uploads need the renderer's thread
+    std::vector<SDL_Texture*> pageTextures;
+    onRendererThread([&] {
+        for (SDL_Surface* pageSurface : pageSurfaces) {
+            SDL_Texture* pageTexture = nullptr;
+            if (pageSurface != nullptr) {
+                pageTexture = SDL_CreateTextureFromSurface(renderer, pageSurface);
+                SDL_FreeSurface(pageSurface);
+            }
+            if (pageTexture == nullptr) {
+                LOG_ERROR("texture", "Failed to create atlas page! SDL Error: " << SDL_GetError());
+            } else {
+                SDL_SetTextureScaleMode(pageTexture, SDL_ScaleModeNearest);
+            }
+            pageTextures.push_back(pageTexture);
+        }
+    });
+
+    for (size_t page = 0; page < pageTextures.size(); page++) {
+        TextureHandle handle = getHandle("atlas page " + std::to_string(firstPage + page));
+        entries[handle].pinned = true;
+        if (pageTextures[page] != nullptr) {
+            storeTexture(handle, pageTextures[page], packer.getPageWidth(), packer.getUsedHeight(static_cast<int>(page)));
+        }
+        atlasPages.push_back(handle);
+    }
+
+    for (PendingImage& image : images) {
+        if (image.placement.page >= 0) {
+            TextureHandle pageHandle = atlasPages[firstPage + image.placement.page];
+            if (entries[pageHandle].texture != nullptr) {
+                atlasRegions[image.path] = {entries[pageHandle].texture, image.placement.rect, pageHandle};
+            }
+        }
+        SDL_FreeSurface(image.surface);
+    }
+
+    return packer.getPageCount();
+}
+
+std::vector<std::string> TextureManager::listImageFiles(const std::string& directory) {
+    /**
+     * Recursively list the png files in a directory, in the mounted asset pack or on disk, in a stable order
+     *
+     * @param directory The directory to search
+     */
+    return listAssets(directory, ".png");
+}
+
 void TextureManager::freeTexture(SDL_Texture* texture) {
     /**
-     * Free a texture
+     * Free a texture whether or not it is still in use, callers must make sure nothing draws it anymore
      *
      * @param texture The texture to free
      */
-    // Find the texture in the map
-    for (auto tex = textures.begin(); tex != textures.end(); ++tex) {
-        if (tex->second == texture) {
-            // If the texture is found, destroy it and remove it from the map
-            SDL_DestroyTexture(tex->second);
-            textures.erase(tex);
+    auto handle = handlesByTexture.find(texture);
+    if (handle != handlesByTexture.end()) {
+        evict(handle->second);
+    }
+}
+
+void TextureManager::acquire(TextureHandle handle) {
+    /**
+     * Count a new user of a texture, it will not be evicted until every user released it
+     *
+     * @param handle The texture handle
+     */
+    if (handle == INVALID_TEXTURE_HANDLE || handle >= entries.size()) {
+        return;
+    }
+    entries[handle].refCount++;
+    entries[handle].lastUsed = ++useClock;
+}
+
+void TextureManager::release(TextureHandle handle) {
+    /**
+     * Drop a user of a texture. It stays loaded, trimToBudget() decides when unused textures go.
+     *
+     * @param handle The texture handle
+     */
+    if (handle == INVALID_TEXTURE_HANDLE || handle >= entries.size() || entries[handle].refCount == 0) {
+        return;
+    }
+    entries[handle].refCount--;
+    entries[handle].lastUsed = ++useClock;
+}
+
+SDL_Texture* TextureManager::getTexture(TextureHandle handle) const {
+    /**
+     * The texture behind a handle, nullptr if it is not loaded
+     *
+     * @param handle The texture handle
+     */
+    if (handle == INVALID_TEXTURE_HANDLE || handle >= entries.size()) {
+        return nullptr;
+    }
+    return entries[handle].texture;
+}
+
+int TextureManager::getRefCount(TextureHandle handle) const {
+    if (handle == INVALID_TEXTURE_HANDLE || handle >= entries.size()) {
+        return 0;
+    }
+    return entries[handle].refCount;
+}
+
+void TextureManager::setMemoryBudget(size_t bytes) {
+    /**
+     * Set how much texture memory may stay resident before trimToBudget() evicts unused textures
+     * Textures in use are never evicted, so the budget can be exceeded by a scene that needs more
+     *
+     * @param bytes The budget, estimated as four bytes per texel
+     */
+    memoryBudget = bytes;
+}
+
+size_t TextureManager::getResidentBytes() const {
+    return residentBytes;
+}
+
+int TextureManager::trimToBudget() {
+    /**
+     * Evict unused textures, least recently used first, until resident textures fit the budget
+     * Meant to run after a scene change, once the new scene acquired what it needs
+     *
+     * @return The number of textures evicted
+     */
+    if (residentBytes <= memoryBudget) {
+        return 0;
+    }
+    std::vector<TextureHandle> unused;
+    for (TextureHandle handle = 1; handle < entries.size(); handle++) {
+        const TextureEntry& entry = entries[handle];
+        if (entry.texture != nullptr && entry.refCount == 0 && !entry.pinned) {
+            unused.push_back(handle);
+        }
+    }
+    std::sort(unused.begin(), unused.end(), [this](TextureHandle a, TextureHandle b) {
+        return entries[a].lastUsed < entries[b].lastUsed;
+    });
+
+    int evicted = 0;
+    for (TextureHandle handle : unused) {
+        if (residentBytes <= memoryBudget) {
             break;
         }
+        evict(handle);
+        evicted++;
+    }
+    if (evicted > 0) {
+        LOG_INFO("texture", "Evicted " << evicted << " unused textures, " << residentBytes / 1024 << " KB resident");
+    }
+    return evicted;
+}
+
+int TextureManager::destroyRetiredTextures() {
+    /**
+     * Destroy evicted textures no frame can still draw, call once per presented frame on the thread owning the renderer
+     *
+     * @return The number of textures destroyed
+     */
+    std::lock_guard<std::mutex> lock(retiredMutex);
+    int destroyed = 0;
+    for (auto texture = retired.begin(); texture != retired.end();) {
+        if (--texture->framesLeft <= 0) {
+            SDL_DestroyTexture(texture->texture);
+            texture = retired.erase(texture);
+            destroyed++;
+        } else {
+            ++texture;
+        }
+    }
+    return destroyed;
+}
+
+TextureHandle TextureManager::getHandle(const std::string& filePath) {
+    /**
+     * The handle of a file, created on first use. A handle keeps its path while evicted, so reloading reuses it.
+     *
+     * @param filePath The path to the file
+     */
+    auto handle = handlesByPath.find(filePath);
+    if (handle != handlesByPath.end()) {
+        return handle->second;
+    }
+    TextureHandle newHandle = static_cast<TextureHandle>(entries.size());
+    entries.push_back({filePath, nullptr, 0, 0, 0, 0, false});
+    handlesByPath[filePath] = newHandle;
+    return newHandle;
+}
+
+void TextureManager::storeTexture(TextureHandle handle, SDL_Texture* texture, int width, int height) {
+    TextureEntry& entry = entries[handle];
+    entry.texture = texture;
+    entry.width = width;
+    entry.height = height;
+    entry.lastUsed = ++useClock;
+    residentBytes += static_cast<size_t>(width) * height * 4;
+    handlesByTexture[texture] = handle;
+}
+
+void TextureManager::evict(TextureHandle handle) {
+    /**
+     * Unload a texture, its destruction is deferred to destroyRetiredTextures()
+     *
+     * @param handle The texture handle
+     */
+    TextureEntry& entry = entries[handle];
+    if (entry.texture == nullptr) {
+        return;
+    }
+    if (decoder) {
+        decoder->discard(entry.texture);
+    }
+    {
+        std::lock_guard<std::mutex> lock(retiredMutex);
+        retired.push_back({entry.texture, RETIRE_FRAMES});
+    }
+    handlesByTexture.erase(entry.texture);
+    residentBytes -= static_cast<size_t>(entry.width) * entry.height * 4;
+    entry.texture = nullptr;
+}
+
+void TextureManager::setRendererInvoker(RendererInvoker invoker) {
+    /**
+     * Route renderer calls through invoker, for when textures are loaded away from the thread owning the renderer
+     * The invoker must run the task on that thread and return once it is done
+     *
+     * @param invoker The invoker, or nullptr to call the renderer directly again
+     */
+    rendererInvoker = std::move(invoker);
+}
+
+void TextureManager::onRendererThread(const std::function<void()>& task) {
+    /**
+     * Run a task that calls the renderer, through the invoker if one is set
+     *
+     * @param task The task
+     */
+    if (rendererInvoker) {
+        rendererInvoker(task);
+    } else {
+        task();
+    }
+}
+
+void TextureManager::enableAsyncLoading(int workerCount) {
+    /**
+     * Decode images on worker threads from now on
+     * Call uploadDecodedTextures() every frame on the thread owning the renderer to finish the loads
+     *
+     * @param workerCount The number of decode threads, 0 keeps loading synchronous, below 0 picks one per spare core
+     */
+    if (workerCount == 0) {
+        decoder.reset();
+        return;
+    }
+    decoder = std::make_unique<ImageDecoder>(workerCount < 0 ? ImageDecoder::defaultWorkerCount() : workerCount);
+    LOG_INFO("texture", "Decoding images on " << decoder->getWorkerCount() << " threads");
+}
+
+int TextureManager::uploadDecodedTextures(int maxUploads) {
+    /**
+     * Copy decoded images into their placeholder textures
+     * Must run on the thread owning the renderer. Only touches the decoder, so it may run while
+     * the simulation thread loads more textures.
+     *
+     * @param maxUploads The most images to upload, bounds the time spent in one frame
+     * @return The number of textures uploaded
+     */
+    if (!decoder) {
+        return 0;
+    }
+    int uploaded = 0;
+    ImageDecoder::DecodedImage image;
+    while (uploaded < maxUploads && decoder->takeDecoded(image)) {
+        if (image.surface == nullptr) {
+            // stays transparent, the error was logged by the decoder
+            continue;
+        }
+        SDL_UpdateTexture(image.target, nullptr, image.surface->pixels, image.surface->pitch);
+        SDL_FreeSurface(image.surface);
+        uploaded++;
     }
-}
\ No newline at end of file
+    return uploaded;
+}
+
+size_t TextureManager::getPendingUploadCount() {
+    /**
+     * Textures handed out as placeholders that are not uploaded yet
+     */
+    return decoder ? decoder->getPendingCount() : 0;
+}
+
+bool TextureManager::readPngSize(const std::string& filePath, int& width, int& height) {
+    /**
+     * Read the size of a PNG from its IHDR chunk without decoding it
+     *
+     * @param filePath The path to the file
+     * @param width Set to the image width
+     * @param height Set to the image height
+     * @return false if the file is not a readable PNG
+     */
+    static const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    unsigned char header[24];
+    SDL_RWops* file = openAsset(filePath);
+    if (file == nullptr) {
+        return false;
+    }
+    size_t read = SDL_RWread(file, header, sizeof(header), 1);
+    SDL_RWclose(file);
+    if (read != 1 || !std::equal(signature, signature + 8, header) || std::string(reinterpret_cast<char*>(header + 12), 4) != "IHDR") {
+        return false;
+    }
+    // big endian, right after the chunk type
+    width = (header[16] << 24) | (header[17] << 16) | (header[18] << 8) | header[19];
+    height = (header[20] << 24) | (header[21] << 16) | (header[22] << 8) | header[23];
+    return width > 0 && height > 0;
+}
+
+SDL_Texture* TextureManager::loadTextureAsync(SDL_Renderer* renderer, const std::string& filePath, int width, int height) {
+    /**
+     * Create a fully transparent texture of the image's size and queue the image for decoding
+     * Callers can build source rects and sprites straight away, the pixels show up once uploaded
+     *
+     * @param renderer The renderer to use
+     * @param filePath The path to the file
+     * @param width The image width
+     * @param height The image height
+     */
+    SDL_Texture* placeholder = nullptr;
+    onRendererThread([&] {
+        placeholder = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, width, height);
+        if (placeholder == nullptr) {
+            LOG_ERROR("texture", "Failed to create texture for " << filePath << "! SDL Error: " << SDL_GetError());
+            return;
+        }
+        SDL_SetTextureBlendMode(placeholder, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureScaleMode(placeholder, SDL_ScaleModeNearest);
+        // contents are undefined until the upload. Sprites are drawn with SDL_RenderGeometry, which ignores
+        // the texture's alpha mod, so the pixels themselves are cleared.
+        std::vector<Uint8> transparent(static_cast<size_t>(width) * height * 4, 0);
+        SDL_UpdateTexture(placeholder, nullptr, transparent.data(), width * 4);
+    });
+    if (placeholder == nullptr) {
+        return nullptr;
+    }
+    storeTexture(getHandle(filePath), placeholder, width, height);
+    decoder->request(filePath, placeholder);
+    return placeholder;
+}
+
+std::vector<SDL_Surface*> TextureManager::decodeImages(const std::vector<std::string>& paths) {
+    /**
+     * Decode images into surfaces, in parallel when async loading is enabled
+     *
+     * @param paths The image files
+     * @return One surface per path, nullptr where loading failed. The caller frees them.
+     */
+    if (decoder) {
+        return decoder->decodeAll(paths);
+    }
+    std::vector<SDL_Surface*> surfaces;
+    for (const std::string& path : paths) {
+        SDL_Surface* surface = IMG_Load_RW(openAsset(path), 1);
+        if (surface == nullptr) {
+            LOG_ERROR("texture", "Failed to decode " << path << "! SDL_image Error: " << IMG_GetError());
+        }
+        surfaces.push_back(surface);
+    }
+    return surfaces;
+}
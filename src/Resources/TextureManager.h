@@ -2,18 +2,99 @@
 #ifndef BUMMERENGINE_TEXTUREMANAGER_H
 #define BUMMERENGINE_TEXTUREMANAGER_H
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <SDL2/SDL.h>
 
+#include "ImageDecoder.h"
+#include "TextureHandle.h"
+
+struct TextureRegion {
+    SDL_Texture* texture;
+    SDL_Rect rect;  // where the image sits inside texture
+    TextureHandle handle;
+};
 
 class TextureManager {
+    /**
+     * Loads each image file once and keeps track of who uses it
+     *
+     * Every texture gets a small integer handle. acquireRegion() and release() count the users of a texture,
+     * which are Sprites, Animators and tilemaps. Textures nobody uses stay loaded so the next scene can pick
+     * them up cheaply, until trimToBudget() finds resident textures over the memory budget and evicts unused
+     * ones, least recently used first. Evicted textures are destroyed a couple of frames later by
+     * destroyRetiredTextures(), once no frame in flight can still draw them.
+     */
 public:
+    using RendererInvoker = std::function<void(const std::function<void()>&)>;
+
+    static constexpr int UPLOADS_PER_FRAME = 8;  // decoded images uploaded per uploadDecodedTextures() call
+    static constexpr int RETIRE_FRAMES = 2;  // one frame being drawn and one queued may still use an evicted texture
+
     SDL_Texture* loadTexture(SDL_Renderer* renderer, const std::string& filePath);
+    TextureRegion loadRegion(SDL_Renderer* renderer, const std::string& filePath);
+    int buildAtlas(SDL_Renderer* renderer, const std::vector<std::string>& imagePaths, int pageSize);
     void freeTexture(SDL_Texture* texture);
+
+    bool reloadTexture(SDL_Renderer* renderer, const std::string& filePath);
+    bool preloadTexture(SDL_Renderer* renderer, const std::string& filePath, SDL_Surface* surface);
+    std::vector<std::string> getResidentPaths() const;
+    TextureRegion acquireRegion(SDL_Renderer* renderer, const std::string& filePath);
+    void acquire(TextureHandle handle);
+    void release(TextureHandle handle);
+    SDL_Texture* getTexture(TextureHandle handle) const;
+    int getRefCount(TextureHandle handle) const;
+    void setMemoryBudget(size_t bytes);
+    size_t getResidentBytes() const;
+    int trimToBudget();
+    int destroyRetiredTextures();
+    static std::vector<std::string> listImageFiles(const std::string& directory);
+    void setRendererInvoker(RendererInvoker invoker);
+    void enableAsyncLoading(int workerCount);
+    int uploadDecodedTextures(int maxUploads);
+    size_t getPendingUploadCount();
+    static bool readPngSize(const std::string& filePath, int& width, int& height);
 private:
-    std::unordered_map<std::string, SDL_Texture*> textures;
+    struct TextureEntry {
+        std::string path;
+        SDL_Texture* texture;  // nullptr while not loaded or evicted
+        int width;
+        int height;
+        int refCount;
+        uint64_t lastUsed;
+        bool pinned;  // atlas pages, shared by many images and never evicted
+    };
+    struct RetiredTexture {
+        SDL_Texture* texture;
+        int framesLeft;
+    };
+
+    TextureHandle getHandle(const std::string& filePath);
+    void storeTexture(TextureHandle handle, SDL_Texture* texture, int width, int height);
+    void evict(TextureHandle handle);
+    void onRendererThread(const std::function<void()>& task);
+    SDL_Texture* loadTextureAsync(SDL_Renderer* renderer, const std::string& filePath, int width, int height);
+    std::vector<SDL_Surface*> decodeImages(const std::vector<std::string>& paths);
+
+    RendererInvoker rendererInvoker;
+    std::unique_ptr<ImageDecoder> decoder;  // null while loading synchronously
+    std::vector<TextureEntry> entries = std::vector<TextureEntry>(1);  // indexed by handle, 0 is INVALID_TEXTURE_HANDLE
+    std::unordered_map<std::string, TextureHandle> handlesByPath;
+    std::unordered_map<SDL_Texture*, TextureHandle> handlesByTexture;
+    std::unordered_map<std::string, TextureRegion> atlasRegions;
+    std::vector<TextureHandle> atlasPages;
+    size_t residentBytes = 0;
+    size_t memoryBudget = SIZE_MAX;
+    uint64_t useClock = 0;
+    std::mutex retiredMutex;
+    std::vector<RetiredTexture> retired;  // destroyed on the render thread
 };
 
 
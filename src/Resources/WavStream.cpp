@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <cstring>
+
+#include "WavStream.h"
+#include "AssetPack.h"
+#include "../Logger.h"
+
+namespace {
+    constexpr Uint16 WAVE_FORMAT_PCM = 0x0001;
+    constexpr Uint16 WAVE_FORMAT_IEEE_FLOAT = 0x0003;
+    constexpr Uint16 WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+    Uint32 readLE32(const unsigned char* bytes) {
+        return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<Uint32>(bytes[3]) << 24);
+    }
+
+    Uint16 readLE16(const unsigned char* bytes) {
+        return static_cast<Uint16>(bytes[0] | (bytes[1] << 8));
+    }
+
+    SDL_AudioFormat toAudioFormat(Uint16 formatTag, Uint16 bitsPerSample) {
+        if (formatTag == WAVE_FORMAT_PCM) {
+            switch (bitsPerSample) {
+                case 8: return AUDIO_U8;
+                case 16: return AUDIO_S16LSB;
+                case 32: return AUDIO_S32LSB;
+                default: return 0;
+            }
+        }
+        if (formatTag == WAVE_FORMAT_IEEE_FLOAT && bitsPerSample == 32) {
+            return AUDIO_F32LSB;
+        }
+        return 0;
+    }
+}
+
+WavStream::~WavStream() {
+    close();
+}
+
+bool WavStream::open(const std::string& path) {
+    /**
+     * Open a WAV file and find its samples, nothing is decoded yet
+     *
+     * @param path: The WAV file
+     * @return: false if the file is missing or not a WAV with 8, 16 or 32 bit samples
+     */
+    close();
+    format = 0;
+    file = openAsset(path);
+    unsigned char riff[12];
+    if (file == nullptr || SDL_RWread(file, riff, sizeof(riff), 1) != 1 ||
+        std::memcmp(riff, "RIFF", 4) != 0 || std::memcmp(riff + 8, "WAVE", 4) != 0) {
+        LOG_ERROR("sound", "Stream: " << path << " is not a WAV file");
+        close();
+        return false;
+    }
+
+    // walk the chunks, fmt comes before data
+    unsigned char header[8];
+    while (SDL_RWread(file, header, sizeof(header), 1) == 1) {
+        Uint32 chunkSize = readLE32(header + 4);
+        if (std::memcmp(header, "fmt ", 4) == 0) {
+            unsigned char fmt[40] = {};
+            size_t fmtBytes = std::min<size_t>(chunkSize, sizeof(fmt));
+            SDL_RWread(file, fmt, 1, fmtBytes);
+            Uint16 formatTag = readLE16(fmt);
+            if (formatTag == WAVE_FORMAT_EXTENSIBLE && fmtBytes >= 26) {
+                // the real format is the start of the sub format GUID
+                formatTag = readLE16(fmt + 24);
+            }
+            channels = readLE16(fmt + 2);
+            frequency = static_cast<int>(readLE32(fmt + 4));
+            format = toAudioFormat(formatTag, readLE16(fmt + 14));
+            SDL_RWseek(file, static_cast<Sint64>(chunkSize - fmtBytes + (chunkSize & 1)), RW_SEEK_CUR);
+        } else if (std::memcmp(header, "data", 4) == 0) {
+            if (format == 0 || channels <= 0 || frequency <= 0) {
+                break;
+            }
+            dataStart = SDL_RWtell(file);
+            dataSize = chunkSize;
+            remaining = dataSize;
+            return true;
+        } else {
+            // chunks are padded to an even size
+            SDL_RWseek(file, static_cast<Sint64>(chunkSize + (chunkSize & 1)), RW_SEEK_CUR);
+        }
+    }
+    LOG_ERROR("sound", "Stream: " << path << " has no samples in a supported format");
+    close();
+    return false;
+}
+
+size_t WavStream::read(Uint8* buffer, size_t bytes) {
+    /**
+     * Read the next samples
+     *
+     * @param buffer: Receives the samples, in getFormat()
+     * @param bytes: The most to read
+     * @return: The number of bytes read, 0 at the end of the samples
+     */
+    if (file == nullptr) {
+        return 0;
+    }
+    bytes = std::min(bytes, remaining);
+    size_t read = SDL_RWread(file, buffer, 1, bytes);
+    // a truncated file ends where its bytes do
+    remaining = read < bytes ? 0 : remaining - read;
+    return read;
+}
+
+void WavStream::rewind() {
+    /**
+     * Go back to the first sample, for looping
+     */
+    if (file == nullptr) {
+        return;
+    }
+    SDL_RWseek(file, dataStart, RW_SEEK_SET);
+    remaining = dataSize;
+}
+
+bool WavStream::isOpen() const {
+    return file != nullptr;
+}
+
+bool WavStream::atEnd() const {
+    return remaining == 0;
+}
+
+SDL_AudioFormat WavStream::getFormat() const {
+    return format;
+}
+
+int WavStream::getChannels() const {
+    return channels;
+}
+
+int WavStream::getFrequency() const {
+    return frequency;
+}
+
+size_t WavStream::getDataSize() const {
+    return dataSize;
+}
+
+void WavStream::close() {
+    if (file != nullptr) {
+        SDL_RWclose(file);
+        file = nullptr;
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+#ifndef BUMMERENGINE_WAVSTREAM_H
+#define BUMMERENGINE_WAVSTREAM_H
+
+#include <cstddef>
+#include <string>
+
+#include <SDL2/SDL.h>
+
+class WavStream {
+    /**
+     * Reads the samples of a PCM or float WAV file a block at a time instead of loading the whole file
+     *
+     * Opening only parses the header, so even a track several minutes long opens instantly and never sits in memory.
+     * The file is read through openAsset(), from the mounted asset pack or from disk.
+     */
+public:
+    WavStream() = default;
+    ~WavStream();
+    WavStream(const WavStream&) = delete;
+    WavStream& operator=(const WavStream&) = delete;
+
+    bool open(const std::string& path);
+    size_t read(Uint8* buffer, size_t bytes);
+    void rewind();
+    bool isOpen() const;
+    bool atEnd() const;
+    SDL_AudioFormat getFormat() const;
+    int getChannels() const;
+    int getFrequency() const;
+    size_t getDataSize() const;
+
+private:
+    void close();
+
+    SDL_RWops* file = nullptr;
+    Sint64 dataStart = 0;
+    size_t dataSize = 0;
+    size_t remaining = 0;
+    SDL_AudioFormat format = 0;
+    int channels = 0;
+    int frequency = 0;
+};
+
+#endif //BUMMERENGINE_WAVSTREAM_H
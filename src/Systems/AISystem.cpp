@@ -2,20 +2,40 @@
 
 #include <iostream>
 
+#include "DebugDraw.h"
 #include "../ECS/EventManager.h"
 #include "../Utils.h"
 
 
 void AISystem::update(EntityManager& entityManager) {
+    bool drawRanges = DebugDraw::getInstance().isEnabled(DebugDraw::AI_RANGES);
     for (Entity& entity : entityManager.getEntities()) {
         if (entity.hasComponent<Npc>()) {
             entity.resetIntent(true);
             patrol(entity);
             attack(entityManager, entity);
+            if (drawRanges) {
+                drawAIRanges(entity);
+            }
         }
     }
 }
 
+void AISystem::drawAIRanges(Entity& entity) {
+    /**
+     * Show the patrol segment and the pursuit and attack ranges of an NPC on the debug overlay
+     *
+     * @param entity: An entity with AI and Transform
+     */
+    DebugDraw& debugDraw = DebugDraw::getInstance();
+    AI& ai = entity.getComponent<AI>();
+    Transform& transform = entity.getComponent<Transform>();
+    int patrolRange = static_cast<int>(ai.patrolRange);
+    debugDraw.line(ai.patrolStart.first - patrolRange, ai.patrolStart.second, ai.patrolStart.first + patrolRange, ai.patrolStart.second, {0, 255, 0, 255});
+    debugDraw.circle(transform.x, transform.y, static_cast<int>(ai.pursuitRange), {255, 160, 0, 255});
+    debugDraw.circle(transform.x, transform.y, static_cast<int>(ai.attackRange), {255, 0, 0, 255});
+}
+
 void AISystem::patrol(Entity& entity) {
     AI& ai = entity.getComponent<AI>();
     Transform& transform = entity.getComponent<Transform>();
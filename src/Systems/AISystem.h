@@ -10,6 +10,7 @@ public:
     void update(EntityManager& entityManager);
     void patrol(Entity& entity);
     void attack(EntityManager& entityManager, Entity& attacker);
+    void drawAIRanges(Entity& entity);
 };
 
 
@@ -1,8 +1,7 @@
 #include "AnimationSystem.h"
+#include "../Logger.h"
 #include "../Utils.h"
 
-#include <iostream>
-
 void AnimationSystem::update(EntityManager& entityManager) {
     /**
      * Update the animation system
@@ -15,29 +14,29 @@ void AnimationSystem::update(EntityManager& entityManager) {
             Animator& animator = entity.getComponent<Animator>();
             Sprite& sprite = entity.getComponent<Sprite>();
             State& state = entity.getComponent<State>();
-            auto clip = animator.animations.find(state.state);
-            if (clip != animator.animations.end()) {
-                AnimationClip& currentClip = clip->second;
+            const AnimationClip* currentClip = animator.getClip(state.state);
+            if (currentClip != nullptr) {
                 if (animator.isPlaying) {
-                    if (animator.currentFrame != 0 && animator.currentFrame % currentClip.framesPerImage == 0) {
+                    if (animator.currentFrame != 0 && animator.currentFrame % currentClip->framesPerImage == 0) {
                         // Switch to the next image in the animation
                         animator.currentImage++;
-                        if (animator.currentImage >= currentClip.frames.size()) {
-                            if (currentClip.loop) {
+                        if (animator.currentImage >= currentClip->frames.size()) {
+                            if (currentClip->loop) {
                                 animator.currentImage = 0;
                             } else {
-                                animator.currentImage = currentClip.frames.size() - 1;
+                                animator.currentImage = currentClip->frames.size() - 1;
                                 animator.isPlaying = false;  // gets reset in changeState()
                             }
                         }
                     }
-                    sprite.texture = currentClip.spriteSheet;
-                    sprite.srcRect = currentClip.frames[animator.currentImage];
+                    sprite.texture = currentClip->spriteSheet;
+                    sprite.drawnHandle = currentClip->spriteSheetHandle;
+                    sprite.srcRect = currentClip->frames[animator.currentImage];
                     animator.currentFrame++;
                 }
             }
             else {
-                std::cout << "Animation not found for state: " << Utils::playerStateToString(state.state) << std::endl;
+                LOG_WARN("animation", "Animation not found for state: " << Utils::playerStateToString(state.state));
             }
         }
     }
@@ -6,6 +6,14 @@
 #include <iostream>
 
 
+AttackSystem::AttackSystem(EventManager& eventManager) : eventManager(eventManager) {
+    /**
+     * Constructor for the AttackSystem
+     *
+     * @param eventManager: The event bus attack events are published on
+     */
+}
+
 void AttackSystem::update(EntityManager& entityManager) {
     /**
      * Update the attack system
@@ -42,7 +50,7 @@ void AttackSystem::handleIntent(Entity& entity) {
 
         if (intent.action == Action::ATTACK) {
             // publish event to StateMachine
-            EventManager::getInstance().publish("basicAttack", {&entity});
+            eventManager.publish("basicAttack", {&entity});
 
             // if state is basic attack, set attack to active
             auto& state = entity.getComponent<State>();
@@ -90,7 +98,7 @@ void AttackSystem::handleActiveAttacks(Entity &attacker, EntityManager &entityMa
             }
         }
         else {
-            EventManager::getInstance().publish("attackEnd", {&attacker});
+            eventManager.publish("attackEnd", {&attacker});
         }
     }
 }
@@ -120,7 +128,7 @@ void AttackSystem::hitOther(AttackInfo& attackInfo, Entity& attacker, Entity& ot
     auto& otherHealth = other.getComponent<Health>();
     if (otherHealth.invincibilityRemaining == 0) {
 
-        EventManager::getInstance().publish("enemyHit", {&attacker, &other});
+        eventManager.publish("enemyHit", {&attacker, &other});
 
         // TODO: AttackSystem should not be responsible for applying knockback. That's what the MovementSystem is for.
         // TODO: AttackSystem should not be responsible for reducing health. That's what the HealthSystem is for.
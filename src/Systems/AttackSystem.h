@@ -3,11 +3,14 @@
 #define BUMMERENGINE_ATTACKSYSTEM_H
 
 #include "../ECS/EntityManager.h"
+#include "../ECS/EventManager.h"
 
 class AttackSystem {
 public:
+    explicit AttackSystem(EventManager& eventManager);
     void update(EntityManager& entityManager);
 private:
+    EventManager& eventManager;
     // entities to remove vector
     std::vector<int> entitiesToRemove;
     void handleIntent(Entity& entity);
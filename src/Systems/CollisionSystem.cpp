@@ -1,28 +1,41 @@
 #include "CollisionSystem.h"
+#include "DebugDraw.h"
 #include "../ECS/EventManager.h"
 #include "../Utils.h"
 
-CollisionSystem::CollisionSystem() {
+CollisionSystem::CollisionSystem(EventManager& eventManager) : eventManager(eventManager) {
     /**
      * Constructor for the CollisionSystem
      *
      * The collisionBuffer defined here is the number of pixels that entities' colliders should be separated by
      * when a collision is detected. This is to prevent entities from continually colliding with each other.
+     *
+     * @param eventManager: The event bus collision events are queued on
      */
     collisionBuffer = 0;
 }
 
-void CollisionSystem::update(EntityManager& entityManager) {
+void CollisionSystem::update(EntityManager& entityManager, const std::vector<Tilemap>& tilemaps) {
     /**
-     * Iterate through all movable + collidable entities and check for collisions with other collidable entities
+     * Iterate through all movable + collidable entities and check for collisions with the solid tiles of
+     * the scene's tilemaps, then with other collidable entities
+     *
+     * Collision events are queued rather than published so that State and Animator are not mutated
+     * mid-iteration. They are dispatched at the next eventManager.flush() sync point.
      *
      * @param entityManager: The EntityManager
+     * @param tilemaps: The tilemaps of the current scene
      */
     auto& movableCollidableEntities = entityManager.getMovableCollidableEntities();
     auto& collidableEntities = entityManager.getCollidableEntities();
 
     for (auto& primaryEntity : movableCollidableEntities) {
         bool collision = false;
+        for (const Tilemap& tilemap : tilemaps) {
+            if (collideWithTiles(primaryEntity, tilemap)) {
+                collision = true;
+            }
+        }
         for (auto& otherEntity : collidableEntities) {
 
             if (primaryEntity.id != otherEntity.id && checkCollision(primaryEntity, otherEntity)){
@@ -31,11 +44,64 @@ void CollisionSystem::update(EntityManager& entityManager) {
             }
         }
         if (!collision) {
-            // publish airborne event if the entity is not colliding with anything
-            // groundCollision is published if the entity is colliding with the ground
-            EventManager::getInstance().publish("airborne", {&primaryEntity});
+            // queue airborne event if the entity is not colliding with anything
+            // groundCollision is queued if the entity is colliding with the ground
+            eventManager.queue("airborne", {&primaryEntity});
+        }
+    }
+}
+
+bool CollisionSystem::collideWithTiles(Entity& primaryEntity, const Tilemap& tilemap) {
+    /**
+     * Resolve an entity against the solid cells of a tilemap
+     *
+     * Only the cells under the entity's collider are looked up, so the cost does not depend on the size of the map.
+     * Consecutive solid cells in a row are merged into one rect before resolving, so a floor made of many tiles
+     * behaves like a single platform and its inner tile edges never push the entity sideways.
+     *
+     * @param primaryEntity: The moving Entity
+     * @param tilemap: The tilemap
+     * @return: true if the entity touched any solid cell
+     */
+    bool collision = false;
+    int firstColumn, firstRow, lastColumn, lastRow;
+    tilemap.getTouchedCells(primaryEntity.getColliderRect(), firstColumn, firstRow, lastColumn, lastRow);
+
+    DebugDraw& debugDraw = DebugDraw::getInstance();
+    bool drawCells = debugDraw.isEnabled(DebugDraw::BROADPHASE);
+    if (drawCells && firstColumn <= lastColumn && firstRow <= lastRow) {
+        SDL_Rect firstCell = tilemap.getCellRect(firstColumn, firstRow);
+        SDL_Rect lastCell = tilemap.getCellRect(lastColumn, lastRow);
+        debugDraw.rect({firstCell.x, firstCell.y, lastCell.x + lastCell.w - firstCell.x, lastCell.y + lastCell.h - firstCell.y}, {0, 120, 255, 255});
+    }
+
+    for (int row = firstRow; row <= lastRow; row++) {
+        int column = firstColumn;
+        while (column <= lastColumn) {
+            if (!tilemap.isSolid(column, row)) {
+                column++;
+                continue;
+            }
+            int runStart = column;
+            while (column <= lastColumn && tilemap.isSolid(column, row)) {
+                column++;
+            }
+            SDL_Rect runStartRect = tilemap.getCellRect(runStart, row);
+            SDL_Rect runEndRect = tilemap.getCellRect(column - 1, row);
+            SDL_Rect runRect = {runStartRect.x, runStartRect.y, runEndRect.x + runEndRect.w - runStartRect.x, runStartRect.h};
+            if (drawCells) {
+                debugDraw.rect(runRect, {0, 220, 255, 255});
+            }
+
+            // earlier runs may already have moved the entity clear of this one
+            SDL_Rect primaryCollider = primaryEntity.getColliderRect();
+            if (isTouchingXaxis(primaryCollider, runRect) && isTouchingYaxis(primaryCollider, runRect)) {
+                collision = true;
+                handleCollision(primaryEntity, runRect);
+            }
         }
     }
+    return collision;
 }
 
 bool CollisionSystem::checkCollision(Entity &primaryEntity, Entity &otherEntity) {
@@ -64,17 +130,44 @@ void CollisionSystem::handleCollision(Entity& primaryEntity, Entity& otherEntity
      * @param primaryEntity: The primary Entity
      * @param otherEntity: The other Entity
      */
+    handleCollision(primaryEntity, otherEntity.getColliderRect());
+}
+
+void CollisionSystem::handleCollision(Entity& primaryEntity, const SDL_Rect& otherCollider) {
+    /**
+     * Handle a collision against a collider rect, using the same rules as handleCollision(Entity&, Entity&)
+     *
+     * @param primaryEntity: The primary Entity
+     * @param otherCollider: The collider it hit, e.g. a run of solid tiles
+     */
     SDL_Rect primaryCollider = primaryEntity.getColliderRect();
-    SDL_Rect otherCollider = otherEntity.getColliderRect();
 
     SDL_Rect intersection_rect;
     SDL_IntersectRect(&primaryCollider, &otherCollider, &intersection_rect);
 
-    if (intersection_rect.h > intersection_rect.w && intersection_rect.w < primaryCollider.w) {
-        handleCollisionX(primaryEntity, otherEntity);
+    bool xAxis = intersection_rect.h > intersection_rect.w && intersection_rect.w < primaryCollider.w;
+
+    DebugDraw& debugDraw = DebugDraw::getInstance();
+    if (debugDraw.isEnabled(DebugDraw::CONTACTS)) {
+        // the overlap, and the normal pushing the primary entity out of it
+        int centerX = intersection_rect.x + intersection_rect.w / 2;
+        int centerY = intersection_rect.y + intersection_rect.h / 2;
+        int normalX = 0;
+        int normalY = 0;
+        if (xAxis) {
+            normalX = (primaryCollider.x + primaryCollider.w / 2 < otherCollider.x + otherCollider.w / 2) ? -1 : 1;
+        } else {
+            normalY = (primaryCollider.y + primaryCollider.h / 2 < otherCollider.y + otherCollider.h / 2) ? -1 : 1;
+        }
+        debugDraw.rect(intersection_rect, {255, 255, 0, 255}, true);
+        debugDraw.line(centerX, centerY, centerX + normalX * CONTACT_NORMAL_LENGTH, centerY + normalY * CONTACT_NORMAL_LENGTH, {255, 255, 0, 255});
+    }
+
+    if (xAxis) {
+        handleCollisionX(primaryEntity, otherCollider);
     }
     else {
-        handleCollisionY(primaryEntity, otherEntity);
+        handleCollisionY(primaryEntity, otherCollider);
     }
 }
 
@@ -179,13 +272,22 @@ void CollisionSystem::handleCollisionX(Entity& primaryEntity, Entity& otherEntit
      * @param entity: The primaryEntity primaryEntity
      * @param other: The otherEntity primaryEntity
      */
+    handleCollisionX(primaryEntity, otherEntity.getColliderRect());
+}
+
+void CollisionSystem::handleCollisionX(Entity& primaryEntity, const SDL_Rect& otherCollider) {
+    /**
+     * Handle primaryEntity collision with a collider rect on the X axis
+     *
+     * @param primaryEntity: The primary Entity
+     * @param otherCollider: The collider it hit
+     */
     SDL_Rect primaryCollider = primaryEntity.getColliderRect();
-    SDL_Rect otherCollider = otherEntity.getColliderRect();
 
     if (primaryCollider.x < otherCollider.x) {  // primaryEntity is to the left of other otherEntity
         stopAndRepositionToLeft(primaryEntity, primaryCollider, otherCollider);
     }
-    else if (primaryCollider.x > otherCollider.y) {  // primaryEntity is to the right of other otherEntity
+    else if (primaryCollider.x > otherCollider.x) {  // primaryEntity is to the right of other otherEntity
         stopAndRepositionToRight(primaryEntity, otherCollider);
     }
 }
@@ -225,8 +327,17 @@ void CollisionSystem::handleCollisionY(Entity& primaryEntity, Entity& otherEntit
      * @param primaryEntity: The primary Entity
      * @param otherEntity: The other Entity
      */
+    handleCollisionY(primaryEntity, otherEntity.getColliderRect());
+}
+
+void CollisionSystem::handleCollisionY(Entity& primaryEntity, const SDL_Rect& otherCollider) {
+    /**
+     * Handle primaryEntity collision with a collider rect on the Y axis
+     *
+     * @param primaryEntity: The primary Entity
+     * @param otherCollider: The collider it hit
+     */
     SDL_Rect primaryCollider = primaryEntity.getColliderRect();
-    SDL_Rect otherCollider = otherEntity.getColliderRect();
 
     if (primaryCollider.y < otherCollider.y) {  // primaryEntity is above other otherEntity
         stopAndRepositionAbove(primaryEntity, primaryCollider, otherCollider);
@@ -244,7 +355,7 @@ void CollisionSystem::stopAndRepositionAbove(Entity& primaryEntity, const SDL_Re
      * @param primaryCollider: The primary Entity collider
      * @param otherCollider: The other Entity collider
      */
-    EventManager::getInstance().publish("groundCollision", {&primaryEntity});
+    eventManager.queue("groundCollision", {&primaryEntity});
 
     auto& velocity = primaryEntity.getComponent<Velocity>();
     velocity.dy = 0;
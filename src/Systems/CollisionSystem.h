@@ -4,12 +4,17 @@
 
 #include "../ECS/EntityManager.h"
 #include "../ECS/Components.h"
+#include "../ECS/EventManager.h"
+#include "../ECS/Tilemap.h"
 
 
 class CollisionSystem {
 public:
-    explicit CollisionSystem();
-    void update(EntityManager& entityManager);
+    static constexpr int CONTACT_NORMAL_LENGTH = 16;  // pixels, for the debug overlay
+
+    explicit CollisionSystem(EventManager& eventManager);
+    void update(EntityManager& entityManager, const std::vector<Tilemap>& tilemaps = {});
+    bool collideWithTiles(Entity& primaryEntity, const Tilemap& tilemap);
 
     bool checkCollision(Entity& primaryEntity, Entity& otherEntity);
     bool checkCollisionX(Entity& primaryEntity, Entity& otherEntity);
@@ -25,6 +30,9 @@ public:
     void handleCollision(Entity& primaryEntity, Entity& otherEntity);
     void handleCollisionX(Entity& primaryEntity, Entity& otherEntity);
     void handleCollisionY(Entity& primaryEntity, Entity& otherEntity);
+    void handleCollision(Entity& primaryEntity, const SDL_Rect& otherCollider);
+    void handleCollisionX(Entity& primaryEntity, const SDL_Rect& otherCollider);
+    void handleCollisionY(Entity& primaryEntity, const SDL_Rect& otherCollider);
 
     void stopAndRepositionToLeft(Entity& primaryEntity, const SDL_Rect& primaryCollider, const SDL_Rect& otherCollider);
     void stopAndRepositionToRight(Entity& primaryEntity, const SDL_Rect& otherCollider);
@@ -32,6 +40,7 @@ public:
     void stopAndRepositionBelow(Entity& primaryEntity, const SDL_Rect& otherCollider);
 
 private:
+    EventManager& eventManager;
     int collisionBuffer;
 };
 
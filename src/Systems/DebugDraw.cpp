@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <cmath>
+
+#include "DebugDraw.h"
+
+namespace {
+    // M_PI is not part of standard C++
+    constexpr float PI = 3.14159265358979f;
+}
+
+DebugDraw& DebugDraw::getInstance() {
+    static DebugDraw instance;
+    return instance;
+}
+
+void DebugDraw::setEnabled(bool enabled) {
+    /**
+     * Turn the overlay on or off, shapes already collected this frame are dropped when turning it off
+     *
+     * @param enabled: Whether shapes are collected and drawn
+     */
+    this->enabled = enabled;
+    if (!enabled) {
+        clear();
+    }
+}
+
+void DebugDraw::toggle() {
+    setEnabled(!enabled);
+}
+
+bool DebugDraw::isEnabled() const {
+    return enabled;
+}
+
+bool DebugDraw::isEnabled(Channel channel) const {
+    /**
+     * Whether shapes of a channel are drawn, check before computing them
+     *
+     * @param channel: The channel
+     */
+    return enabled && (channels & channel) != 0;
+}
+
+void DebugDraw::setChannels(uint32_t channels) {
+    /**
+     * Choose which channels are drawn while the overlay is enabled
+     *
+     * @param channels: A mask of Channel values
+     */
+    this->channels = channels;
+}
+
+uint32_t DebugDraw::getChannels() const {
+    return channels;
+}
+
+void DebugDraw::rect(const SDL_Rect& rect, SDL_Color color, bool filled) {
+    /**
+     * Queue a rect outline, or a filled rect
+     *
+     * @param rect: The rect in world space
+     * @param color: The colour
+     * @param filled: Fill the rect instead of outlining it
+     */
+    if (!enabled) {
+        return;
+    }
+    rects.push_back({rect, color, filled});
+}
+
+void DebugDraw::line(int x1, int y1, int x2, int y2, SDL_Color color) {
+    /**
+     * Queue a line segment
+     *
+     * @param x1, y1: The start in world space
+     * @param x2, y2: The end in world space
+     * @param color: The colour
+     */
+    if (!enabled) {
+        return;
+    }
+    lines.push_back({x1, y1, x2, y2, color});
+}
+
+void DebugDraw::circle(int centerX, int centerY, int radius, SDL_Color color) {
+    /**
+     * Queue a circle outline as CIRCLE_SEGMENTS line segments
+     *
+     * @param centerX, centerY: The centre in world space
+     * @param radius: The radius in pixels
+     * @param color: The colour
+     */
+    if (!enabled) {
+        return;
+    }
+    const float step = 2.0f * PI / CIRCLE_SEGMENTS;
+    int lastX = centerX + radius;
+    int lastY = centerY;
+    for (int segment = 1; segment <= CIRCLE_SEGMENTS; segment++) {
+        int x = centerX + static_cast<int>(std::lround(radius * std::cos(step * segment)));
+        int y = centerY + static_cast<int>(std::lround(radius * std::sin(step * segment)));
+        lines.push_back({lastX, lastY, x, y, color});
+        lastX = x;
+        lastY = y;
+    }
+}
+
+void DebugDraw::emit(RenderCommandList& commands, const SDL_Rect& cameraRect) {
+    /**
+     * Move this frame's shapes into a command list in screen space, skipping the ones outside the camera,
+     * and start collecting the next frame
+     *
+     * @param commands: The frame's command list
+     * @param cameraRect: The camera in world space
+     */
+    for (const RectCommand& queued : rects) {
+        if (!SDL_HasIntersection(&queued.rect, &cameraRect)) {
+            continue;
+        }
+        RectCommand onScreen = queued;
+        onScreen.rect.x -= cameraRect.x;
+        onScreen.rect.y -= cameraRect.y;
+        commands.rects.push_back(onScreen);
+    }
+    for (const LineCommand& queued : lines) {
+        // bounds of the segment, one pixel wide at least so axis aligned lines are not culled
+        SDL_Rect bounds = {std::min(queued.x1, queued.x2), std::min(queued.y1, queued.y2),
+                           std::abs(queued.x2 - queued.x1) + 1, std::abs(queued.y2 - queued.y1) + 1};
+        if (!SDL_HasIntersection(&bounds, &cameraRect)) {
+            continue;
+        }
+        commands.lines.push_back({queued.x1 - cameraRect.x, queued.y1 - cameraRect.y,
+                                  queued.x2 - cameraRect.x, queued.y2 - cameraRect.y, queued.color});
+    }
+    clear();
+}
+
+void DebugDraw::clear() {
+    rects.clear();
+    lines.clear();
+}
+
+size_t DebugDraw::getRectCount() const {
+    return rects.size();
+}
+
+size_t DebugDraw::getLineCount() const {
+    return lines.size();
+}
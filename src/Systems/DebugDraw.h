@@ -0,0 +1,62 @@
+#pragma once
+#ifndef BUMMERENGINE_DEBUGDRAW_H
+#define BUMMERENGINE_DEBUGDRAW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+#include "RenderCommands.h"
+
+class DebugDraw {
+    /**
+     * Collects debug shapes from any system during a simulation frame
+     *
+     * Shapes are given in world space and handed to the frame's RenderCommandList by RenderSystem, which
+     * drops the ones off camera; DebugDrawBatch then draws them in a handful of batched calls.
+     * Each shape belongs to a channel so one kind can be shown alone. Callers check isEnabled(channel)
+     * before working out shapes, so a disabled overlay costs a branch per call site.
+     * Only used from the simulation thread.
+     */
+public:
+    enum Channel : uint32_t {
+        COLLIDERS = 1 << 0,
+        HITBOXES = 1 << 1,
+        CONTACTS = 1 << 2,
+        BROADPHASE = 1 << 3,
+        AI_RANGES = 1 << 4,
+        ALL_CHANNELS = 0xFFFFFFFF
+    };
+
+    static constexpr int CIRCLE_SEGMENTS = 24;
+
+    static DebugDraw& getInstance();
+
+    void setEnabled(bool enabled);
+    void toggle();
+    bool isEnabled() const;
+    bool isEnabled(Channel channel) const;
+    void setChannels(uint32_t channels);
+    uint32_t getChannels() const;
+
+    void rect(const SDL_Rect& rect, SDL_Color color, bool filled = false);
+    void line(int x1, int y1, int x2, int y2, SDL_Color color);
+    void circle(int centerX, int centerY, int radius, SDL_Color color);
+
+    void emit(RenderCommandList& commands, const SDL_Rect& cameraRect);
+    void clear();
+    size_t getRectCount() const;
+    size_t getLineCount() const;
+
+private:
+    DebugDraw() = default;
+
+    bool enabled = false;
+    uint32_t channels = ALL_CHANNELS;
+    std::vector<RectCommand> rects;  // world space
+    std::vector<LineCommand> lines;  // world space
+};
+
+#endif //BUMMERENGINE_DEBUGDRAW_H
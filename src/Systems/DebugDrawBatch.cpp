@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "DebugDrawBatch.h"
+
+namespace {
+    uint32_t packColor(const SDL_Color& color) {
+        return (static_cast<uint32_t>(color.r) << 24) | (static_cast<uint32_t>(color.g) << 16) |
+               (static_cast<uint32_t>(color.b) << 8) | color.a;
+    }
+
+    bool sameGroup(const RectCommand& a, const RectCommand& b) {
+        return a.filled == b.filled && packColor(a.color) == packColor(b.color);
+    }
+}
+
+int DebugDrawBatch::flush(SDL_Renderer* renderer, const std::vector<RectCommand>& rects, const std::vector<LineCommand>& lines) {
+    /**
+     * Draw debug rects, then lines on top of them
+     *
+     * @param renderer: The SDL renderer
+     * @param rects: Rects in screen space
+     * @param lines: Lines in screen space
+     * @return: The number of draw calls made
+     */
+    int drawCalls = flushRects(renderer, rects);
+
+    if (!lines.empty()) {
+        buildLineGeometry(lines, vertices, indices);
+        SDL_RenderGeometry(renderer, nullptr, vertices.data(), static_cast<int>(vertices.size()),
+                           indices.data(), static_cast<int>(indices.size()));
+        drawCalls++;
+    }
+    return drawCalls;
+}
+
+int DebugDrawBatch::flushRects(SDL_Renderer* renderer, const std::vector<RectCommand>& rects) {
+    /**
+     * Draw rects grouped by colour and fill
+     *
+     * @param renderer: The SDL renderer
+     * @param rects: Rects in screen space
+     * @return: The number of draw calls made
+     */
+    if (rects.empty()) {
+        return 0;
+    }
+    sortedRects.assign(rects.begin(), rects.end());
+    std::stable_sort(sortedRects.begin(), sortedRects.end(), [](const RectCommand& a, const RectCommand& b) {
+        if (a.filled != b.filled) {
+            return !a.filled;
+        }
+        return packColor(a.color) < packColor(b.color);
+    });
+
+    int drawCalls = 0;
+    size_t start = 0;
+    while (start < sortedRects.size()) {
+        const RectCommand& first = sortedRects[start];
+        group.clear();
+        size_t end = start;
+        while (end < sortedRects.size() && sameGroup(sortedRects[end], first)) {
+            group.push_back(sortedRects[end].rect);
+            end++;
+        }
+        SDL_SetRenderDrawColor(renderer, first.color.r, first.color.g, first.color.b, first.color.a);
+        if (first.filled) {
+            SDL_RenderFillRects(renderer, group.data(), static_cast<int>(group.size()));
+        } else {
+            SDL_RenderDrawRects(renderer, group.data(), static_cast<int>(group.size()));
+        }
+        drawCalls++;
+        start = end;
+    }
+    return drawCalls;
+}
+
+void DebugDrawBatch::buildLineGeometry(const std::vector<LineCommand>& lines, std::vector<SDL_Vertex>& vertices, std::vector<int>& indices) {
+    /**
+     * Expand line segments into untextured quads LINE_WIDTH pixels wide, four vertices and six indices each
+     *
+     * @param lines: Lines in screen space
+     * @param vertices: Filled with the quads' corners
+     * @param indices: Filled with two triangles per quad
+     */
+    vertices.clear();
+    indices.clear();
+    const float halfWidth = LINE_WIDTH * 0.5f;
+    for (const LineCommand& line : lines) {
+        // line centres sit on pixel centres, like SDL_RenderDrawLine
+        float x1 = static_cast<float>(line.x1) + 0.5f;
+        float y1 = static_cast<float>(line.y1) + 0.5f;
+        float x2 = static_cast<float>(line.x2) + 0.5f;
+        float y2 = static_cast<float>(line.y2) + 0.5f;
+        float dx = x2 - x1;
+        float dy = y2 - y1;
+        float length = std::sqrt(dx * dx + dy * dy);
+        if (length == 0.0f) {
+            // a point, draw a pixel sized square
+            dx = 1.0f;
+            dy = 0.0f;
+            length = 1.0f;
+            x1 -= halfWidth;
+            x2 = x1 + LINE_WIDTH;
+        }
+        // half width perpendicular to the line
+        float nx = -dy / length * halfWidth;
+        float ny = dx / length * halfWidth;
+
+        int base = static_cast<int>(vertices.size());
+        vertices.push_back({{x1 + nx, y1 + ny}, line.color, {0.0f, 0.0f}});
+        vertices.push_back({{x2 + nx, y2 + ny}, line.color, {0.0f, 0.0f}});
+        vertices.push_back({{x2 - nx, y2 - ny}, line.color, {0.0f, 0.0f}});
+        vertices.push_back({{x1 - nx, y1 - ny}, line.color, {0.0f, 0.0f}});
+        indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+#ifndef BUMMERENGINE_DEBUGDRAWBATCH_H
+#define BUMMERENGINE_DEBUGDRAWBATCH_H
+
+#include <cstddef>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+#include "RenderCommands.h"
+
+class DebugDrawBatch {
+    /**
+     * Draws a frame's debug rects and lines in as few calls as possible
+     *
+     * Rects are grouped by colour and fill, one SDL_RenderDrawRects or SDL_RenderFillRects call per group.
+     * Lines are expanded into thin quads carrying their colour per vertex and drawn with a single SDL_RenderGeometry call.
+     * Debug shapes have no meaningful order between them, so grouping does not change the picture.
+     * Scratch buffers are kept between frames so steady state drawing does not allocate.
+     */
+public:
+    static constexpr float LINE_WIDTH = 1.0f;
+
+    int flush(SDL_Renderer* renderer, const std::vector<RectCommand>& rects, const std::vector<LineCommand>& lines);
+    static void buildLineGeometry(const std::vector<LineCommand>& lines, std::vector<SDL_Vertex>& vertices, std::vector<int>& indices);
+
+private:
+    int flushRects(SDL_Renderer* renderer, const std::vector<RectCommand>& rects);
+
+    std::vector<RectCommand> sortedRects;
+    std::vector<SDL_Rect> group;
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+};
+
+#endif //BUMMERENGINE_DEBUGDRAWBATCH_H
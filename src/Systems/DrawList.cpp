@@ -0,0 +1,60 @@
+#include <algorithm>
+#include <iterator>
+
+#include "DrawList.h"
+
+void DrawList::clear() {
+    items.clear();
+}
+
+void DrawList::add(uint64_t key, int entityIndex) {
+    items.push_back({key, entityIndex});
+}
+
+void DrawList::sort() {
+    /**
+     * LSD radix sort on the key, one byte per pass
+     * Passes where every item has the same byte are skipped, which is most of them in a typical frame
+     */
+    scratch.resize(items.size());
+    for (int shift = 0; shift < 64; shift += 8) {
+        size_t counts[256] = {};
+        for (const DrawItem& item : items) {
+            counts[(item.key >> shift) & 0xFF]++;
+        }
+        if (std::find(std::begin(counts), std::end(counts), items.size()) != std::end(counts)) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (size_t& count : counts) {
+            size_t bucketSize = count;
+            count = offset;
+            offset += bucketSize;
+        }
+        for (const DrawItem& item : items) {
+            scratch[counts[(item.key >> shift) & 0xFF]++] = item;
+        }
+        items.swap(scratch);
+    }
+}
+
+const std::vector<DrawItem>& DrawList::getItems() const {
+    return items;
+}
+
+uint64_t DrawList::makeSortKey(int layer, int depth, uint32_t textureId, uint8_t material) {
+    /**
+     * Pack the draw order fields into a sort key
+     * Layer and depth are signed and biased so negative values sort before positive ones
+     *
+     * @param layer: The render layer, clamped to [-128, 127]
+     * @param depth: Order within the layer, clamped to [-32768, 32767]
+     * @param textureId: A small id for the texture, only the low 24 bits are used
+     * @param material: Blend/shader variant, 0 for plain sprites
+     */
+    uint64_t biasedLayer = static_cast<uint64_t>(std::clamp(layer, -128, 127) + 128);
+    uint64_t biasedDepth = static_cast<uint64_t>(std::clamp(depth, -32768, 32767) + 32768);
+    return (biasedLayer << 56) | (biasedDepth << 40) | (static_cast<uint64_t>(textureId & 0xFFFFFF) << 16)
+           | (static_cast<uint64_t>(material) << 8);
+}
@@ -0,0 +1,36 @@
+#pragma once
+#ifndef BUMMERENGINE_DRAWLIST_H
+#define BUMMERENGINE_DRAWLIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct DrawItem {
+    uint64_t key;
+    int entityIndex;
+};
+
+class DrawList {
+    /**
+     * The sprites to draw this frame, ordered by a 64 bit sort key
+     *
+     * Key layout, most significant first:
+     *   layer (8 bits) | depth (16 bits) | texture id (24 bits) | material (8 bits) | unused (8 bits)
+     * so sprites are drawn by layer, then depth, and sprites sharing a texture end up next to each other.
+     * Sorting is stable, so items with equal keys keep the order they were added in.
+     */
+public:
+    void clear();
+    void add(uint64_t key, int entityIndex);
+    void sort();
+    const std::vector<DrawItem>& getItems() const;
+
+    static uint64_t makeSortKey(int layer, int depth, uint32_t textureId, uint8_t material);
+
+private:
+    std::vector<DrawItem> items;
+    std::vector<DrawItem> scratch;
+};
+
+#endif //BUMMERENGINE_DRAWLIST_H
@@ -6,6 +6,7 @@
 #include <SDL2/SDL.h>
 
 #include "InputSystem.h"
+#include "DebugDraw.h"
 #include "../Utils.h"
 #include "../Config.h"
 
@@ -65,17 +66,36 @@ void InputSystem::loadControllerMap(const std::string& filePath) {
 
 void InputSystem::update(EntityManager &entityManager, bool &start_menu) {
     /**
-     * Update the input system
+     * Update the input system from the SDL event queue
      *
      * @param entityManager: The entity manager
      * @param quit: The quit flag
      */
+    std::vector<SDL_Event> events;
+    SDL_Event e;
+    while (SDL_PollEvent(&e) != 0) {
+        events.push_back(e);
+    }
+    update(entityManager, start_menu, events);
+}
+
+void InputSystem::update(EntityManager &entityManager, bool &start_menu, const std::vector<SDL_Event>& events) {
+    /**
+     * Update the input system from events polled elsewhere, e.g. by the render thread
+     *
+     * @param entityManager: The entity manager
+     * @param quit: The quit flag
+     * @param events: The events since the last update, oldest first
+     */
 
     clearPreviousInputs(entityManager);
 
-    SDL_Event e;
     Entity player = entityManager.getPlayer();
-    while (SDL_PollEvent(&e) != 0) {
+    for (SDL_Event e : events) {
+        if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F1 && e.key.repeat == 0) {
+            DebugDraw::getInstance().toggle();
+            continue;
+        }
         if (e.type == SDL_QUIT || (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_ESCAPE)) {
             start_menu = true;
             break;
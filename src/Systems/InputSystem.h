@@ -2,12 +2,15 @@
 #ifndef BUMMERENGINE_INPUTSYSTEM_H
 #define BUMMERENGINE_INPUTSYSTEM_H
 
+#include <vector>
+
 #include "../ECS/EntityManager.h"
 
 class InputSystem {
 public:
     InputSystem();
     void update(EntityManager& entityManager, bool& quit);
+    void update(EntityManager& entityManager, bool& quit, const std::vector<SDL_Event>& events);
 
 private:
     std::unordered_map<SDL_Scancode, Action> scancodeMap;
@@ -1,13 +1,22 @@
 #include "MovementSystem.h"
 
 #include <algorithm>
-#include <iostream>
+#include <cmath>
 
 #include "../ECS/Components.h"
 #include "../ECS/EventManager.h"
 #include "../ECS/StateMachine.h"
+#include "../Logger.h"
 #include "../Utils.h"
 
+MovementSystem::MovementSystem(EventManager& eventManager) : eventManager(eventManager) {
+    /**
+     * Constructor for the MovementSystem
+     *
+     * @param eventManager: The event bus movement events are published on
+     */
+}
+
 void MovementSystem::handleIntent(EntityManager& entityManager, float deltaTime){
     for (Entity& entity: entityManager.getEntities()) {
         if (entity.hasComponent<Intent>()) {
@@ -19,13 +28,13 @@ void MovementSystem::handleIntent(EntityManager& entityManager, float deltaTime)
 
                 // handle movement in x direction
                 if (intent.direction == Direction::LEFT) {
-                    EventManager::getInstance().publish("moveLeft", {&entity});
+                    eventManager.publish("moveLeft", {&entity});
                     velocity.dx = -velocity.speed;
                 } else if (intent.direction == Direction::RIGHT) {
-                    EventManager::getInstance().publish("moveRight", {&entity});
+                    eventManager.publish("moveRight", {&entity});
                     velocity.dx = velocity.speed;
                 } else {
-                    EventManager::getInstance().publish("idle", {&entity});
+                    eventManager.publish("idle", {&entity});
                     velocity.dx = 0;
                 }
                 if (velocity.dx != 0) {
@@ -44,7 +53,7 @@ void MovementSystem::handleIntent(EntityManager& entityManager, float deltaTime)
                     velocity.dy = 0;
                 }
                 // if (velocity.dy != 0) {
-                //     EventManager::getInstance().publish("airborne", {&entity});
+                //     eventManager.publish("airborne", {&entity});
                 // }
 
                 // handle dash
@@ -94,7 +103,7 @@ void MovementSystem::jump(Entity& entity) {
             jumps.jumps++;
             gravity.gravity = gravity.baseGravity;
             velocity.dy = -jumps.jumpVelocity;
-            EventManager::getInstance().publish("jump", {&entity});
+            eventManager.publish("jump", {&entity});
         }
     }
 }
@@ -106,12 +115,12 @@ void MovementSystem::dash(Entity& entity, float deltaTime) {
         Velocity& velocity = entity.getComponent<Velocity>();
         if (!dash.isDashing && dash.currentCooldown <= 0) {
             dash.isDashing = true;
-            EventManager::getInstance().publish("dash", {&entity});
+            eventManager.publish("dash", {&entity});
             // Set a specific velocity for the dash
             // TODO: magic numbers
             if (std::abs(input.joystickDirection.first) > 0.2 || std::abs(input.joystickDirection.second) > 0.2) {
                 // If the joystick is being used, dash in the direction of the joystick
-                std::cout << "Input value: " << input.joystickDirection.first << ", " << input.joystickDirection.second << std::endl;
+                LOG_DEBUG("input", "Dash joystick direction: " << input.joystickDirection.first << ", " << input.joystickDirection.second);
                 velocity.dx = input.joystickDirection.first * dash.speed;
                 velocity.dy = input.joystickDirection.second * dash.speed;
             } else {
@@ -137,7 +146,7 @@ void MovementSystem::dash(Entity& entity, float deltaTime) {
         if (dash.isDashing) {
             dash.currentDuration -= deltaTime;
             if (dash.currentDuration <= 0) {
-                EventManager::getInstance().publish("dashEnd", {&entity});
+                eventManager.publish("dashEnd", {&entity});
                 dash.isDashing = false;
                 dash.currentCooldown = dash.initCooldown; // Reset cooldown
                 dash.currentDuration = dash.initDuration; // Reset duration
@@ -3,15 +3,20 @@
 #define BUMMERENGINE_MOVEMENTSYSTEM_H
 
 #include "../ECS/EntityManager.h"
+#include "../ECS/EventManager.h"
 
 
 class MovementSystem {
 public:
+    explicit MovementSystem(EventManager& eventManager);
     void handleIntent(EntityManager& entityManager, float deltaTime);
     void move(EntityManager& entityManager);
     void jump(Entity& entity);
     void dash(Entity& entity, float deltaTime);
     void applyGravity(Entity& entity);
+
+private:
+    EventManager& eventManager;
 };
 
 
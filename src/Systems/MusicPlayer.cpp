@@ -0,0 +1,257 @@
+#include <algorithm>
+#include <utility>
+
+#include "MusicPlayer.h"
+#include "../Logger.h"
+
+MusicPlayer::Track::~Track() {
+    if (converter != nullptr) {
+        SDL_FreeAudioStream(converter);
+    }
+}
+
+MusicPlayer::MusicPlayer(int frequency, SDL_AudioFormat format, int channels)
+    : frequency(frequency), format(format), channels(channels), installed(false) {
+    /**
+     * Constructor for the MusicPlayer, tracks are converted to the given output format
+     *
+     * @param frequency: The mixer's sample rate
+     * @param format: The mixer's sample format
+     * @param channels: The mixer's channel count
+     */
+    bytesPerFrame = std::max(1, static_cast<int>(SDL_AUDIO_BITSIZE(format) / 8) * channels);
+    // big enough for the usual callback, so the audio thread does not allocate
+    scratch.resize(READ_BYTES * 2);
+    bufferBytes = std::max(frequency / 1000 * BUFFER_MS * bytesPerFrame, static_cast<int>(scratch.size()) * 2);
+}
+
+MusicPlayer::~MusicPlayer() {
+    if (installed) {
+        Mix_HookMusic(nullptr, nullptr);
+    }
+}
+
+void MusicPlayer::install() {
+    /**
+     * Start mixing the tracks into the mixer's output, this takes over SDL_mixer's music hook
+     */
+    Mix_HookMusic(&MusicPlayer::mixCallback, this);
+    installed = true;
+}
+
+bool MusicPlayer::play(Layer layer, const std::string& path, int volume, int fadeMs) {
+    /**
+     * Crossfade a layer to a new looping track
+     *
+     * @param layer: The layer, its current track fades out over the same time
+     * @param path: The WAV file
+     * @param volume: 0 to MIX_MAX_VOLUME
+     * @param fadeMs: How long the crossfade takes, 0 to cut
+     * @return: false if the file could not be streamed, the current track then keeps playing
+     */
+    std::string current = getPath(layer);
+    if (current == path) {
+        return true;
+    }
+    auto track = std::make_unique<Track>();
+    if (!track->wav.open(path)) {
+        return false;
+    }
+    track->converter = SDL_NewAudioStream(track->wav.getFormat(), static_cast<Uint8>(track->wav.getChannels()),
+                                          track->wav.getFrequency(), format, static_cast<Uint8>(channels), frequency);
+    if (track->converter == nullptr) {
+        LOG_ERROR("sound", "Stream: " << path << " cannot be converted: " << SDL_GetError());
+        return false;
+    }
+    track->path = path;
+    track->layer = layer;
+    track->target = static_cast<float>(volume);
+    track->gain = fadeMs > 0 ? 0.0f : track->target;
+    track->gainPerMs = fadeMs > 0 ? track->target / static_cast<float>(fadeMs) : 0.0f;
+    // read ahead now so the track starts with a full buffer, it is not shared with the audio thread yet
+    fill(*track, bufferBytes);
+
+    lock();
+    std::vector<std::unique_ptr<Track>> finished = takeFinished();
+    fadeOut(layer, fadeMs);
+    tracks.push_back(std::move(track));
+    unlock();
+    return true;
+}
+
+void MusicPlayer::stop(Layer layer, int fadeMs) {
+    /**
+     * Fade a layer out to silence
+     *
+     * @param layer: The layer
+     * @param fadeMs: How long the fade takes, 0 to cut
+     */
+    lock();
+    std::vector<std::unique_ptr<Track>> finished = takeFinished();
+    fadeOut(layer, fadeMs);
+    unlock();
+}
+
+void MusicPlayer::update() {
+    /**
+     * Read ahead for every track and close the ones that finished
+     * Call once per frame from the thread that plays and stops tracks, the files are only read here
+     */
+    for (auto& track : tracks) {
+        fill(*track, bufferBytes);
+    }
+    lock();
+    std::vector<std::unique_ptr<Track>> finished = takeFinished();
+    unlock();
+}
+
+void MusicPlayer::mix(Uint8* stream, int length) {
+    /**
+     * Add the next block of every track to the output, called on the audio thread once installed
+     *
+     * @param stream: The output, in the mixer's format
+     * @param length: Its size in bytes
+     */
+    // scratch is sized once in the constructor, longer callbacks are mixed in pieces that fit it
+    int piece = std::max(bytesPerFrame, static_cast<int>(scratch.size()) / bytesPerFrame * bytesPerFrame);
+    for (int offset = 0; offset < length; offset += piece) {
+        mixBlock(stream + offset, std::min(piece, length - offset));
+    }
+}
+
+void MusicPlayer::mixBlock(Uint8* stream, int length) {
+    float blockMs = static_cast<float>(length / bytesPerFrame) * 1000.0f / static_cast<float>(frequency);
+    for (auto& track : tracks) {
+        if (track->finished) {
+            continue;
+        }
+        // only takes what update() converted, anything missing on a slow frame plays as silence
+        int got = SDL_AudioStreamGet(track->converter, scratch.data(), length);
+        // the gain ramps once per block, the block is mixed at its average
+        float start = track->gain;
+        if (track->gainPerMs <= 0.0f) {
+            track->gain = track->target;
+        } else if (track->gain < track->target) {
+            track->gain = std::min(track->target, track->gain + track->gainPerMs * blockMs);
+        } else {
+            track->gain = std::max(track->target, track->gain - track->gainPerMs * blockMs);
+        }
+        int volume = static_cast<int>((start + track->gain) / 2.0f + 0.5f);
+        if (got > 0) {
+            SDL_MixAudioFormat(stream, scratch.data(), format, static_cast<Uint32>(got), std::min(volume, SDL_MIX_MAXVOLUME));
+        }
+        if (track->target <= 0.0f && track->gain <= 0.0f) {
+            track->finished = true;
+        }
+    }
+}
+
+std::string MusicPlayer::getPath(Layer layer) {
+    /**
+     * The track a layer is playing or fading in, empty if none
+     */
+    lock();
+    std::string path;
+    for (const auto& track : tracks) {
+        if (track->layer == layer && !track->finished && track->target > 0.0f) {
+            path = track->path;
+        }
+    }
+    unlock();
+    return path;
+}
+
+size_t MusicPlayer::getTrackCount() {
+    /**
+     * The number of tracks still playing, including ones fading out
+     */
+    lock();
+    size_t count = std::count_if(tracks.begin(), tracks.end(), [](const auto& track) {
+        return !track->finished;
+    });
+    unlock();
+    return count;
+}
+
+void MusicPlayer::mixCallback(void* player, Uint8* stream, int length) {
+    static_cast<MusicPlayer*>(player)->mix(stream, length);
+}
+
+void MusicPlayer::fadeOut(Layer layer, int fadeMs) {
+    for (auto& track : tracks) {
+        if (track->layer != layer || track->finished || track->target <= 0.0f) {
+            continue;
+        }
+        track->target = 0.0f;
+        if (fadeMs <= 0) {
+            track->finished = true;
+        } else {
+            track->gainPerMs = track->gain / static_cast<float>(fadeMs);
+        }
+    }
+}
+
+std::vector<std::unique_ptr<MusicPlayer::Track>> MusicPlayer::takeFinished() {
+    /**
+     * Take the finished tracks out of the list, called with the lock held
+     * The caller destroys them once unlocked, so closing their files never holds up the audio thread
+     */
+    std::vector<std::unique_ptr<Track>> finished;
+    for (auto& track : tracks) {
+        if (track->finished) {
+            finished.push_back(std::move(track));
+        }
+    }
+    tracks.erase(std::remove(tracks.begin(), tracks.end(), nullptr), tracks.end());
+    return finished;
+}
+
+void MusicPlayer::fill(Track& track, int length) {
+    /**
+     * Read from the file until the converter holds at least length bytes of output, looping at the end
+     * The file is read without the lock, only handing each block to the converter waits for the audio thread
+     *
+     * @param track: The track, finished if nothing can be read even from the start of its file
+     * @param length: The output to have ready, in bytes
+     */
+    Uint8 buffer[READ_BYTES];
+    bool rewound = false;
+    while (true) {
+        lock();
+        bool full = track.finished || SDL_AudioStreamAvailable(track.converter) >= length;
+        unlock();
+        if (full) {
+            return;
+        }
+        size_t read = track.wav.read(buffer, READ_BYTES);
+        if (read == 0) {
+            if (rewound) {
+                // the file is empty or unreadable
+                lock();
+                track.finished = true;
+                unlock();
+                return;
+            }
+            track.wav.rewind();
+            rewound = true;
+            continue;
+        }
+        rewound = false;
+        lock();
+        SDL_AudioStreamPut(track.converter, buffer, static_cast<int>(read));
+        unlock();
+    }
+}
+
+void MusicPlayer::lock() {
+    // the mixer opens its own device, SDL_LockAudio would only lock the legacy one the callback does not run on
+    if (installed) {
+        Mix_LockAudio();
+    }
+}
+
+void MusicPlayer::unlock() {
+    if (installed) {
+        Mix_UnlockAudio();
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+#ifndef BUMMERENGINE_MUSICPLAYER_H
+#define BUMMERENGINE_MUSICPLAYER_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include "../Resources/WavStream.h"
+
+class MusicPlayer {
+    /**
+     * Streams music and ambience tracks from disk and crossfades between them
+     *
+     * Each layer plays one looping track. Starting another track on a layer fades the old one out while the new one
+     * fades in, both streams play during the overlap. update() reads a few kilobytes ahead from each file once per
+     * frame and converts them to the mixer's output format, so a track never sits in memory as a whole. SDL_mixer's
+     * music hook only mixes what is already converted, it never waits on the disk. Sound effects keep playing on
+     * the mixer's channels on top.
+     */
+public:
+    enum Layer {
+        MUSIC,
+        AMBIENCE,
+        LAYER_COUNT
+    };
+
+    static constexpr int DEFAULT_FADE_MS = 1500;
+    static constexpr size_t READ_BYTES = 8192;
+    static constexpr int BUFFER_MS = 250;  // output converted ahead of the audio thread, covers a slow frame
+
+    MusicPlayer(int frequency, SDL_AudioFormat format, int channels);
+    ~MusicPlayer();
+    MusicPlayer(const MusicPlayer&) = delete;
+    MusicPlayer& operator=(const MusicPlayer&) = delete;
+
+    void install();
+    bool play(Layer layer, const std::string& path, int volume, int fadeMs = DEFAULT_FADE_MS);
+    void stop(Layer layer, int fadeMs = DEFAULT_FADE_MS);
+    void update();
+    void mix(Uint8* stream, int length);
+    std::string getPath(Layer layer);
+    size_t getTrackCount();
+
+private:
+    struct Track {
+        ~Track();
+
+        std::string path;
+        Layer layer;
+        WavStream wav;
+        SDL_AudioStream* converter = nullptr;
+        float gain = 0.0f;
+        float target = 0.0f;
+        float gainPerMs = 0.0f;  // how fast gain moves toward target
+        bool finished = false;
+    };
+
+    static void mixCallback(void* player, Uint8* stream, int length);
+    void fadeOut(Layer layer, int fadeMs);
+    std::vector<std::unique_ptr<Track>> takeFinished();
+    void mixBlock(Uint8* stream, int length);
+    void fill(Track& track, int length);
+    void lock();
+    void unlock();
+
+    int frequency;
+    SDL_AudioFormat format;
+    int channels;
+    int bytesPerFrame;
+    int bufferBytes;
+    bool installed;
+    std::vector<std::unique_ptr<Track>> tracks;  // changed by the caller's thread only, under lock() as mix() reads it
+    std::vector<Uint8> scratch;                  // only touched by mix()
+};
+
+#endif //BUMMERENGINE_MUSICPLAYER_H
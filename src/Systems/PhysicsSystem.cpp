@@ -2,10 +2,15 @@
 #include "../ECS/EventManager.h"
 #include "../Config.h"
 
+PhysicsSystem::PhysicsSystem(EventManager& eventManager) : eventManager(eventManager) {}
+
 void PhysicsSystem::update(SceneManager& sceneManager, EntityManager& entityManager, MovementSystem& movementSystem, CollisionSystem& collisionSystem, float deltaTime) {
     movementSystem.handleIntent(entityManager, deltaTime);
     movementSystem.move(entityManager);
-    collisionSystem.update(entityManager);
+    collisionSystem.update(entityManager, sceneManager.getTilemaps());
+
+    // sync point: dispatch collision events while the entities they point to are still valid
+    eventManager.flush();
 
     // reset player position if it falls off the screen
     Entity player = entityManager.getPlayer();
@@ -13,10 +18,10 @@ void PhysicsSystem::update(SceneManager& sceneManager, EntityManager& entityMana
         player.getComponent<Transform>().y = 50;
         player.getComponent<Transform>().x = VIRTUAL_WIDTH / 2 - 20;
         player.getComponent<Velocity>().dy = 0;
-        EventManager::getInstance().publish("died", {&player});
+        eventManager.publish("died", {&player});
+        // the next scene was prefetched while this one played, switching to it reads nothing from disk
         sceneManager.nextScene();
-        SDL_Delay(800);
-        EventManager::getInstance().publish("spawn", {&player});
+        eventManager.publish("spawn", {&player});
         SDL_Delay(200);
     }
 }
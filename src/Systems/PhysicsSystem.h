@@ -3,6 +3,7 @@
 #define BUMMERENGINE_PHYSICSSYSTEM_H
 
 #include "../ECS/EntityManager.h"
+#include "../ECS/EventManager.h"
 #include "../ECS/SceneManager.h"
 #include "MovementSystem.h"
 #include "CollisionSystem.h"
@@ -10,8 +11,11 @@
 
 class PhysicsSystem {
 public:
+    explicit PhysicsSystem(EventManager& eventManager);
     void update(SceneManager& sceneManager, EntityManager& entityManager, MovementSystem& movementSystem, CollisionSystem& collisionSystem, float deltaTime);
 
+private:
+    EventManager& eventManager;
 };
 
 
@@ -0,0 +1,66 @@
+#pragma once
+#ifndef BUMMERENGINE_RENDERCOMMANDS_H
+#define BUMMERENGINE_RENDERCOMMANDS_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+#include "../ECS/Tilemap.h"
+
+struct SpriteCommand {
+    SDL_Texture* texture;
+    SDL_Rect srcRect;
+    SDL_Rect destRect;  // screen space
+    SDL_RendererFlip flip;
+};
+
+struct RectCommand {
+    SDL_Rect rect;  // screen space
+    SDL_Color color;
+    bool filled;
+};
+
+struct LineCommand {
+    int x1;
+    int y1;
+    int x2;
+    int y2;
+    SDL_Color color;
+};
+
+struct TextCommand {
+    std::string text;
+    SDL_Color color;
+    int x;
+    int y;
+};
+
+struct RenderCommandList {
+    /**
+     * Everything needed to draw one frame, written by the simulation and only read once submitted
+     *
+     * Holds no references into the entity manager, so the simulation can move on to the next frame
+     * while this one is drawn. Sprites are in draw order, rects, lines and text are drawn on top of them.
+     */
+    SDL_Color clearColor = {0, 0, 0, 255};
+    SDL_Rect cameraRect = {0, 0, 0, 0};
+    std::shared_ptr<const std::vector<Tilemap>> tilemaps;
+    std::vector<SpriteCommand> sprites;
+    std::vector<RectCommand> rects;
+    std::vector<LineCommand> lines;
+    std::vector<TextCommand> texts;
+
+    void clear() {
+        // keeps the vectors' capacity for the next frame
+        tilemaps.reset();
+        sprites.clear();
+        rects.clear();
+        lines.clear();
+        texts.clear();
+    }
+};
+
+#endif //BUMMERENGINE_RENDERCOMMANDS_H
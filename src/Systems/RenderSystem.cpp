@@ -1,99 +1,252 @@
+#include <algorithm>
+#include <utility>
+
 #include "RenderSystem.h"
 #include "../ECS/Components.h"
 #include "../UI/SplashScreen.h"
 #include "../Config.h"
 #include "../Utils.h"
 
-RenderSystem::RenderSystem() : camera() {
+RenderSystem::RenderSystem() : camera(), staticSprites(GRID_CELL_SIZE), indexedVersion(0), indexBuilt(false), renderTargetsReset(false) {
     // Initialize any other members if necessary
 }
 
-void RenderSystem::render(SDL_Renderer* renderer, EntityManager& entityManager, TTF_Font* font) {
-    SDL_SetRenderDrawColor(renderer, 36, 188, 148, 255);  // bb_green
+RenderSystem::~RenderSystem() {
+    // a no-op unless watchRendererEvents() was called
+    SDL_DelEventWatch(onEvent, this);
+}
+
+void RenderSystem::watchRendererEvents() {
+    /**
+     * Watch the SDL event queue for renderer resets
+     * A watch sees every event as it is queued, whoever polls it later, the start menu included
+     */
+    SDL_AddEventWatch(onEvent, this);
+}
+
+void RenderSystem::handleRendererEvent(const SDL_Event& event) {
+    /**
+     * Note that render target contents were lost, the baked tilemap chunks are redrawn by the next execute()
+     * May be called from any thread
+     *
+     * @param event: An SDL event, anything but SDL_RENDER_TARGETS_RESET is ignored
+     */
+    if (event.type == SDL_RENDER_TARGETS_RESET) {
+        renderTargetsReset = true;
+    }
+}
+
+int RenderSystem::onEvent(void* renderSystem, SDL_Event* event) {
+    static_cast<RenderSystem*>(renderSystem)->handleRendererEvent(*event);
+    return 0;
+}
+
+void RenderSystem::render(SDL_Renderer* renderer, EntityManager& entityManager, std::shared_ptr<const std::vector<Tilemap>> tilemaps, TTF_Font* font) {
+    /**
+     * Build and draw a frame on the calling thread, without presenting it
+     *
+     * @param renderer: The SDL renderer
+     * @param entityManager: The entity manager
+     * @param tilemaps: The tilemaps of the current scene
+     * @param font: The font used by text commands
+     */
+    buildCommands(entityManager, std::move(tilemaps), frameCommands);
+    execute(renderer, frameCommands, font);
+    frameCommands.clear();
+}
+
+void RenderSystem::buildCommands(EntityManager& entityManager, std::shared_ptr<const std::vector<Tilemap>> tilemaps, RenderCommandList& commands) {
+    /**
+     * Write the draw commands for the current state of the world
+     * Reads entities but never the renderer, so it can run on the simulation thread
+     *
+     * @param entityManager: The entity manager
+     * @param tilemaps: The tilemaps of the current scene, kept alive by the list until it is drawn
+     * @param commands: An empty command list to fill
+     */
     Entity& player = entityManager.getPlayer();
     camera.center_on_object(player.getColliderRect(), SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
 
-    for (Entity &entity : entityManager.getEntities()) {
-        if (entity.hasComponent<Transform>() && entity.hasComponent<Collider>() && entity.hasComponent<Sprite>()) {
-            Transform &transform = entity.getComponent<Transform>();
-            Collider &col = entity.getComponent<Collider>();
-            Sprite &spr = entity.getComponent<Sprite>();
-
-            // Visual Debugging
-//            if (entity.hasComponent<State>()) {
-//                auto& state = entity.getComponent<State>();
-//                std::string stateStr = Utils::playerStateToString(state.state); // Assuming you have such a function
-//                SDL_Color color = {255, 255, 255}; // White color for text
-//                render_text(renderer, font, stateStr, color, transform.x, transform.y + 20); // Assuming you have such a function
-//            }
-
-            int scaledW = static_cast<int>(spr.srcRect.w * transform.scale);
-            int scaledH = static_cast<int>(spr.srcRect.h * transform.scale);
-            SDL_Rect destRect = {transform.x - camera.getCameraRect().x, transform.y - camera.getCameraRect().y, scaledW, scaledH};
-            if (entity.hasComponent<Velocity>()) {
-                SDL_RendererFlip flip = (entity.getComponent<Velocity>().direction == -1) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
-                SDL_RenderCopyEx(renderer, spr.texture, &spr.srcRect, &destRect, 0.0, nullptr, flip);
-            }
-            else {
-                SDL_RenderCopy(renderer, spr.texture, &spr.srcRect, &destRect);
-            }
+    SDL_Rect cameraRect = camera.getCameraRect();
+    SDL_Rect view = {cameraRect.x - CULL_MARGIN, cameraRect.y - CULL_MARGIN, cameraRect.w + 2 * CULL_MARGIN, cameraRect.h + 2 * CULL_MARGIN};
+    std::vector<Entity>& entities = entityManager.getEntities();
+
+    commands.clearColor = {124, 200, 255, 255};  // sky blue
+    commands.cameraRect = cameraRect;
+    commands.tilemaps = std::move(tilemaps);
+
+    // order by layer, depth then texture; entities without a RenderLayer are on layer 0
+    drawList.clear();
+    for (int index : collectVisibleEntities(entityManager, view)) {
+        Entity& entity = entities[index];
+        int layer = 0;
+        int depth = 0;
+        if (entity.hasComponent<RenderLayer>()) {
+            RenderLayer& renderLayer = entity.getComponent<RenderLayer>();
+            layer = renderLayer.layer;
+            depth = renderLayer.depth;
         }
+        // handles are small and stable, an atlas page has one handle for every image packed on it
+        drawList.add(DrawList::makeSortKey(layer, depth, entity.getComponent<Sprite>().drawnHandle, 0), index);
     }
+    drawList.sort();
+
+    for (const DrawItem& item : drawList.getItems()) {
+        Entity& entity = entities[item.entityIndex];
+        Transform &transform = entity.getComponent<Transform>();
+        Sprite &spr = entity.getComponent<Sprite>();
+
+        // Visual Debugging
+//        if (entity.hasComponent<State>()) {
+//            auto& state = entity.getComponent<State>();
+//            std::string stateStr = Utils::playerStateToString(state.state); // Assuming you have such a function
+//            SDL_Color color = {255, 255, 255}; // White color for text
+//            commands.texts.push_back({stateStr, color, transform.x - cameraRect.x, transform.y - cameraRect.y + 20});
+//        }
+
+        int scaledW = static_cast<int>(spr.srcRect.w * transform.scale);
+        int scaledH = static_cast<int>(spr.srcRect.h * transform.scale);
+        SDL_Rect destRect = {transform.x - cameraRect.x, transform.y - cameraRect.y, scaledW, scaledH};
+        SDL_RendererFlip flip = SDL_FLIP_NONE;
+        if (entity.hasComponent<Velocity>() && entity.getComponent<Velocity>().direction == -1) {
+            flip = SDL_FLIP_HORIZONTAL;
+        }
+        commands.sprites.push_back({spr.texture, spr.srcRect, destRect, flip});
+    }
+
+    drawDebugShapes(entityManager, visibleEntities);
+    DebugDraw::getInstance().emit(commands, cameraRect);
 }
 
-void RenderSystem::render_hitboxes(EntityManager &entityManager, SDL_Renderer *renderer) {
+void RenderSystem::execute(SDL_Renderer* renderer, const RenderCommandList& commands, TTF_Font* font) {
     /**
-     * Render all active hitboxes for all entities
+     * Draw a command list: clear, tilemaps, sprites, then rects, lines and text on top
+     * Must run on the thread that owns the renderer; presenting is left to the caller
      *
      * @param renderer: The SDL renderer
-     * @param entityManager: The entity manager
+     * @param commands: The frame to draw
+     * @param font: The font used by text commands
      */
+    if (renderTargetsReset.exchange(false)) {
+        tilemapRenderer.invalidate();
+    }
 
-    for (Entity& entity : entityManager.getEntities()) {
-        if (entity.hasComponent<AttackMap>()) {
-            for (auto& [name, attackInfo] : entity.getComponent<AttackMap>().attacks) {
-                if (attackInfo.isActive) {
-                    Hitbox& hitbox = attackInfo.hitbox;
-                    SDL_Rect hitboxRect = entity.getHitboxRect(hitbox);
-                    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-                    SDL_RenderDrawRect(renderer, &hitboxRect);
-                }
-            }
+    SDL_SetRenderDrawColor(renderer, commands.clearColor.r, commands.clearColor.g, commands.clearColor.b, commands.clearColor.a);
+    SDL_RenderClear(renderer);
+
+    // tilemaps are level backdrop, drawn under every sprite
+    if (commands.tilemaps) {
+        tilemapRenderer.render(renderer, *commands.tilemaps, commands.cameraRect);
+    }
+
+    spriteBatch.begin();
+    for (const SpriteCommand& sprite : commands.sprites) {
+        spriteBatch.draw(sprite.texture, sprite.srcRect, sprite.destRect, sprite.flip);
+    }
+    spriteBatch.flush(renderer);
+
+    debugBatch.flush(renderer, commands.rects, commands.lines);
+
+    if (!commands.texts.empty() && font != nullptr) {
+        if (!fontCache) {
+            fontCache = std::make_unique<FontCache>(renderer, font);
+        }
+        for (const TextCommand& text : commands.texts) {
+            fontCache->drawText(text.text, text.color, text.x, text.y);
         }
     }
 }
 
-void RenderSystem::render_all_colliders(EntityManager& entityManager, SDL_Renderer* renderer) {
+const std::vector<int>& RenderSystem::collectVisibleEntities(EntityManager& entityManager, const SDL_Rect& view) {
     /**
-     * Render all colliders for all entities
+     * Find the drawable entities whose sprite overlaps the view
+     * Static sprites come from the spatial grid, movable ones are few and tested directly
+     * Indices are returned in entity order, which breaks ties between equal sort keys
      *
-     * @param renderer: The SDL renderer
      * @param entityManager: The entity manager
+     * @param view: The world space area to draw, usually the camera rect plus a margin
+     * @return: Indices into entityManager.getEntities()
      */
+    if (!indexBuilt || indexedVersion != entityManager.getStructureVersion()) {
+        rebuildStaticIndex(entityManager);
+    }
 
-    for (Entity& entity : entityManager.getEntities()) {
-        if (entity.hasComponent<Collider>()) {
-            render_collider(entity, renderer);
+    std::vector<Entity>& entities = entityManager.getEntities();
+    visibleEntities.clear();
+    staticSprites.query(view, visibleEntities);
+    for (int index : movableSprites) {
+        SDL_Rect bounds = getSpriteBounds(entities[index]);
+        if (SDL_HasIntersection(&bounds, &view)) {
+            visibleEntities.push_back(index);
         }
     }
+    std::sort(visibleEntities.begin(), visibleEntities.end());
+    return visibleEntities;
 }
 
-void RenderSystem::render_collider(Entity &entity, SDL_Renderer *renderer) {
+void RenderSystem::rebuildStaticIndex(EntityManager& entityManager) {
     /**
-     * Render the collider for an entity
+     * Re-index drawable entities after entities were added or removed
+     * Entities without Velocity are assumed not to move and go into the grid,
+     * the rest are kept in a list and culled every frame
      *
-     * @param entity: The entity
-     * @param renderer: The SDL renderer
+     * @param entityManager: The entity manager
      */
+    std::vector<Entity>& entities = entityManager.getEntities();
+    staticSprites.clear();
+    movableSprites.clear();
+    for (int index = 0; index < static_cast<int>(entities.size()); index++) {
+        Entity& entity = entities[index];
+        if (!(entity.hasComponent<Transform>() && entity.hasComponent<Collider>() && entity.hasComponent<Sprite>())) {
+            continue;
+        }
+        if (entity.hasComponent<Velocity>()) {
+            movableSprites.push_back(index);
+        } else {
+            staticSprites.insert(index, getSpriteBounds(entity));
+        }
+    }
+    indexedVersion = entityManager.getStructureVersion();
+    indexBuilt = true;
+}
 
-    Transform &transform = entity.getComponent<Transform>();
-    Collider &col = entity.getComponent<Collider>();
-    int x = transform.x + (col.offsetX * transform.scale) - camera.getCameraRect().x;
-    int y = transform.y + (col.offsetY * transform.scale) - camera.getCameraRect().y;
-    int w = col.width * transform.scale;
-    int h = col.height * transform.scale;
-    SDL_Rect collider = {x, y, w, h};
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-    SDL_RenderDrawRect(renderer, &collider);
+SDL_Rect RenderSystem::getSpriteBounds(Entity& entity) {
+    /**
+     * The world space rect a sprite is drawn to
+     *
+     * @param entity: An entity with Transform and Sprite
+     */
+    Transform& transform = entity.getComponent<Transform>();
+    Sprite& spr = entity.getComponent<Sprite>();
+    return {transform.x, transform.y, static_cast<int>(spr.srcRect.w * transform.scale), static_cast<int>(spr.srcRect.h * transform.scale)};
 }
 
+void RenderSystem::drawDebugShapes(EntityManager& entityManager, const std::vector<int>& entityIndices) {
+    /**
+     * Queue collider and active hitbox outlines for the given entities on the debug overlay
+     *
+     * @param entityManager: The entity manager
+     * @param entityIndices: Indices into entityManager.getEntities(), usually the visible ones
+     */
+    DebugDraw& debugDraw = DebugDraw::getInstance();
+    bool colliders = debugDraw.isEnabled(DebugDraw::COLLIDERS);
+    bool hitboxes = debugDraw.isEnabled(DebugDraw::HITBOXES);
+    if (!colliders && !hitboxes) {
+        return;
+    }
+
+    std::vector<Entity>& entities = entityManager.getEntities();
+    for (int index : entityIndices) {
+        Entity& entity = entities[index];
+        if (colliders && entity.hasComponent<Collider>()) {
+            debugDraw.rect(entity.getColliderRect(), {255, 255, 255, 255});
+        }
+        if (hitboxes && entity.hasComponent<AttackMap>()) {
+            for (auto& [name, attackInfo] : entity.getComponent<AttackMap>().attacks) {
+                if (attackInfo.isActive) {
+                    debugDraw.rect(entity.getHitboxRect(attackInfo.hitbox), {255, 0, 0, 255});
+                }
+            }
+        }
+    }
+}
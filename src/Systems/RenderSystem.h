@@ -2,21 +2,68 @@
 #ifndef BUMMERENGINE_RENDERSYSTEM_H
 #define BUMMERENGINE_RENDERSYSTEM_H
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 #include "../ECS/EntityManager.h"
+#include "../ECS/SpatialGrid.h"
 #include "Camera.h"
+#include "DebugDraw.h"
+#include "DebugDrawBatch.h"
+#include "DrawList.h"
+#include "RenderCommands.h"
+#include "SpriteBatch.h"
+#include "TilemapRenderer.h"
+#include "../UI/FontCache.h"
 
 class RenderSystem {
+    /**
+     * Drawing is split in two halves that may run on different threads
+     *
+     * buildCommands() runs with the simulation: it moves the camera, culls and sorts, and writes a RenderCommandList.
+     * execute() runs on the thread owning the renderer and only reads that list. The halves share no members,
+     * so one frame can be executed while the next is built. render() does both in a row.
+     */
 public:
     RenderSystem();
-    void render(SDL_Renderer* renderer, EntityManager& entityManager, TTF_Font* font);
-    void render_hitboxes(EntityManager& entityManager, SDL_Renderer* renderer);
-    void render_all_colliders(EntityManager& entityManager, SDL_Renderer* renderer);
-    void render_collider(Entity& entity, SDL_Renderer* renderer);
+    ~RenderSystem();
+    RenderSystem(const RenderSystem&) = delete;
+    RenderSystem& operator=(const RenderSystem&) = delete;
+    void render(SDL_Renderer* renderer, EntityManager& entityManager, std::shared_ptr<const std::vector<Tilemap>> tilemaps, TTF_Font* font);
+    void buildCommands(EntityManager& entityManager, std::shared_ptr<const std::vector<Tilemap>> tilemaps, RenderCommandList& commands);
+    void execute(SDL_Renderer* renderer, const RenderCommandList& commands, TTF_Font* font);
+    void watchRendererEvents();
+    void handleRendererEvent(const SDL_Event& event);
+    void drawDebugShapes(EntityManager& entityManager, const std::vector<int>& entityIndices);
+    const std::vector<int>& collectVisibleEntities(EntityManager& entityManager, const SDL_Rect& view);
+
+    static constexpr int CULL_MARGIN = 64;  // pixels around the camera still drawn, covers sprites moving in this frame
+    static constexpr int GRID_CELL_SIZE = 256;
 
 private:
+    void rebuildStaticIndex(EntityManager& entityManager);
+    static SDL_Rect getSpriteBounds(Entity& entity);
+    static int onEvent(void* renderSystem, SDL_Event* event);
+
+    // simulation side
     Camera camera;
+    DrawList drawList;
+    SpatialGrid staticSprites;
+    std::vector<int> movableSprites;
+    std::vector<int> visibleEntities;
+    unsigned int indexedVersion;
+    bool indexBuilt;
+    RenderCommandList frameCommands;  // reused by render()
+
+    // render side
+    SpriteBatch spriteBatch;
+    DebugDrawBatch debugBatch;
+    TilemapRenderer tilemapRenderer;
+    std::unique_ptr<FontCache> fontCache;
+    std::atomic<bool> renderTargetsReset;  // set by whichever thread sees the event, handled by execute()
 };
 
 #endif //BUMMERENGINE_RENDERSYSTEM_H
\ No newline at end of file
@@ -1,52 +1,90 @@
 #include "SoundSystem.h"
-# include <iostream>
 #include "../ECS/EventManager.h"
 
 
-SoundSystem::SoundSystem() {
-    EventManager::getInstance().subscribe("jumpSound", [this](EventData data) {
-        playSound("assets/sounds/foly/bb_char/jump_6.wav", 2);
-    });
-    EventManager::getInstance().subscribe("died", [this](EventData data) {
-        playSound("assets/sounds/zapsplat/zapsplat_impacts_body_hit_thud_stab_squelch_of_blood_90708.wav", 2);
-    });
-    EventManager::getInstance().subscribe("spawn", [this](EventData data) {
-        playSound("assets/sounds/zapsplat/zapsplat_sound_design_rewind_reversed_vibration_001_19653.wav", 2);
-    });
-    EventManager::getInstance().subscribe("dashSound", [this](EventData data) {
-        playSound("assets/sounds/zapsplat/zapsplat_cartoon_whoosh_swipe_fast_grab_dash_006_74747.wav", 4);
-    });
-    EventManager::getInstance().subscribe("start", [this](EventData data) {
-        playSound("assets/sounds/foly/background_environ/waves_birds_long_loop.wav", 4);
-        playSound("assets/sounds/music/Sitar_Meditations.wav", 6);
-    });
-    EventManager::getInstance().subscribe("landed", [this](EventData data) {
-        playSound("assets/sounds/foly/bb_char/sand_walk_1.wav", 6);
-    });
-    EventManager::getInstance().subscribe("basicAttackSound", [this](EventData data) {
+namespace {
+    const std::string JUMP_SOUND = "assets/sounds/foly/bb_char/jump_6.wav";
+    const std::string DIED_SOUND = "assets/sounds/zapsplat/zapsplat_impacts_body_hit_thud_stab_squelch_of_blood_90708.wav";
+    const std::string SPAWN_SOUND = "assets/sounds/zapsplat/zapsplat_sound_design_rewind_reversed_vibration_001_19653.wav";
+    const std::string DASH_SOUND = "assets/sounds/zapsplat/zapsplat_cartoon_whoosh_swipe_fast_grab_dash_006_74747.wav";
+    const std::string LANDED_SOUND = "assets/sounds/foly/bb_char/sand_walk_1.wav";
+    const std::string PLAYER_ATTACK_SOUND = "assets/sounds/foly/bb_char/attack_6.wav";
+    const std::string ALIEN_ATTACK_SOUND = "assets/sounds/foly/alien_sounds/vocal_2.wav";
+    const std::string ALIEN_TAKE_HIT_SOUND = "assets/sounds/foly/alien_sounds/takehit_1.wav";
+    const std::string PLAYER_TAKE_HIT_SOUND = "assets/sounds/foly/bb_char/take_hit_4.wav";
+    const std::string ALIEN_VOCAL_SOUND = "assets/sounds/foly/alien_sounds/vocal_5.wav";
+}
+
+
+SoundSystem::SoundSystem(EventManager& eventManager, SoundBank& soundBank, int voiceCount)
+    : soundBank(soundBank), voices(voiceCount) {
+    /**
+     * Constructor for the SoundSystem, looks up the event sounds preloaded from getEffectFiles() without decoding any
+     * An effect that was not preloaded stays silent
+     *
+     * @param eventManager: The event bus the sounds are triggered from
+     * @param soundBank: Holds the decoded sounds
+     * @param voiceCount: The number of sounds that can play at once
+     */
+    SoundHandle jump = soundBank.find(JUMP_SOUND);
+    SoundHandle died = soundBank.find(DIED_SOUND);
+    SoundHandle spawn = soundBank.find(SPAWN_SOUND);
+    SoundHandle dash = soundBank.find(DASH_SOUND);
+    SoundHandle landed = soundBank.find(LANDED_SOUND);
+    SoundHandle playerAttack = soundBank.find(PLAYER_ATTACK_SOUND);
+    SoundHandle alienAttack = soundBank.find(ALIEN_ATTACK_SOUND);
+    SoundHandle alienTakeHit = soundBank.find(ALIEN_TAKE_HIT_SOUND);
+    SoundHandle playerTakeHit = soundBank.find(PLAYER_TAKE_HIT_SOUND);
+    SoundHandle alienVocal = soundBank.find(ALIEN_VOCAL_SOUND);
+
+    // the player's sounds outrank the crowd's, music and ambience are streamed by the MusicPlayer
+    for (SoundHandle playerSound : {jump, died, spawn, dash, landed, playerAttack, playerTakeHit}) {
+        voices.setSettings(playerSound, {5, 2, 50});
+    }
+    // a crowd fight triggers these in bursts, a few at a time are enough to hear them
+    for (SoundHandle crowdSound : {alienAttack, alienTakeHit, alienVocal}) {
+        voices.setSettings(crowdSound, {1, 3, 40});
+    }
+
+    subscriptions.push_back(eventManager.subscribe("jumpSound", [this, jump](EventData data) {
+        playSound(jump, 2);
+    }));
+    subscriptions.push_back(eventManager.subscribe("died", [this, died](EventData data) {
+        playSound(died, 2);
+    }));
+    subscriptions.push_back(eventManager.subscribe("spawn", [this, spawn](EventData data) {
+        playSound(spawn, 2);
+    }));
+    subscriptions.push_back(eventManager.subscribe("dashSound", [this, dash](EventData data) {
+        playSound(dash, 4);
+    }));
+    subscriptions.push_back(eventManager.subscribe("landed", [this, landed](EventData data) {
+        playSound(landed, 6);
+    }));
+    subscriptions.push_back(eventManager.subscribe("basicAttackSound", [this, playerAttack, alienAttack](EventData data) {
         Entity* entity = data.primaryEntity;
         if (entity->hasComponent<Player>()) {
-            playSound("assets/sounds/foly/bb_char/attack_6.wav", 2);
+            playSound(playerAttack, 2);
         }
         else if (!entity->hasComponent<Player>()) {
-            playSound("assets/sounds/foly/alien_sounds/vocal_2.wav", 1);
+            playSound(alienAttack, 1);
         }
-    });
+    }));
 
-    EventManager::getInstance().subscribe("enemyHit", [this](EventData data) {
+    subscriptions.push_back(eventManager.subscribe("enemyHit", [this, alienTakeHit, playerTakeHit, alienVocal](EventData data) {
         /**
          * Play sounds when entity gets hit by an attack
          */
         Entity* entity = data.secondaryEntity;
         if (entity->hasComponent<Player>()) {
-            playSound("assets/sounds/foly/alien_sounds/takehit_1.wav", 2);
-            playSound("assets/sounds/foly/bb_char/take_hit_4.wav", 1);
+            playSound(alienTakeHit, 2);
+            playSound(playerTakeHit, 1);
         }
         else {
-            playSound("assets/sounds/foly/alien_sounds/takehit_1.wav", 2);
-            playSound("assets/sounds/foly/alien_sounds/vocal_5.wav", 1);
+            playSound(alienTakeHit, 2);
+            playSound(alienVocal, 1);
         }
-    });
+    }));
 }
 
 void SoundSystem::update(EntityManager& entityManager) {
@@ -59,14 +97,30 @@ void SoundSystem::update(EntityManager& entityManager) {
 }
 
 void SoundSystem::playSound(const std::string& soundFile, int volumeDivisor) {
-    Mix_Chunk* sound = Mix_LoadWAV(soundFile.c_str());
-    if (sound == nullptr) {
-        std::cout << "Sound: " << soundFile << " failed to load" << std::endl;
-    }
-    Mix_VolumeChunk(sound, MIX_MAX_VOLUME / volumeDivisor);
-    Mix_PlayChannel(-1, sound, 0);
+    /**
+     * Play a sound by file, it is decoded the first time and taken from the sound bank afterwards
+     *
+     * @param soundFile: The sound file
+     * @param volumeDivisor: The full volume is divided by this
+     */
+    playSound(soundBank.load(soundFile), volumeDivisor);
+}
+
+void SoundSystem::playSound(SoundHandle sound, int volumeDivisor) {
+    voices.play(soundBank, sound, MIX_MAX_VOLUME / volumeDivisor);
 }
 
 void SoundSystem::stopSound() {
-    Mix_HaltChannel(-1);
+    voices.stopAll();
+}
+
+const std::vector<std::string>& SoundSystem::getEffectFiles() {
+    /**
+     * The sounds the event subscriptions play, to be preloaded into the SoundBank before the SoundSystem is made
+     */
+    static const std::vector<std::string> effectFiles = {
+        JUMP_SOUND, DIED_SOUND, SPAWN_SOUND, DASH_SOUND, LANDED_SOUND, PLAYER_ATTACK_SOUND,
+        ALIEN_ATTACK_SOUND, ALIEN_TAKE_HIT_SOUND, PLAYER_TAKE_HIT_SOUND, ALIEN_VOCAL_SOUND
+    };
+    return effectFiles;
 }
@@ -2,15 +2,29 @@
 #ifndef BUMMERENGINE_SOUNDSYSTEM_H
 #define BUMMERENGINE_SOUNDSYSTEM_H
 
+#include <string>
+#include <vector>
+
 #include <SDL2/SDL_mixer.h>
 #include "../ECS/EntityManager.h"
+#include "../ECS/EventManager.h"
+#include "../Resources/SoundBank.h"
+#include "VoiceManager.h"
 
 class SoundSystem {
 public:
-    SoundSystem();
+    SoundSystem(EventManager& eventManager, SoundBank& soundBank, int voiceCount);
     void update(EntityManager& entityManager);
     void playSound(const std::string& soundFile, int volumeDivisor);
+    void playSound(SoundHandle sound, int volumeDivisor);
     void stopSound();
+
+    static const std::vector<std::string>& getEffectFiles();
+
+private:
+    SoundBank& soundBank;
+    VoiceManager voices;
+    std::vector<EventSubscription> subscriptions;
 };
 
-#endif //BUMMERENGINE_SOUNDSYSTEM_H
\ No newline at end of file
+#endif //BUMMERENGINE_SOUNDSYSTEM_H
@@ -0,0 +1,106 @@
+#include <utility>
+
+#include "SpriteBatch.h"
+#include "../Logger.h"
+
+void SpriteBatch::begin() {
+    /**
+     * Start a new frame, dropping the quads of the previous one but keeping their buffers
+     */
+    for (size_t i = 0; i < activeBatches; i++) {
+        batches[i].vertices.clear();
+        batches[i].indices.clear();
+    }
+    activeBatches = 0;
+}
+
+void SpriteBatch::draw(SDL_Texture* texture, const SDL_Rect& srcRect, const SDL_Rect& destRect, SDL_RendererFlip flip) {
+    /**
+     * Queue a textured quad, the batched equivalent of SDL_RenderCopyEx without rotation
+     *
+     * @param texture: The texture to sample
+     * @param srcRect: The part of the texture to draw, in pixels
+     * @param destRect: Where to draw it on screen
+     * @param flip: Flips are applied by swapping texture coordinates
+     */
+    if (texture == nullptr) {
+        return;
+    }
+
+    if (activeBatches == 0 || batches[activeBatches - 1].texture != texture) {
+        // texture changed, start a new run
+        if (activeBatches == batches.size()) {
+            batches.push_back({});
+        }
+        Batch& batch = batches[activeBatches++];
+        batch.texture = texture;
+        int width = 0;
+        int height = 0;
+        SDL_QueryTexture(texture, nullptr, nullptr, &width, &height);
+        batch.textureWidth = static_cast<float>(width > 0 ? width : 1);
+        batch.textureHeight = static_cast<float>(height > 0 ? height : 1);
+    }
+    Batch& batch = batches[activeBatches - 1];
+
+    float u0 = srcRect.x / batch.textureWidth;
+    float v0 = srcRect.y / batch.textureHeight;
+    float u1 = (srcRect.x + srcRect.w) / batch.textureWidth;
+    float v1 = (srcRect.y + srcRect.h) / batch.textureHeight;
+    if (flip & SDL_FLIP_HORIZONTAL) {
+        std::swap(u0, u1);
+    }
+    if (flip & SDL_FLIP_VERTICAL) {
+        std::swap(v0, v1);
+    }
+
+    float x0 = static_cast<float>(destRect.x);
+    float y0 = static_cast<float>(destRect.y);
+    float x1 = static_cast<float>(destRect.x + destRect.w);
+    float y1 = static_cast<float>(destRect.y + destRect.h);
+    SDL_Color white = {255, 255, 255, 255};
+
+    int base = static_cast<int>(batch.vertices.size());
+    batch.vertices.push_back({{x0, y0}, white, {u0, v0}});
+    batch.vertices.push_back({{x1, y0}, white, {u1, v0}});
+    batch.vertices.push_back({{x1, y1}, white, {u1, v1}});
+    batch.vertices.push_back({{x0, y1}, white, {u0, v1}});
+    batch.indices.insert(batch.indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+}
+
+int SpriteBatch::flush(SDL_Renderer* renderer) {
+    /**
+     * Submit every batch queued since begin()
+     *
+     * @param renderer: The SDL renderer
+     * @return: The number of draw calls issued
+     */
+    int drawCalls = 0;
+    for (size_t i = 0; i < activeBatches; i++) {
+        Batch& batch = batches[i];
+        if (batch.indices.empty()) {
+            continue;
+        }
+        if (SDL_RenderGeometry(renderer, batch.texture, batch.vertices.data(), static_cast<int>(batch.vertices.size()),
+                               batch.indices.data(), static_cast<int>(batch.indices.size())) != 0) {
+            LOG_WARN("render", "SDL_RenderGeometry failed! SDL Error: " << SDL_GetError());
+        }
+        drawCalls++;
+    }
+    return drawCalls;
+}
+
+size_t SpriteBatch::getBatchCount() const {
+    return activeBatches;
+}
+
+size_t SpriteBatch::getQuadCount() const {
+    size_t quads = 0;
+    for (size_t i = 0; i < activeBatches; i++) {
+        quads += batches[i].vertices.size() / 4;
+    }
+    return quads;
+}
+
+const std::vector<SDL_Vertex>& SpriteBatch::getVertices(size_t batch) const {
+    return batches[batch].vertices;
+}
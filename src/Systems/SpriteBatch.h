@@ -0,0 +1,37 @@
+#pragma once
+#ifndef BUMMERENGINE_SPRITEBATCH_H
+#define BUMMERENGINE_SPRITEBATCH_H
+
+#include <cstddef>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+class SpriteBatch {
+    /**
+     * Collects sprite quads for a frame and submits each run of quads sharing a texture with one SDL_RenderGeometry call
+     * Quads are drawn in the order they were added, so callers sort by texture (see DrawList) to get the fewest calls
+     * Vertex and index buffers are kept between frames so steady state drawing does not allocate
+     */
+public:
+    void begin();
+    void draw(SDL_Texture* texture, const SDL_Rect& srcRect, const SDL_Rect& destRect, SDL_RendererFlip flip);
+    int flush(SDL_Renderer* renderer);
+    size_t getBatchCount() const;
+    size_t getQuadCount() const;
+    const std::vector<SDL_Vertex>& getVertices(size_t batch) const;
+
+private:
+    struct Batch {
+        SDL_Texture* texture;
+        float textureWidth;
+        float textureHeight;
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+    };
+
+    std::vector<Batch> batches;  // only the first activeBatches are in use this frame
+    size_t activeBatches = 0;
+};
+
+#endif //BUMMERENGINE_SPRITEBATCH_H
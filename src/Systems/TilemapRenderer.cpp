@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <cmath>
+
+#include "TilemapRenderer.h"
+#include "../Logger.h"
+
+TilemapRenderer::~TilemapRenderer() {
+    invalidate();
+}
+
+void TilemapRenderer::render(SDL_Renderer* renderer, const std::vector<Tilemap>& tilemaps, const SDL_Rect& cameraRect) {
+    /**
+     * Draw the chunks of every tilemap that overlap the camera, baking any that have not been drawn before
+     * Baked chunks are dropped when the set of tilemaps changes, i.e. when a new scene is loaded
+     *
+     * @param renderer: The SDL renderer
+     * @param tilemaps: The tilemaps of the current scene
+     * @param cameraRect: The world space area on screen
+     */
+    bool sameTilemaps = tilemaps.size() == cachedTilemapIds.size();
+    for (size_t i = 0; sameTilemaps && i < tilemaps.size(); i++) {
+        sameTilemaps = tilemaps[i].id == cachedTilemapIds[i];
+    }
+    if (!sameTilemaps) {
+        invalidate();
+        for (const Tilemap& tilemap : tilemaps) {
+            cachedTilemapIds.push_back(tilemap.id);
+        }
+    }
+
+    for (const Tilemap& tilemap : tilemaps) {
+        if (tilemap.tileset == nullptr) {
+            continue;
+        }
+        int firstX, firstY, lastX, lastY;
+        getVisibleChunks(tilemap, cameraRect, firstX, firstY, lastX, lastY);
+        for (int chunkY = firstY; chunkY <= lastY; chunkY++) {
+            for (int chunkX = firstX; chunkX <= lastX; chunkX++) {
+                uint64_t key = chunkKey(tilemap, chunkX, chunkY);
+                auto chunk = chunks.find(key);
+                if (chunk == chunks.end()) {
+                    chunk = chunks.emplace(key, bakeChunk(renderer, tilemap, chunkX, chunkY)).first;
+                }
+                if (chunk->second == nullptr) {
+                    continue;
+                }
+                SDL_Rect destRect = getChunkWorldRect(tilemap, chunkX, chunkY);
+                destRect.x -= cameraRect.x;
+                destRect.y -= cameraRect.y;
+                SDL_RenderCopy(renderer, chunk->second, nullptr, &destRect);
+            }
+        }
+    }
+}
+
+SDL_Texture* TilemapRenderer::bakeChunk(SDL_Renderer* renderer, const Tilemap& tilemap, int chunkX, int chunkY) {
+    /**
+     * Render every layer of one chunk, at the tileset's native resolution, into a new target texture
+     *
+     * @param renderer: The SDL renderer
+     * @param tilemap: The tilemap the chunk belongs to
+     * @param chunkX: The chunk column
+     * @param chunkY: The chunk row
+     * @return: The baked texture, or nullptr if render targets are not available
+     */
+    int firstColumn = chunkX * CHUNK_TILES;
+    int firstRow = chunkY * CHUNK_TILES;
+    int columns = std::min(CHUNK_TILES, tilemap.width - firstColumn);
+    int rows = std::min(CHUNK_TILES, tilemap.height - firstRow);
+
+    SDL_Texture* chunk = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET,
+                                           columns * tilemap.tileWidth, rows * tilemap.tileHeight);
+    if (chunk == nullptr) {
+        LOG_WARN("render", "Unable to create tilemap chunk texture! SDL Error: " << SDL_GetError());
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(chunk, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureScaleMode(chunk, SDL_ScaleModeNearest);
+
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_SetRenderTarget(renderer, chunk);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+
+    for (int layer = 0; layer < static_cast<int>(tilemap.layers.size()); layer++) {
+        for (int row = 0; row < rows; row++) {
+            for (int column = 0; column < columns; column++) {
+                int tile = tilemap.getTile(layer, firstColumn + column, firstRow + row);
+                if (tile == Tilemap::EMPTY_TILE) {
+                    continue;
+                }
+                SDL_Rect srcRect = tilemap.getTileSourceRect(tile);
+                SDL_Rect destRect = {column * tilemap.tileWidth, row * tilemap.tileHeight, tilemap.tileWidth, tilemap.tileHeight};
+                SDL_RenderCopy(renderer, tilemap.tileset, &srcRect, &destRect);
+            }
+        }
+    }
+
+    SDL_SetRenderTarget(renderer, previousTarget);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    return chunk;
+}
+
+void TilemapRenderer::invalidate() {
+    /**
+     * Destroy every baked chunk, chunks in view are baked again on the next render()
+     * RenderSystem calls this when the renderer loses its render targets (SDL_RENDER_TARGETS_RESET)
+     */
+    for (auto& [key, chunk] : chunks) {
+        if (chunk != nullptr) {
+            SDL_DestroyTexture(chunk);
+        }
+    }
+    chunks.clear();
+    cachedTilemapIds.clear();
+}
+
+size_t TilemapRenderer::getBakedChunkCount() const {
+    return chunks.size();
+}
+
+SDL_Rect TilemapRenderer::getChunkWorldRect(const Tilemap& tilemap, int chunkX, int chunkY) {
+    /**
+     * The world space rect a chunk is drawn to
+     * Edges are rounded from the unrounded chunk edges so neighbouring chunks never leave a gap
+     *
+     * @param tilemap: The tilemap
+     * @param chunkX: The chunk column
+     * @param chunkY: The chunk row
+     */
+    float tileW = tilemap.tileWidth * tilemap.scale;
+    float tileH = tilemap.tileHeight * tilemap.scale;
+    int x0 = tilemap.x + static_cast<int>(std::lround(chunkX * CHUNK_TILES * tileW));
+    int y0 = tilemap.y + static_cast<int>(std::lround(chunkY * CHUNK_TILES * tileH));
+    int x1 = tilemap.x + static_cast<int>(std::lround(std::min((chunkX + 1) * CHUNK_TILES, tilemap.width) * tileW));
+    int y1 = tilemap.y + static_cast<int>(std::lround(std::min((chunkY + 1) * CHUNK_TILES, tilemap.height) * tileH));
+    return {x0, y0, x1 - x0, y1 - y0};
+}
+
+void TilemapRenderer::getVisibleChunks(const Tilemap& tilemap, const SDL_Rect& view, int& firstX, int& firstY, int& lastX, int& lastY) {
+    /**
+     * The range of chunks overlapping a world space view, inclusive. Empty (first > last) if the map is off screen.
+     *
+     * @param tilemap: The tilemap
+     * @param view: The world space area to test
+     */
+    firstX = 0;
+    firstY = 0;
+    lastX = -1;
+    lastY = -1;
+    SDL_Rect worldRect = tilemap.getWorldRect();
+    if (!SDL_HasIntersection(&worldRect, &view)) {
+        return;
+    }
+
+    float chunkW = CHUNK_TILES * tilemap.tileWidth * tilemap.scale;
+    float chunkH = CHUNK_TILES * tilemap.tileHeight * tilemap.scale;
+    int chunksX = (tilemap.width + CHUNK_TILES - 1) / CHUNK_TILES;
+    int chunksY = (tilemap.height + CHUNK_TILES - 1) / CHUNK_TILES;
+    firstX = std::clamp(static_cast<int>(std::floor((view.x - tilemap.x) / chunkW)), 0, chunksX - 1);
+    firstY = std::clamp(static_cast<int>(std::floor((view.y - tilemap.y) / chunkH)), 0, chunksY - 1);
+    lastX = std::clamp(static_cast<int>(std::floor((view.x + view.w - 1 - tilemap.x) / chunkW)), 0, chunksX - 1);
+    lastY = std::clamp(static_cast<int>(std::floor((view.y + view.h - 1 - tilemap.y) / chunkH)), 0, chunksY - 1);
+}
+
+uint64_t TilemapRenderer::chunkKey(const Tilemap& tilemap, int chunkX, int chunkY) {
+    return (static_cast<uint64_t>(tilemap.id) << 40) | (static_cast<uint64_t>(chunkY) << 20) | static_cast<uint64_t>(chunkX);
+}
@@ -0,0 +1,42 @@
+#pragma once
+#ifndef BUMMERENGINE_TILEMAPRENDERER_H
+#define BUMMERENGINE_TILEMAPRENDERER_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+#include "../ECS/Tilemap.h"
+
+class TilemapRenderer {
+    /**
+     * Draws tilemaps from chunks of CHUNK_TILES x CHUNK_TILES tiles baked into render target textures
+     * A chunk is baked with all of its layers the first time it comes into view and reused afterwards,
+     * so each visible chunk costs one copy per frame however many tiles it holds
+     */
+public:
+    static constexpr int CHUNK_TILES = 16;
+
+    TilemapRenderer() = default;
+    ~TilemapRenderer();
+    TilemapRenderer(const TilemapRenderer&) = delete;
+    TilemapRenderer& operator=(const TilemapRenderer&) = delete;
+
+    void render(SDL_Renderer* renderer, const std::vector<Tilemap>& tilemaps, const SDL_Rect& cameraRect);
+    void invalidate();
+    size_t getBakedChunkCount() const;
+
+    static SDL_Rect getChunkWorldRect(const Tilemap& tilemap, int chunkX, int chunkY);
+    static void getVisibleChunks(const Tilemap& tilemap, const SDL_Rect& view, int& firstX, int& firstY, int& lastX, int& lastY);
+
+private:
+    SDL_Texture* bakeChunk(SDL_Renderer* renderer, const Tilemap& tilemap, int chunkX, int chunkY);
+    static uint64_t chunkKey(const Tilemap& tilemap, int chunkX, int chunkY);
+
+    std::unordered_map<uint64_t, SDL_Texture*> chunks;
+    std::vector<int> cachedTilemapIds;
+};
+
+#endif //BUMMERENGINE_TILEMAPRENDERER_H
@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+#include "VoiceManager.h"
+#include "../Logger.h"
+
+VoiceManager::VoiceManager(int voiceCount, PlayingFunction isPlaying) : isPlaying(std::move(isPlaying)), dropped(0), stolen(0) {
+    /**
+     * Constructor for the VoiceManager, sets the number of mixer channels
+     *
+     * @param voiceCount: The number of sounds that can play at once, at least one
+     * @param isPlaying: Whether a channel is still playing, asks the mixer unless replaced in tests
+     */
+    voiceCount = std::max(1, voiceCount);
+    Mix_AllocateChannels(voiceCount);
+    voices.resize(voiceCount);
+}
+
+void VoiceManager::setSettings(SoundHandle sound, const SoundSettings& settings) {
+    /**
+     * Set the priority, instance limit and cooldown of a sound
+     *
+     * @param sound: The sound
+     * @param settings: Its settings, sounds without any use the defaults
+     */
+    getState(sound).settings = settings;
+}
+
+const VoiceManager::SoundSettings& VoiceManager::getSettings(SoundHandle sound) const {
+    if (sound >= sounds.size()) {
+        return defaultSettings;
+    }
+    return sounds[sound].settings;
+}
+
+int VoiceManager::play(SoundBank& soundBank, SoundHandle sound, int volume) {
+    /**
+     * Play a sound once on the voice allocate() picks for it
+     *
+     * @param soundBank: The bank the sound was loaded into
+     * @param sound: The sound
+     * @param volume: 0 to MIX_MAX_VOLUME
+     * @return: The channel, or -1 if the sound was dropped
+     */
+    Mix_Chunk* chunk = soundBank.getChunk(sound);
+    if (chunk == nullptr) {
+        return -1;
+    }
+    int channel = allocate(sound, volume, SDL_GetTicks());
+    if (channel < 0) {
+        return -1;
+    }
+    // playing on a busy channel replaces what it was playing
+    if (Mix_PlayChannel(channel, chunk, 0) < 0) {
+        LOG_WARN("sound", "Sound: " << soundBank.getPath(sound) << " could not play: " << Mix_GetError());
+        voices[channel].active = false;
+        return -1;
+    }
+    Mix_Volume(channel, volume);
+    return channel;
+}
+
+int VoiceManager::allocate(SoundHandle sound, int volume, Uint32 now) {
+    /**
+     * Pick the voice a sound should play on and book it, without touching the mixer
+     *
+     * @param sound: The sound
+     * @param volume: 0 to MIX_MAX_VOLUME, quieter voices are stolen first
+     * @param now: The current time in ms
+     * @return: The channel, or -1 if the sound should be dropped
+     */
+    SoundState& state = getState(sound);
+    const SoundSettings& settings = state.settings;
+    if (state.started && now - state.lastStartedAt < settings.cooldownMs) {
+        dropped++;
+        return -1;
+    }
+    refreshVoices();
+
+    int instances = 0;
+    int oldestInstance = -1;
+    int freeVoice = -1;
+    for (int channel = 0; channel < static_cast<int>(voices.size()); channel++) {
+        const Voice& voice = voices[channel];
+        if (!voice.active) {
+            if (freeVoice < 0) {
+                freeVoice = channel;
+            }
+        } else if (voice.sound == sound) {
+            instances++;
+            if (oldestInstance < 0 || voice.startedAt < voices[oldestInstance].startedAt) {
+                oldestInstance = channel;
+            }
+        }
+    }
+
+    int channel = freeVoice;
+    if (instances >= std::max(1, settings.maxInstances)) {
+        // restart the oldest instance rather than stack another copy of the same sound
+        channel = oldestInstance;
+        stolen++;
+    } else if (channel < 0) {
+        channel = findVictim(settings.priority);
+        if (channel < 0) {
+            dropped++;
+            return -1;
+        }
+        stolen++;
+    }
+
+    voices[channel] = {sound, settings.priority, volume, now, true};
+    state.lastStartedAt = now;
+    state.started = true;
+    return channel;
+}
+
+void VoiceManager::stopAll() {
+    /**
+     * Halt every voice
+     */
+    Mix_HaltChannel(-1);
+    for (Voice& voice : voices) {
+        voice.active = false;
+    }
+}
+
+int VoiceManager::getVoiceCount() const {
+    return static_cast<int>(voices.size());
+}
+
+int VoiceManager::getActiveCount() {
+    /**
+     * The number of voices still playing
+     */
+    refreshVoices();
+    return static_cast<int>(std::count_if(voices.begin(), voices.end(), [](const Voice& voice) {
+        return voice.active;
+    }));
+}
+
+int VoiceManager::getDroppedCount() const {
+    return dropped;
+}
+
+int VoiceManager::getStolenCount() const {
+    return stolen;
+}
+
+bool VoiceManager::channelPlaying(int channel) {
+    return Mix_Playing(channel) != 0;
+}
+
+VoiceManager::SoundState& VoiceManager::getState(SoundHandle sound) {
+    if (sound >= sounds.size()) {
+        sounds.resize(sound + 1, {defaultSettings, 0, false});
+    }
+    return sounds[sound];
+}
+
+void VoiceManager::refreshVoices() {
+    /**
+     * Free the voices whose sound has finished
+     */
+    for (int channel = 0; channel < static_cast<int>(voices.size()); channel++) {
+        if (voices[channel].active && !isPlaying(channel)) {
+            voices[channel].active = false;
+        }
+    }
+}
+
+int VoiceManager::findVictim(int priority) const {
+    /**
+     * The voice to steal for a sound of the given priority: lowest priority, then quietest, then oldest
+     *
+     * @param priority: The priority of the new sound, voices above it are kept
+     * @return: The channel, or -1 if every voice outranks the new sound
+     */
+    int victim = -1;
+    for (int channel = 0; channel < static_cast<int>(voices.size()); channel++) {
+        const Voice& voice = voices[channel];
+        if (!voice.active || voice.priority > priority) {
+            continue;
+        }
+        if (victim < 0 || std::make_tuple(voice.priority, voice.volume, voice.startedAt) <
+                          std::make_tuple(voices[victim].priority, voices[victim].volume, voices[victim].startedAt)) {
+            victim = channel;
+        }
+    }
+    return victim;
+}
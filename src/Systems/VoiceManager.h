@@ -0,0 +1,69 @@
+#pragma once
+#ifndef BUMMERENGINE_VOICEMANAGER_H
+#define BUMMERENGINE_VOICEMANAGER_H
+
+#include <functional>
+#include <vector>
+
+#include <SDL2/SDL.h>
+#include "../Resources/SoundBank.h"
+
+class VoiceManager {
+    /**
+     * Decides which mixer channel, or voice, each sound plays on, with a fixed number of voices
+     *
+     * A sound is dropped if the same sound started less than its cooldown ago. If it already has its maximum number
+     * of instances playing, the oldest of them is restarted. Otherwise it gets a free voice. When no voice is free it
+     * steals the lowest priority voice, then the quietest, then the oldest, but never one that outranks it.
+     * The fixed voice count bounds how much the mixer has to do however many sounds are triggered.
+     */
+public:
+    struct SoundSettings {
+        int priority = 0;         // higher wins when voices run out
+        int maxInstances = 4;     // voices this sound may use at once
+        Uint32 cooldownMs = 0;    // repeats within this time are dropped
+    };
+
+    using PlayingFunction = std::function<bool(int)>;
+
+    explicit VoiceManager(int voiceCount, PlayingFunction isPlaying = channelPlaying);
+
+    void setSettings(SoundHandle sound, const SoundSettings& settings);
+    const SoundSettings& getSettings(SoundHandle sound) const;
+    int play(SoundBank& soundBank, SoundHandle sound, int volume);
+    int allocate(SoundHandle sound, int volume, Uint32 now);
+    void stopAll();
+    int getVoiceCount() const;
+    int getActiveCount();
+    int getDroppedCount() const;
+    int getStolenCount() const;
+
+    static bool channelPlaying(int channel);
+
+private:
+    struct Voice {
+        SoundHandle sound = INVALID_SOUND_HANDLE;
+        int priority = 0;
+        int volume = 0;
+        Uint32 startedAt = 0;
+        bool active = false;
+    };
+    struct SoundState {
+        SoundSettings settings;
+        Uint32 lastStartedAt = 0;
+        bool started = false;
+    };
+
+    SoundState& getState(SoundHandle sound);
+    void refreshVoices();
+    int findVictim(int priority) const;
+
+    PlayingFunction isPlaying;
+    std::vector<Voice> voices;        // indexed by mixer channel
+    std::vector<SoundState> sounds;   // indexed by sound handle, grown on demand
+    SoundSettings defaultSettings;
+    int dropped;
+    int stolen;
+};
+
+#endif //BUMMERENGINE_VOICEMANAGER_H
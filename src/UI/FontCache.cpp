@@ -0,0 +1,225 @@
+#include <algorithm>
+
+#include "FontCache.h"
+#include "../Logger.h"
+#include "../Resources/TextureAtlas.h"
+
+FontCache::FontCache(SDL_Renderer* renderer, TTF_Font* font)
+    : renderer(renderer), font(font), atlas(nullptr), glyphs(), advances(), lineSkip(0), fontHeight(0) {
+    buildAtlas();
+}
+
+FontCache::~FontCache() {
+    if (atlas != nullptr) {
+        SDL_DestroyTexture(atlas);
+    }
+}
+
+void FontCache::buildAtlas() {
+    /**
+     * Rasterize every printable ASCII glyph in white and pack them into a single texture
+     * Glyph surfaces from SDL_ttf are a full line tall with the glyph already placed on the baseline,
+     * so a string is laid out by placing each glyph's cell at the pen position
+     */
+    if (font == nullptr) {
+        LOG_WARN("ui", "FontCache created without a font, text will not be drawn");
+        return;
+    }
+    lineSkip = TTF_FontLineSkip(font);
+    fontHeight = TTF_FontHeight(font);
+
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Surface* glyphSurfaces[GLYPH_COUNT] = {};
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        Uint16 character = static_cast<Uint16>(FIRST_GLYPH + i);
+        int advance = 0;
+        if (TTF_GlyphMetrics(font, character, nullptr, nullptr, nullptr, nullptr, &advance) == 0) {
+            advances[i] = advance;
+        }
+        glyphSurfaces[i] = TTF_RenderGlyph_Blended(font, character, white);
+    }
+
+    // grow the page until every glyph fits on one texture
+    int pageSize = 256;
+    std::vector<AtlasPlacement> placements(GLYPH_COUNT);
+    bool packed = false;
+    while (!packed && pageSize <= 4096) {
+        AtlasPacker packer(pageSize, pageSize, 1);
+        packed = true;
+        for (int i = 0; i < GLYPH_COUNT && packed; i++) {
+            if (glyphSurfaces[i] != nullptr) {
+                packed = packer.insert(glyphSurfaces[i]->w, glyphSurfaces[i]->h, placements[i]) && placements[i].page == 0;
+            }
+        }
+        if (!packed) {
+            pageSize *= 2;
+        }
+    }
+
+    SDL_Surface* page = packed ? SDL_CreateRGBSurfaceWithFormat(0, pageSize, pageSize, 32, SDL_PIXELFORMAT_RGBA32) : nullptr;
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        if (glyphSurfaces[i] == nullptr) {
+            continue;
+        }
+        if (page != nullptr) {
+            SDL_SetSurfaceBlendMode(glyphSurfaces[i], SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(glyphSurfaces[i], nullptr, page, &placements[i].rect);
+            glyphs[i] = {placements[i].rect, advances[i]};
+        }
+        SDL_FreeSurface(glyphSurfaces[i]);
+    }
+
+    if (page == nullptr) {
+        LOG_WARN("ui", "Unable to build glyph atlas! SDL Error: " << SDL_GetError());
+        return;
+    }
+    atlas = SDL_CreateTextureFromSurface(renderer, page);
+    SDL_FreeSurface(page);
+    if (atlas == nullptr) {
+        LOG_WARN("ui", "Unable to create glyph atlas texture! SDL Error: " << SDL_GetError());
+        return;
+    }
+    SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+}
+
+int FontCache::glyphIndex(unsigned char character) {
+    /**
+     * The slot of a character in the glyph table, '?' for anything outside printable ASCII
+     *
+     * @param character: A byte of the string
+     */
+    if (character < FIRST_GLYPH || character >= FIRST_GLYPH + GLYPH_COUNT) {
+        character = '?';
+    }
+    return character - FIRST_GLYPH;
+}
+
+std::vector<std::string> FontCache::wrapText(const std::string& text, int wrapLength, const int advances[GLYPH_COUNT]) {
+    /**
+     * Split text into lines on newlines and, when wrapLength is set, at the last space before a line gets too wide
+     * A single word wider than wrapLength is left on its own line
+     * UTF-8 continuation bytes are dropped since each multi-byte character is drawn as one '?'
+     *
+     * @param text: The text to split
+     * @param wrapLength: The maximum line width in pixels, 0 to only split on newlines
+     * @param advances: The advance of each glyph
+     */
+    std::vector<std::string> lines;
+    std::string line;
+    int lineWidth = 0;
+    size_t lastSpace = std::string::npos;
+
+    for (unsigned char character : text) {
+        if ((character & 0xC0) == 0x80) {
+            continue;
+        }
+        if (character == '\n') {
+            lines.push_back(line);
+            line.clear();
+            lineWidth = 0;
+            lastSpace = std::string::npos;
+            continue;
+        }
+
+        int advance = advances[glyphIndex(character)];
+        if (wrapLength > 0 && lineWidth + advance > wrapLength && character != ' ' && lastSpace != std::string::npos) {
+            // move the current word to a new line
+            std::string rest = line.substr(lastSpace + 1);
+            line.erase(lastSpace);
+            lines.push_back(line);
+            line = rest;
+            lineWidth = 0;
+            for (unsigned char restCharacter : line) {
+                lineWidth += advances[glyphIndex(restCharacter)];
+            }
+            lastSpace = std::string::npos;
+        }
+        if (character == ' ') {
+            lastSpace = line.size();
+        }
+        line.push_back(static_cast<char>(character));
+        lineWidth += advance;
+    }
+    lines.push_back(line);
+    return lines;
+}
+
+void FontCache::measureText(const std::string& text, int& width, int& height, int wrapLength) const {
+    /**
+     * The size drawText() would cover, without drawing anything
+     *
+     * @param text: The text to measure
+     * @param width: Set to the width of the widest line
+     * @param height: Set to the height of all lines
+     * @param wrapLength: As in drawText()
+     */
+    std::vector<std::string> lines = wrapText(text, wrapLength, advances);
+    width = 0;
+    for (const std::string& line : lines) {
+        int lineWidth = 0;
+        for (unsigned char character : line) {
+            lineWidth += advances[glyphIndex(character)];
+        }
+        width = std::max(width, lineWidth);
+    }
+    // like TTF_SizeText, a single line is as tall as the font, the spacing below the last line is not counted
+    height = static_cast<int>(lines.size() - 1) * lineSkip + fontHeight;
+}
+
+void FontCache::drawText(const std::string& text, SDL_Color color, int x, int y, int wrapLength) {
+    /**
+     * Draw text from the glyph atlas with a single SDL_RenderGeometry call
+     *
+     * @param text: The text to draw
+     * @param color: The color of the text, an alpha of 0 is drawn opaque like SDL_ttf does
+     * @param x: The x position of the text
+     * @param y: The y position of the text
+     * @param wrapLength: The width to wrap the text at, 0 to only break on newlines
+     */
+    if (atlas == nullptr) {
+        return;
+    }
+    if (color.a == 0) {
+        // colors written as {r, g, b} leave alpha at 0, vertices that transparent would draw nothing
+        color.a = SDL_ALPHA_OPAQUE;
+    }
+    int atlasWidth = 0;
+    int atlasHeight = 0;
+    SDL_QueryTexture(atlas, nullptr, nullptr, &atlasWidth, &atlasHeight);
+    float invWidth = 1.0f / static_cast<float>(atlasWidth > 0 ? atlasWidth : 1);
+    float invHeight = 1.0f / static_cast<float>(atlasHeight > 0 ? atlasHeight : 1);
+
+    vertices.clear();
+    indices.clear();
+    int penY = y;
+    for (const std::string& line : wrapText(text, wrapLength, advances)) {
+        int penX = x;
+        for (unsigned char character : line) {
+            const Glyph& glyph = glyphs[glyphIndex(character)];
+            if (character != ' ' && glyph.rect.w > 0) {
+                float x0 = static_cast<float>(penX);
+                float y0 = static_cast<float>(penY);
+                float x1 = x0 + glyph.rect.w;
+                float y1 = y0 + glyph.rect.h;
+                float u0 = glyph.rect.x * invWidth;
+                float v0 = glyph.rect.y * invHeight;
+                float u1 = (glyph.rect.x + glyph.rect.w) * invWidth;
+                float v1 = (glyph.rect.y + glyph.rect.h) * invHeight;
+
+                int base = static_cast<int>(vertices.size());
+                vertices.push_back({{x0, y0}, color, {u0, v0}});
+                vertices.push_back({{x1, y0}, color, {u1, v0}});
+                vertices.push_back({{x1, y1}, color, {u1, v1}});
+                vertices.push_back({{x0, y1}, color, {u0, v1}});
+                indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+            }
+            penX += glyph.advance;
+        }
+        penY += lineSkip;
+    }
+
+    if (!indices.empty()) {
+        SDL_RenderGeometry(renderer, atlas, vertices.data(), static_cast<int>(vertices.size()),
+                           indices.data(), static_cast<int>(indices.size()));
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+#ifndef BUMMERENGINE_FONTCACHE_H
+#define BUMMERENGINE_FONTCACHE_H
+
+#include <string>
+#include <vector>
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+class FontCache {
+    /**
+     * Draws text for one font without creating surfaces or textures per call
+     *
+     * drawText() lays strings out from a glyph atlas built once in the constructor and submits them as quads,
+     * tinted through vertex colours. It covers printable ASCII; other characters are drawn as '?', and kerning is ignored.
+     */
+public:
+    static constexpr int FIRST_GLYPH = 32;
+    static constexpr int GLYPH_COUNT = 95;  // printable ASCII
+
+    FontCache(SDL_Renderer* renderer, TTF_Font* font);
+    ~FontCache();
+    FontCache(const FontCache&) = delete;
+    FontCache& operator=(const FontCache&) = delete;
+
+    void drawText(const std::string& text, SDL_Color color, int x, int y, int wrapLength = 0);
+    void measureText(const std::string& text, int& width, int& height, int wrapLength = 0) const;
+
+    static std::vector<std::string> wrapText(const std::string& text, int wrapLength, const int advances[GLYPH_COUNT]);
+    static int glyphIndex(unsigned char character);
+
+private:
+    struct Glyph {
+        SDL_Rect rect;  // in the atlas
+        int advance;
+    };
+
+    void buildAtlas();
+
+    SDL_Renderer* renderer;
+    TTF_Font* font;
+    SDL_Texture* atlas;
+    Glyph glyphs[GLYPH_COUNT];
+    int advances[GLYPH_COUNT];
+    int lineSkip;
+    int fontHeight;  // height of a glyph cell, the last line only takes this much instead of a full lineSkip
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+};
+
+#endif //BUMMERENGINE_FONTCACHE_H
@@ -1,9 +1,8 @@
-#include <iostream>
-
 #include "Menu.h"
 #include "../Config.h"
+#include "../Logger.h"
 
-Menu::Menu(SDL_Renderer* renderer, TTF_Font* font) : renderer(renderer), font(font) {};
+Menu::Menu(SDL_Renderer* renderer, TTF_Font* font) : renderer(renderer), font(font), fontCache(renderer, font) {};
 
 
 void Menu::update(bool& startMenu, bool& quit) {
@@ -28,12 +27,24 @@ Menu::MenuResult Menu::Show() {
     /**
      * Show the start menu and handle user input.
      *
+     * The loop sleeps in SDL_WaitEventTimeout instead of polling, and only redraws when the window needs it,
+     * so an open menu leaves the CPU idle. The timeout bounds how long a redraw can wait once the menu animates.
      */
     SDL_Event menuEvent;
+    bool needsRedraw = true;
 
     while(true) {
-        if(SDL_PollEvent(&menuEvent)) {
+        if (needsRedraw) {
+            render_menu();
+            needsRedraw = false;
+        }
+
+        if(SDL_WaitEventTimeout(&menuEvent, WAIT_TIMEOUT_MS)) {
             if(menuEvent.type == SDL_QUIT) return Exit;
+            if(menuEvent.type == SDL_WINDOWEVENT) {
+                // exposed, resized or restored: the back buffer has to be drawn again
+                needsRedraw = true;
+            }
             if(menuEvent.type == SDL_KEYDOWN) {
                 switch(menuEvent.key.keysym.sym) {
                     case SDLK_ESCAPE:
@@ -45,8 +56,6 @@ Menu::MenuResult Menu::Show() {
                 }
             }
         }
-
-        render_menu();
     }
 }
 
@@ -68,14 +77,14 @@ void Menu::menu_view() {
      */
     std::string mainText = "Press ENTER to Play";
     int textWidth, textHeight;
-    TTF_SizeText(font, mainText.c_str(), &textWidth, &textHeight);
+    fontCache.measureText(mainText, textWidth, textHeight);
     int mainX = (SCREEN_WIDTH / 2) - (textWidth / 2);
     int mainY = (SCREEN_HEIGHT / 2) - (textHeight / 2);
-    SDL_Color bb_green = {36, 188, 148};
+    SDL_Color bb_green = {36, 188, 148, 0xFF};
     render_text(mainText, bb_green, mainX, mainY);
 
     std::string poweredByText = "Press ESCAPE to Quit";
-    TTF_SizeText(font, mainText.c_str(), &textWidth, &textHeight);
+    fontCache.measureText(poweredByText, textWidth, textHeight);
     int poweredByX = (SCREEN_WIDTH / 2) - (textWidth / 2);
     int poweredByY = mainY - FONT_SIZE - 50;
     SDL_Color bb_purple{104, 102, 182, 0xFF};
@@ -84,7 +93,7 @@ void Menu::menu_view() {
 
 void Menu::render_text(const std::string& text, SDL_Color color, int x, int y, int wrapLength) {
     /**
-     * Render text to the screen
+     * Render text to the screen from the menu's glyph atlas
      *
      * @param text: The text to render
      * @param color: The color of the text
@@ -92,30 +101,5 @@ void Menu::render_text(const std::string& text, SDL_Color color, int x, int y, i
      * @param y: The y position of the text
      * @param wrapLength: The length to wrap the text at
      */
-
-    // Set up the surface for the text
-    SDL_Surface* textSurface = TTF_RenderUTF8_Blended_Wrapped(font, text.c_str(), color, wrapLength);
-    if (textSurface == nullptr) {
-        std::cout << "Unable to render text surface! SDL_ttf Error: " << TTF_GetError() << std::endl;
-        return;
-    }
-
-    // Set up the texture for the text
-    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-    if (textTexture == nullptr) {
-        std::cout << "Unable to create texture from rendered text! SDL Error: " << SDL_GetError() << std::endl;
-        return;
-    }
-
-    // Get the width and height of the text then free the surface
-    int textWidth = textSurface->w;
-    int textHeight = textSurface->h;
-    SDL_FreeSurface(textSurface);
-
-    // Set the position of the text then create a rectangle to render the text to
-    SDL_Rect renderQuad = {x, y, textWidth, textHeight};
-
-    // Copy the texture to the renderer then destroy the texture
-    SDL_RenderCopy(renderer, textTexture, nullptr, &renderQuad);
-    SDL_DestroyTexture(textTexture);
+    fontCache.drawText(text, color, x, y, wrapLength);
 }
@@ -1,12 +1,17 @@
 #ifndef BUMMERENGINE_MENU_H
 #define BUMMERENGINE_MENU_H
 
+#include <string>
+
 #include <SDL.h>
 #include <SDl2/SDL_ttf.h>
 
+#include "FontCache.h"
+
 class Menu {
 public:
     enum MenuResult { Nothing, Exit, Play };
+    static constexpr int WAIT_TIMEOUT_MS = 250;
 
     struct MenuItem {
         SDL_Rect rect;
@@ -24,6 +29,7 @@ private:
     // Add private member variables and methods here if needed
     SDL_Renderer* renderer;
     TTF_Font* font;
+    FontCache fontCache;
 };
 
 #endif //BUMMERENGINE_MENU_H
\ No newline at end of file
@@ -1,12 +1,11 @@
-#include <iostream>
-
 #include "../Config.h"
+#include "../Logger.h"
 #include "SplashScreen.h"
 
 
 void render_splash_screen(SDL_Renderer* renderer, TTF_Font* font) {
     /**
-     * Render the splash screen on startup
+     * Render the splash screen on startup, it stays on screen while the game loads behind it
      *
      * @param renderer: The renderer to render the splash screen to
      * @param font: The font to use for the splash screen
@@ -15,7 +14,6 @@ void render_splash_screen(SDL_Renderer* renderer, TTF_Font* font) {
     SDL_RenderClear(renderer);
     splash_screen(renderer, font);
     SDL_RenderPresent(renderer);
-    SDL_Delay(5000);
 }
 
 void splash_screen(SDL_Renderer* renderer, TTF_Font* font) {
@@ -44,6 +42,7 @@ void splash_screen(SDL_Renderer* renderer, TTF_Font* font) {
 void render_text(SDL_Renderer* renderer, TTF_Font* font, const std::string& text, SDL_Color color, int x, int y, int wrapLength) {
     /**
      * Render text to the screen
+     * This creates and destroys a texture on every call, so text drawn every frame should go through a FontCache
      *
      * @param renderer: The renderer to render the text to
      * @param font: The font to use for the text
@@ -57,14 +56,14 @@ void render_text(SDL_Renderer* renderer, TTF_Font* font, const std::string& text
     // Set up the surface for the text
     SDL_Surface* textSurface = TTF_RenderUTF8_Blended_Wrapped(font, text.c_str(), color, wrapLength);
     if (textSurface == nullptr) {
-        std::cout << "Unable to render text surface! SDL_ttf Error: " << TTF_GetError() << std::endl;
+        LOG_WARN("ui", "Unable to render text surface! SDL_ttf Error: " << TTF_GetError());
         return;
     }
 
     // Set up the texture for the text
     SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
     if (textTexture == nullptr) {
-        std::cout << "Unable to create texture from rendered text! SDL Error: " << SDL_GetError() << std::endl;
+        LOG_WARN("ui", "Unable to create texture from rendered text! SDL Error: " << SDL_GetError());
         return;
     }
 
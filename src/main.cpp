@@ -4,6 +4,7 @@
 
 #include "Config.h"
 #include "GameEngine/GameEngine.h"
+#include "Resources/AssetPack.h"
 #include "Resources/ResourceUtils.h"
 
 
@@ -14,6 +15,10 @@ int main(int argc, char* argv[]) {
      * config path is relative to the project root per bin/build-n-run.sh
      */
     loadConfig("etc/run_config.json");
+    // with a pack mounted, assets are read from it and only files it does not have are opened from disk
+    if (!ASSET_PACK.empty()) {
+        AssetPack::getMounted().mount(ASSET_PACK);
+    }
 
     SDL_Window* window = nullptr;
     SDL_Renderer* renderer = nullptr;
@@ -0,0 +1,165 @@
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "../src/Resources/AssetPack.h"
+
+namespace {
+    std::string readFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    std::string buildTestPack() {
+        std::string packPath = (std::filesystem::temp_directory_path() / "bummer_test_assets.pak").string();
+        AssetPack::build(packPath, {
+            {"tests/data/test_tone.wav", "tests/data/test_tone.wav", false},
+            {"tests/data/test_template.json", "tests/data/test_template.json", true},
+            {"tests/data/test_sprite.png", "tests/data/test_sprite.png", false},
+        });
+        return packPath;
+    }
+
+    std::string writeWithEntrySize(const std::string& packPath, const std::string& entryPath, uint64_t size) {
+        // copy a pack with one entry's unpacked size overwritten, the index is found through the header
+        std::string pack = readFile(packPath);
+        uint64_t cursor = 0;
+        std::memcpy(&cursor, pack.data() + 16, sizeof(cursor));
+        while (cursor + 32 <= pack.size()) {
+            uint32_t pathLength = 0;
+            std::memcpy(&pathLength, pack.data() + cursor + 28, sizeof(pathLength));
+            if (pack.compare(cursor + 32, pathLength, entryPath) == 0) {
+                std::memcpy(&pack[cursor + 16], &size, sizeof(size));
+                break;
+            }
+            cursor += 32 + pathLength;
+        }
+        std::string damagedPath = (std::filesystem::temp_directory_path() / "bummer_test_damaged.pak").string();
+        std::ofstream(damagedPath, std::ios::binary) << pack;
+        return damagedPath;
+    }
+}
+
+
+TEST(AssetPackTest, TestMountIndexesEveryFile) {
+    // Arrange
+    AssetPack pack;
+    std::string packPath = buildTestPack();
+
+    // Act
+    bool mounted = pack.mount(packPath);
+
+    // Assert
+    ASSERT_TRUE(mounted);
+    ASSERT_EQ(pack.getEntryCount(), 3);
+    ASSERT_NE(pack.find("tests/data/test_sprite.png"), nullptr);
+    ASSERT_EQ(pack.find("tests/data/missing.png"), nullptr);
+    ASSERT_NE(pack.find("tests/data/test_template.json")->flags & AssetPack::COMPRESSED, 0);
+    ASSERT_EQ(pack.find("tests/data/test_tone.wav")->flags & AssetPack::COMPRESSED, 0);
+    ASSERT_EQ(pack.find("tests/data/test_tone.wav")->offset % AssetPack::ALIGNMENT, 0);
+}
+
+TEST(AssetPackTest, TestReadReturnsOriginalBytes) {
+    // Arrange
+    AssetPack pack;
+    pack.mount(buildTestPack());
+    std::string json;
+    std::string wav;
+
+    // Act
+    bool readJson = pack.read("tests/data/test_template.json", json);
+    bool readWav = pack.read("tests/data/test_tone.wav", wav);
+
+    // Assert
+    ASSERT_TRUE(readJson);
+    ASSERT_TRUE(readWav);
+    ASSERT_EQ(json, readFile("tests/data/test_template.json"));
+    ASSERT_EQ(wav, readFile("tests/data/test_tone.wav"));
+}
+
+TEST(AssetPackTest, TestOpenReadsThroughRWops) {
+    // Arrange
+    AssetPack pack;
+    pack.mount(buildTestPack());
+    std::string expected = readFile("tests/data/test_template.json");
+
+    // Act
+    SDL_RWops* rw = pack.open("tests/data/test_template.json");
+    Sint64 size = SDL_RWsize(rw);
+    std::string contents(static_cast<size_t>(size), '\0');
+    size_t read = SDL_RWread(rw, contents.data(), 1, contents.size());
+    SDL_RWclose(rw);
+
+    // Assert
+    ASSERT_EQ(size, static_cast<Sint64>(expected.size()));
+    ASSERT_EQ(read, expected.size());
+    ASSERT_EQ(contents, expected);
+    ASSERT_EQ(pack.open("tests/data/missing.png"), nullptr);
+}
+
+TEST(AssetPackTest, TestListFiltersByDirectoryAndExtension) {
+    // Arrange
+    AssetPack pack;
+    pack.mount(buildTestPack());
+
+    // Act
+    std::vector<std::string> json = pack.list("tests/data", ".json");
+    std::vector<std::string> images = pack.list("tests/", ".png");
+    std::vector<std::string> none = pack.list("assets", ".png");
+
+    // Assert
+    ASSERT_EQ(json, std::vector<std::string>{"tests/data/test_template.json"});
+    ASSERT_EQ(images, std::vector<std::string>{"tests/data/test_sprite.png"});
+    ASSERT_TRUE(none.empty());
+}
+
+TEST(AssetPackTest, TestMountRejectsOtherFiles) {
+    // Arrange
+    AssetPack pack;
+
+    // Act
+    bool mounted = pack.mount("tests/data/test_sprite.png");
+
+    // Assert
+    ASSERT_FALSE(mounted);
+    ASSERT_FALSE(pack.isMounted());
+    ASSERT_EQ(pack.getEntryCount(), 0);
+}
+
+TEST(AssetPackTest, TestMountRejectsCountLargerThanIndex) {
+    // Arrange, the entry count sits at byte 8 of the header
+    std::string pack = readFile(buildTestPack());
+    uint32_t entryCount = 0xFFFFFFFF;
+    pack.replace(8, sizeof(entryCount), reinterpret_cast<const char*>(&entryCount), sizeof(entryCount));
+    std::string damagedPath = (std::filesystem::temp_directory_path() / "bummer_test_damaged.pak").string();
+    std::ofstream(damagedPath, std::ios::binary) << pack;
+    AssetPack assetPack;
+
+    // Act
+    bool mounted = assetPack.mount(damagedPath);
+
+    // Assert
+    ASSERT_FALSE(mounted);
+    ASSERT_EQ(assetPack.getEntryCount(), 0);
+}
+
+TEST(AssetPackTest, TestMountRejectsEntrySizesPastTheirBytes) {
+    // Arrange
+    std::string packPath = buildTestPack();
+    AssetPack storedPack;
+    AssetPack inflatedPack;
+
+    // Act
+    bool storedMounted = storedPack.mount(writeWithEntrySize(packPath, "tests/data/test_tone.wav", 1 << 30));
+    bool inflatedMounted = inflatedPack.mount(writeWithEntrySize(packPath, "tests/data/test_template.json", uint64_t(1) << 40));
+
+    // Assert
+    ASSERT_FALSE(storedMounted);
+    ASSERT_FALSE(inflatedMounted);
+    ASSERT_EQ(inflatedPack.getEntryCount(), 0);
+}
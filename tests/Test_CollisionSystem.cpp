@@ -2,7 +2,8 @@
 #include "../src/Systems/CollisionSystem.h"
 
 TEST(CollisionSystemTest, CheckCollision) {
-    CollisionSystem collisionSystem;
+    EventManager eventManager;
+    CollisionSystem collisionSystem(eventManager);
 
     Entity entityA(1);
     entityA.addComponent<Transform>({0, 0, 1});
@@ -19,7 +20,8 @@ TEST(CollisionSystemTest, CheckCollision) {
 }
 
 TEST(CollisionSystemTest, HandleCollisionXLeft) {
-    CollisionSystem collisionSystem;
+    EventManager eventManager;
+    CollisionSystem collisionSystem(eventManager);
 
     Entity entityA(1);
     entityA.addComponent<Transform>({100, 50, 1});
@@ -37,7 +39,8 @@ TEST(CollisionSystemTest, HandleCollisionXLeft) {
 }
 
 TEST(CollisionSystemTest, HandleCollisionXRight) {
-    CollisionSystem collisionSystem;
+    EventManager eventManager;
+    CollisionSystem collisionSystem(eventManager);
 
     Entity entityA(1);
     entityA.addComponent<Transform>({100, 50, 1});
@@ -55,7 +58,8 @@ TEST(CollisionSystemTest, HandleCollisionXRight) {
 }
 
 TEST(CollisionSystemTest, HandleCollisionYAbove) {
-    CollisionSystem collisionSystem;
+    EventManager eventManager;
+    CollisionSystem collisionSystem(eventManager);
 
     Entity entityA(1);
     entityA.addComponent<Transform>({50, 100, 1});
@@ -75,7 +79,8 @@ TEST(CollisionSystemTest, HandleCollisionYAbove) {
 }
 
 TEST(CollisionSystemTest, HandleCollisionYBelow) {
-    CollisionSystem collisionSystem;
+    EventManager eventManager;
+    CollisionSystem collisionSystem(eventManager);
 
     Entity entityA(1);
     entityA.addComponent<Transform>({50, 100, 1});
@@ -93,7 +98,8 @@ TEST(CollisionSystemTest, HandleCollisionYBelow) {
 }
 
 TEST(CollisionSystemTest, CheckCollisionX) {
-    CollisionSystem collisionSystem;
+    EventManager eventManager;
+    CollisionSystem collisionSystem(eventManager);
 
     Entity entityA(1);
     entityA.addComponent<Transform>({0, 0, 1});
@@ -110,7 +116,8 @@ TEST(CollisionSystemTest, CheckCollisionX) {
 }
 
 TEST(CollisionSystemTest, isTouchingXaxis) {
-    CollisionSystem collisionSystem;
+    EventManager eventManager;
+    CollisionSystem collisionSystem(eventManager);
 
     SDL_Rect rectA = {0, 0, 50, 50};
     SDL_Rect rectB = {60, 0, 50, 50};
@@ -121,7 +128,8 @@ TEST(CollisionSystemTest, isTouchingXaxis) {
 }
 
 TEST(CollisionSystemTest, isLeftOf) {
-    CollisionSystem collisionSystem;
+    EventManager eventManager;
+    CollisionSystem collisionSystem(eventManager);
 
     SDL_Rect rectA = {0, 0, 50, 50};
     SDL_Rect rectB = {60, 0, 50, 50};
@@ -132,7 +140,8 @@ TEST(CollisionSystemTest, isLeftOf) {
 }
 
 TEST(CollisionSystemTest, isRightOf) {
-    CollisionSystem collisionSystem;
+    EventManager eventManager;
+    CollisionSystem collisionSystem(eventManager);
 
     SDL_Rect rectA = {60, 0, 50, 50};
     SDL_Rect rectB = {0, 0, 50, 50};
@@ -143,7 +152,8 @@ TEST(CollisionSystemTest, isRightOf) {
 }
 
 TEST(CollisionSystemTest, CheckCollisionY) {
-    CollisionSystem collisionSystem;
+    EventManager eventManager;
+    CollisionSystem collisionSystem(eventManager);
 
     Entity entityA(1);
     entityA.addComponent<Transform>({0, 0, 1});
@@ -160,7 +170,8 @@ TEST(CollisionSystemTest, CheckCollisionY) {
 }
 
 TEST(CollisionSystemTest, isTouchingYaxis) {
-    CollisionSystem collisionSystem;
+    EventManager eventManager;
+    CollisionSystem collisionSystem(eventManager);
 
     SDL_Rect rectA = {0, 0, 50, 50};
     SDL_Rect rectB = {0, 60, 50, 50};
@@ -171,7 +182,8 @@ TEST(CollisionSystemTest, isTouchingYaxis) {
 }
 
 TEST(CollisionSystemTest, isAbove) {
-    CollisionSystem collisionSystem;
+    EventManager eventManager;
+    CollisionSystem collisionSystem(eventManager);
 
     SDL_Rect rectA = {0, 0, 50, 50};
     SDL_Rect rectB = {0, 60, 50, 50};
@@ -182,7 +194,8 @@ TEST(CollisionSystemTest, isAbove) {
 }
 
 TEST(CollisionSystemTest, isBelow) {
-    CollisionSystem collisionSystem;
+    EventManager eventManager;
+    CollisionSystem collisionSystem(eventManager);
 
     SDL_Rect rectA = {0, 60, 50, 50};
     SDL_Rect rectB = {0, 0, 50, 50};
@@ -193,7 +206,8 @@ TEST(CollisionSystemTest, isBelow) {
 }
 
 TEST(CollisionSystemTest, StopAndRepositionToLeft) {
-    CollisionSystem collisionSystem;
+    EventManager eventManager;
+    CollisionSystem collisionSystem(eventManager);
 
     Entity entityA(1);
     entityA.addComponent<Transform>({100, 50, 1});
@@ -211,7 +225,8 @@ TEST(CollisionSystemTest, StopAndRepositionToLeft) {
 }
 
 TEST(CollisionSystemTest, StopAndRepositionToRight) {
-    CollisionSystem collisionSystem;
+    EventManager eventManager;
+    CollisionSystem collisionSystem(eventManager);
 
     Entity entityA(1);
     entityA.addComponent<Transform>({100, 50, 1});
@@ -229,7 +244,8 @@ TEST(CollisionSystemTest, StopAndRepositionToRight) {
 }
 
 TEST(CollisionSystemTest, StopAndRepositionAbove) {
-    CollisionSystem collisionSystem;
+    EventManager eventManager;
+    CollisionSystem collisionSystem(eventManager);
 
     Entity entityA(1);
     entityA.addComponent<Transform>({50, 100, 1});
@@ -249,7 +265,8 @@ TEST(CollisionSystemTest, StopAndRepositionAbove) {
 }
 
 TEST(CollisionSystemTest, StopAndRepositionBelow) {
-    CollisionSystem collisionSystem;
+    EventManager eventManager;
+    CollisionSystem collisionSystem(eventManager);
 
     Entity entityA(1);
     entityA.addComponent<Transform>({50, 100, 1});
@@ -264,4 +281,66 @@ TEST(CollisionSystemTest, StopAndRepositionBelow) {
 
     EXPECT_EQ(entityA.getComponent<Velocity>().dy, 0);
     EXPECT_EQ(entityA.getComponent<Transform>().y, 91);
-}
\ No newline at end of file
+}
+
+static Tilemap makeFloorTilemap() {
+    // 10 x 4 map of 16px tiles at the origin with a solid floor on the bottom row
+    nlohmann::json tilemapJson;
+    tilemapJson["width"] = 10;
+    tilemapJson["height"] = 4;
+    tilemapJson["tileset"] = {{"texturePath", "tests/data/test_sprite.png"}, {"tileWidth", 16}, {"tileHeight", 16}, {"columns", 4}};
+    std::vector<int> tiles(40, Tilemap::EMPTY_TILE);
+    for (int column = 0; column < 10; column++) {
+        tiles[3 * 10 + column] = 0;
+    }
+    tilemapJson["layers"] = nlohmann::json::array({{{"name", "ground"}, {"solid", true}, {"tiles", tiles}}});
+    return Tilemap::fromJson(tilemapJson);
+}
+
+TEST(CollisionSystemTest, CollideWithTilesLandsOnFloor) {
+    EventManager eventManager;
+    CollisionSystem collisionSystem(eventManager);
+    Tilemap tilemap = makeFloorTilemap();
+
+    Entity entityA(1);
+    entityA.addComponent<Transform>({20, 20, 1});
+    entityA.addComponent<Collider>({0, 0, 30, 30});
+    entityA.addComponent<Velocity>({0, 5, 0, 1});
+
+    EXPECT_TRUE(collisionSystem.collideWithTiles(entityA, tilemap));
+    EXPECT_EQ(entityA.getComponent<Velocity>().dy, 0);
+    EXPECT_EQ(entityA.getComponent<Transform>().y, 48 - 30);
+    EXPECT_TRUE(eventManager.hasQueuedEvents());
+}
+
+TEST(CollisionSystemTest, CollideWithTilesIgnoresEmptyCells) {
+    EventManager eventManager;
+    CollisionSystem collisionSystem(eventManager);
+    Tilemap tilemap = makeFloorTilemap();
+
+    Entity entityA(1);
+    entityA.addComponent<Transform>({20, 0, 1});
+    entityA.addComponent<Collider>({0, 0, 10, 10});
+    entityA.addComponent<Velocity>({0, 5, 0, 1});
+
+    EXPECT_FALSE(collisionSystem.collideWithTiles(entityA, tilemap));
+    EXPECT_EQ(entityA.getComponent<Transform>().y, 0);
+}
+
+TEST(CollisionSystemTest, UpdateQueuesAirborneAwayFromTiles) {
+    EventManager eventManager;
+    CollisionSystem collisionSystem(eventManager);
+    std::vector<Tilemap> tilemaps = {makeFloorTilemap()};
+    EntityManager entityManager(nullptr, nullptr);
+    Entity& entity = entityManager.createEntity();
+    entity.addComponent<Transform>({500, 500, 1});
+    entity.addComponent<Collider>({0, 0, 10, 10});
+    entity.addComponent<Velocity>({0, 5, 0, 1});
+    int airborneCount = 0;
+    EventSubscription subscription = eventManager.subscribe("airborne", [&](EventData) { airborneCount++; });
+
+    collisionSystem.update(entityManager, tilemaps);
+    eventManager.flush();
+
+    EXPECT_EQ(airborneCount, 1);
+}
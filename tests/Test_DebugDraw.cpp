@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include "../src/Systems/DebugDraw.h"
+#include "../src/Systems/DebugDrawBatch.h"
+
+
+TEST(DebugDrawTest, TestDisabledOverlayCollectsNothing) {
+    // Arrange
+    DebugDraw& debugDraw = DebugDraw::getInstance();
+    debugDraw.setEnabled(false);
+
+    // Act
+    debugDraw.rect({0, 0, 10, 10}, {255, 255, 255, 255});
+    debugDraw.line(0, 0, 10, 10, {255, 255, 255, 255});
+
+    // Assert
+    ASSERT_EQ(debugDraw.getRectCount(), 0);
+    ASSERT_EQ(debugDraw.getLineCount(), 0);
+    ASSERT_FALSE(debugDraw.isEnabled(DebugDraw::COLLIDERS));
+}
+
+TEST(DebugDrawTest, TestChannelsFilterIsEnabled) {
+    // Arrange
+    DebugDraw& debugDraw = DebugDraw::getInstance();
+    debugDraw.setEnabled(true);
+
+    // Act
+    debugDraw.setChannels(DebugDraw::CONTACTS | DebugDraw::AI_RANGES);
+
+    // Assert
+    ASSERT_TRUE(debugDraw.isEnabled(DebugDraw::CONTACTS));
+    ASSERT_TRUE(debugDraw.isEnabled(DebugDraw::AI_RANGES));
+    ASSERT_FALSE(debugDraw.isEnabled(DebugDraw::COLLIDERS));
+
+    debugDraw.setChannels(DebugDraw::ALL_CHANNELS);
+    debugDraw.setEnabled(false);
+}
+
+TEST(DebugDrawTest, TestEmitCullsAndMovesShapesToScreenSpace) {
+    // Arrange
+    DebugDraw& debugDraw = DebugDraw::getInstance();
+    debugDraw.setEnabled(true);
+    debugDraw.rect({150, 120, 10, 10}, {255, 0, 0, 255});
+    debugDraw.rect({5000, 5000, 10, 10}, {255, 0, 0, 255});
+    debugDraw.line(100, 150, 300, 150, {0, 255, 0, 255});
+    debugDraw.line(-500, -500, -400, -400, {0, 255, 0, 255});
+    RenderCommandList commands;
+
+    // Act
+    debugDraw.emit(commands, {100, 100, 640, 360});
+
+    // Assert
+    ASSERT_EQ(commands.rects.size(), 1);
+    ASSERT_EQ(commands.rects[0].rect.x, 50);
+    ASSERT_EQ(commands.rects[0].rect.y, 20);
+    ASSERT_EQ(commands.lines.size(), 1);
+    ASSERT_EQ(commands.lines[0].x1, 0);
+    ASSERT_EQ(commands.lines[0].y1, 50);
+    ASSERT_EQ(debugDraw.getRectCount(), 0);
+    ASSERT_EQ(debugDraw.getLineCount(), 0);
+
+    debugDraw.setEnabled(false);
+}
+
+TEST(DebugDrawTest, TestCircleIsClosedPolyline) {
+    // Arrange
+    DebugDraw& debugDraw = DebugDraw::getInstance();
+    debugDraw.setEnabled(true);
+    RenderCommandList commands;
+
+    // Act
+    debugDraw.circle(0, 0, 50, {255, 160, 0, 255});
+    debugDraw.emit(commands, {-100, -100, 200, 200});
+
+    // Assert
+    ASSERT_EQ(commands.lines.size(), DebugDraw::CIRCLE_SEGMENTS);
+    ASSERT_EQ(commands.lines.front().x1, commands.lines.back().x2);
+    ASSERT_EQ(commands.lines.front().y1, commands.lines.back().y2);
+
+    debugDraw.setEnabled(false);
+}
+
+TEST(DebugDrawTest, TestLineGeometryIsOneQuadPerLine) {
+    // Arrange
+    std::vector<LineCommand> lines = {{0, 0, 10, 0, {255, 0, 0, 255}}, {5, 5, 5, 5, {0, 0, 255, 255}}};
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+
+    // Act
+    DebugDrawBatch::buildLineGeometry(lines, vertices, indices);
+
+    // Assert
+    ASSERT_EQ(vertices.size(), 8);
+    ASSERT_EQ(indices.size(), 12);
+    ASSERT_FLOAT_EQ(vertices[0].position.y - vertices[3].position.y, DebugDrawBatch::LINE_WIDTH);
+    ASSERT_EQ(vertices[4].color.b, 255);
+    ASSERT_EQ(indices[6], 4);
+}
+
+TEST(DebugDrawTest, TestFlushGroupsRectsByColour) {
+    // Arrange
+    DebugDrawBatch batch;
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Color red = {255, 0, 0, 255};
+    std::vector<RectCommand> rects = {
+        {{0, 0, 10, 10}, white, false},
+        {{20, 0, 10, 10}, red, false},
+        {{40, 0, 10, 10}, white, false},
+        {{60, 0, 10, 10}, red, true}
+    };
+    std::vector<LineCommand> lines = {{0, 0, 10, 10, red}, {10, 10, 20, 0, white}};
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, 80, 16, 32, SDL_PIXELFORMAT_RGBA32);
+    SDL_Renderer* renderer = SDL_CreateSoftwareRenderer(surface);
+    ASSERT_NE(renderer, nullptr);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+
+    // Act
+    int drawCalls = batch.flush(renderer, rects, lines);
+
+    // Assert
+    ASSERT_EQ(drawCalls, 4);  // white outlines, red outlines, red fill, every line
+    auto pixel = [surface](int x, int y) {
+        const Uint8* bytes = static_cast<const Uint8*>(surface->pixels) + y * surface->pitch + x * 4;
+        return SDL_Color{bytes[0], bytes[1], bytes[2], bytes[3]};
+    };
+    EXPECT_EQ(pixel(45, 0).g, 255);  // white outline
+    EXPECT_EQ(pixel(45, 5).r, 0);    // outlines are not filled
+    EXPECT_EQ(pixel(25, 9).r, 255);  // red outline
+    EXPECT_EQ(pixel(25, 9).g, 0);
+    EXPECT_EQ(pixel(65, 5).r, 255);  // red fill
+    EXPECT_EQ(pixel(65, 5).g, 0);
+    EXPECT_EQ(pixel(5, 5).r, 255);   // red line
+    EXPECT_EQ(pixel(5, 5).g, 0);
+    EXPECT_EQ(pixel(15, 5).g, 255);  // white line
+
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "../src/Systems/DrawList.h"
+
+
+TEST(DrawListTest, TestMakeSortKeyOrdersByLayerThenDepthThenTexture) {
+    // Arrange
+    uint64_t background = DrawList::makeSortKey(-1, 5, 9, 0);
+    uint64_t lowDepth = DrawList::makeSortKey(0, -3, 9, 0);
+    uint64_t highDepth = DrawList::makeSortKey(0, 2, 0, 0);
+    uint64_t laterTexture = DrawList::makeSortKey(0, 2, 1, 0);
+    uint64_t foreground = DrawList::makeSortKey(1, -100, 0, 0);
+
+    // Act / Assert
+    ASSERT_LT(background, lowDepth);
+    ASSERT_LT(lowDepth, highDepth);
+    ASSERT_LT(highDepth, laterTexture);
+    ASSERT_LT(laterTexture, foreground);
+}
+
+TEST(DrawListTest, TestSortOrdersByKey) {
+    // Arrange
+    DrawList drawList;
+    drawList.add(DrawList::makeSortKey(2, 0, 0, 0), 0);
+    drawList.add(DrawList::makeSortKey(0, 0, 3, 0), 1);
+    drawList.add(DrawList::makeSortKey(1, 0, 0, 0), 2);
+    drawList.add(DrawList::makeSortKey(0, 0, 1, 0), 3);
+
+    // Act
+    drawList.sort();
+
+    // Assert
+    const std::vector<DrawItem>& items = drawList.getItems();
+    ASSERT_EQ(items.size(), 4);
+    ASSERT_EQ(items[0].entityIndex, 3);
+    ASSERT_EQ(items[1].entityIndex, 1);
+    ASSERT_EQ(items[2].entityIndex, 2);
+    ASSERT_EQ(items[3].entityIndex, 0);
+}
+
+TEST(DrawListTest, TestSortIsStableForEqualKeys) {
+    // Arrange
+    DrawList drawList;
+    for (int i = 0; i < 5; i++) {
+        drawList.add(DrawList::makeSortKey(0, 0, i % 2, 0), i);
+    }
+
+    // Act
+    drawList.sort();
+
+    // Assert
+    const std::vector<DrawItem>& items = drawList.getItems();
+    std::vector<int> order;
+    for (const DrawItem& item : items) {
+        order.push_back(item.entityIndex);
+    }
+    ASSERT_EQ(order, std::vector<int>({0, 2, 4, 1, 3}));
+}
@@ -624,9 +624,33 @@ TEST(EntityManagerTest, TestAddComponentAnimator) {
 
     // Assert
     ASSERT_TRUE(entity.hasComponent<Animator>());
-    auto& animations = entity.getComponent<Animator>().animations;
-    ASSERT_TRUE(animations.find(EntityManager::playerStatesMap["IDLE"]) != animations.end());
+    ASSERT_TRUE(entity.getComponent<Animator>().getClip(EntityManager::playerStatesMap["IDLE"]) != nullptr);
 
     // Cleanup
     SDL_DestroyRenderer(renderer);
-}
\ No newline at end of file
+}
+
+TEST(EntityManagerTest, TestAnimatorsShareClipSet) {
+    // Arrange
+    TextureManager textureManager;
+    SDL_Renderer* renderer = SDL_CreateRenderer(SDL_CreateWindow("", 0, 0, 0, 0, 0), -1, 0);
+    EntityManager entityManager(&textureManager, renderer);
+    entityManager.createEntity();
+    entityManager.createEntity();
+    nlohmann::ordered_json componentJson;
+    componentJson["animatorPath"] = "tests/data/test_anim.json";
+
+    // Act
+    entityManager.addComponentAnimator(entityManager.getEntities()[0], componentJson);
+    entityManager.addComponentAnimator(entityManager.getEntities()[1], componentJson);
+
+    // Assert
+    const Animator& animator1 = entityManager.getEntities()[0].getComponent<Animator>();
+    const Animator& animator2 = entityManager.getEntities()[1].getComponent<Animator>();
+    ASSERT_NE(animator1.clipSet, nullptr);
+    ASSERT_EQ(animator1.clipSet, animator2.clipSet);
+    ASSERT_EQ(animator1.getClip(playerState::RUN), animator2.getClip(playerState::RUN));
+
+    // Cleanup
+    SDL_DestroyRenderer(renderer);
+}
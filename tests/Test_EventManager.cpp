@@ -4,4 +4,183 @@
 
 TEST(EventManagerTest, Test1) {
     EXPECT_EQ(1,1);
-}
\ No newline at end of file
+}
+
+TEST(EventManagerTest, TestQueueDefersUntilFlush) {
+    // Arrange
+    EventManager eventManager;
+    Entity entity(1);
+    int calls = 0;
+    EventSubscription subscription = eventManager.subscribe("testQueueDefers", [&](EventData data) {
+        calls++;
+        EXPECT_EQ(data.primaryEntity, &entity);
+    });
+
+    // Act
+    eventManager.queue("testQueueDefers", {&entity});
+    eventManager.queue("testQueueDefers", {&entity});
+
+    // Assert
+    EXPECT_EQ(calls, 0);
+    EXPECT_TRUE(eventManager.hasQueuedEvents());
+    eventManager.flush();
+    EXPECT_EQ(calls, 2);
+    EXPECT_FALSE(eventManager.hasQueuedEvents());
+}
+
+TEST(EventManagerTest, TestQueueDuringFlushWaitsForNextFlush) {
+    // Arrange
+    EventManager eventManager;
+    int firstCalls = 0;
+    int secondCalls = 0;
+    EventSubscription firstSubscription = eventManager.subscribe("testFlushFirst", [&](EventData data) {
+        firstCalls++;
+        eventManager.queue("testFlushSecond", data);
+    });
+    EventSubscription secondSubscription = eventManager.subscribe("testFlushSecond", [&](EventData data) {
+        secondCalls++;
+    });
+
+    // Act
+    eventManager.queue("testFlushFirst", {});
+    eventManager.flush();
+
+    // Assert
+    EXPECT_EQ(firstCalls, 1);
+    EXPECT_EQ(secondCalls, 0);
+    eventManager.flush();
+    EXPECT_EQ(secondCalls, 1);
+}
+
+TEST(EventManagerTest, TestQueueDuringFlushWaitsForLaterEventTypes) {
+    // Arrange
+    EventManager eventManager;
+    int secondCalls = 0;
+    EventSubscription firstSubscription = eventManager.subscribe("testFlushEarlier", [&](EventData data) {
+        eventManager.queue("testFlushLater", data);
+    });
+    EventSubscription secondSubscription = eventManager.subscribe("testFlushLater", [&](EventData data) {
+        secondCalls++;
+    });
+
+    // Act
+    eventManager.queue("testFlushEarlier", {});
+    eventManager.queue("testFlushLater", {});
+    eventManager.flush();
+
+    // Assert
+    EXPECT_EQ(secondCalls, 1);
+    EXPECT_TRUE(eventManager.hasQueuedEvents());
+    eventManager.flush();
+    EXPECT_EQ(secondCalls, 2);
+    EXPECT_FALSE(eventManager.hasQueuedEvents());
+}
+
+TEST(EventManagerTest, TestSubscriptionUnsubscribesWhenDestroyed) {
+    // Arrange
+    EventManager eventManager;
+    int calls = 0;
+
+    // Act
+    {
+        EventSubscription subscription = eventManager.subscribe("testScoped", [&](EventData data) {
+            calls++;
+        });
+        eventManager.publish("testScoped", {});
+    }
+    eventManager.publish("testScoped", {});
+
+    // Assert
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(EventManagerTest, TestUnsubscribeDuringPublish) {
+    // Arrange
+    EventManager eventManager;
+    int calls = 0;
+    EventSubscription subscription;
+    subscription = eventManager.subscribe("testSelfRemove", [&](EventData data) {
+        calls++;
+        subscription.unsubscribe();
+    });
+
+    // Act
+    eventManager.publish("testSelfRemove", {});
+    eventManager.publish("testSelfRemove", {});
+
+    // Assert
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(EventManagerTest, TestSubscribeDuringPublish) {
+    // Arrange
+    EventManager eventManager;
+    int laterCalls = 0;
+    std::vector<EventSubscription> added;
+    EventSubscription subscription = eventManager.subscribe("testSubscribeInside", [&](EventData data) {
+        // enough subscribers to force the vector being iterated to grow if they were added straight away
+        for (int i = 0; i < 16; i++) {
+            added.push_back(eventManager.subscribe("testSubscribeInside", [&](EventData data) {
+                laterCalls++;
+            }));
+        }
+    });
+
+    // Act
+    eventManager.publish("testSubscribeInside", {});
+    int callsDuringFirstPublish = laterCalls;
+    added.erase(added.begin() + 8, added.end());
+    eventManager.publish("testSubscribeInside", {});
+
+    // Assert
+    EXPECT_EQ(callsDuringFirstPublish, 0);
+    EXPECT_EQ(laterCalls, 8);
+}
+
+TEST(EventManagerTest, TestEventManagersAreIndependent) {
+    // Arrange
+    EventManager first;
+    EventManager second;
+    int firstCalls = 0;
+    int secondCalls = 0;
+    EventSubscription firstSubscription = first.subscribe("testWorld", [&](EventData data) {
+        firstCalls++;
+    });
+    EventSubscription secondSubscription = second.subscribe("testWorld", [&](EventData data) {
+        secondCalls++;
+    });
+
+    // Act
+    first.publish("testWorld", {});
+
+    // Assert
+    EXPECT_EQ(firstCalls, 1);
+    EXPECT_EQ(secondCalls, 0);
+}
+
+TEST(EventManagerTest, TestStatsCountPublishesPerFrame) {
+    // Arrange
+    EventManager eventManager;
+    eventManager.setInstrumentation(true);
+    EventSubscription subscription = eventManager.subscribe("testStats", [&](EventData data) {});
+
+    // Act
+    eventManager.publish("testStats", {});
+    eventManager.publish("testStats", {});
+    eventManager.publish("testNoSubscribers", {});
+    eventManager.endFrame();
+    eventManager.queue("testStats", {});
+    eventManager.flush();
+    eventManager.endFrame();
+
+    // Assert
+    auto stats = eventManager.getStats();
+    EXPECT_EQ(stats["testStats"].publishCount, 3);
+    EXPECT_EQ(stats["testStats"].lastFramePublishCount, 1);
+    EXPECT_EQ(stats["testStats"].maxFramePublishCount, 2);
+    EXPECT_EQ(stats["testStats"].maxQueueDepth, 1);
+    ASSERT_EQ(stats["testStats"].subscribers.size(), 1);
+    EXPECT_EQ(stats["testStats"].subscribers[0].calls, 3);
+    EXPECT_EQ(stats["testNoSubscribers"].publishCount, 1);
+    EXPECT_TRUE(stats["testNoSubscribers"].subscribers.empty());
+}
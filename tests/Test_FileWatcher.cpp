@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "../src/Resources/FileWatcher.h"
+
+namespace {
+    std::string makeWatchedDirectory(const std::string& name) {
+        std::filesystem::path directory = std::filesystem::temp_directory_path() / name;
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory / "sprites");
+        return directory.generic_string();
+    }
+
+    void writeFile(const std::string& path, const std::string& contents) {
+        std::ofstream file(path);
+        file << contents;
+    }
+
+    bool contains(const std::vector<std::string>& paths, const std::string& path) {
+        return std::find(paths.begin(), paths.end(), path) != paths.end();
+    }
+}
+
+
+TEST(FileWatcherTest, TestPollReportsSavedFilesOnce) {
+    // Arrange
+    FileWatcher watcher;
+    std::string directory = makeWatchedDirectory("bummer_watch_saved");
+    watcher.watch(directory);
+
+    // Act
+    writeFile(directory + "/alien.json", "{}");
+    writeFile(directory + "/alien.json", "{\"components\": {}}");
+    writeFile(directory + "/sprites/alien.png", "png");
+    std::vector<std::string> changed = watcher.poll();
+
+    // Assert
+    ASSERT_TRUE(watcher.isWatching());
+    ASSERT_EQ(changed.size(), 2);
+    ASSERT_TRUE(contains(changed, directory + "/alien.json"));
+    ASSERT_TRUE(contains(changed, directory + "/sprites/alien.png"));
+    ASSERT_TRUE(watcher.poll().empty());
+}
+
+TEST(FileWatcherTest, TestPollWatchesNewDirectoriesAndSkipsScratchFiles) {
+    // Arrange
+    FileWatcher watcher;
+    std::string directory = makeWatchedDirectory("bummer_watch_new");
+    watcher.watch(directory);
+    std::filesystem::create_directories(directory + "/level_two");
+    watcher.poll();
+
+    // Act
+    writeFile(directory + "/level_two/level_two.json", "{}");
+    writeFile(directory + "/.alien.json.swp", "swap");
+    writeFile(directory + "/alien.json~", "backup");
+    std::vector<std::string> changed = watcher.poll();
+
+    // Assert
+    ASSERT_EQ(changed.size(), 1);
+    ASSERT_EQ(changed[0], directory + "/level_two/level_two.json");
+}
+
+TEST(FileWatcherTest, TestWatchFailsForMissingDirectory) {
+    // Arrange
+    FileWatcher watcher;
+
+    // Act
+    bool watching = watcher.watch("no/such/directory");
+
+    // Assert
+    ASSERT_FALSE(watching);
+    ASSERT_FALSE(watcher.isWatching());
+    ASSERT_TRUE(watcher.poll().empty());
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include "../src/UI/FontCache.h"
+
+static void fillAdvances(int advances[FontCache::GLYPH_COUNT], int advance) {
+    for (int i = 0; i < FontCache::GLYPH_COUNT; i++) {
+        advances[i] = advance;
+    }
+}
+
+TEST(FontCacheTest, TestWrapTextSplitsOnNewlines) {
+    // Arrange
+    int advances[FontCache::GLYPH_COUNT];
+    fillAdvances(advances, 10);
+
+    // Act
+    std::vector<std::string> lines = FontCache::wrapText("Press\nENTER", 0, advances);
+
+    // Assert
+    ASSERT_EQ(lines, std::vector<std::string>({"Press", "ENTER"}));
+}
+
+TEST(FontCacheTest, TestWrapTextBreaksAtLastSpace) {
+    // Arrange
+    int advances[FontCache::GLYPH_COUNT];
+    fillAdvances(advances, 10);
+
+    // Act
+    std::vector<std::string> lines = FontCache::wrapText("Press ENTER to Play", 100, advances);
+
+    // Assert
+    ASSERT_EQ(lines, std::vector<std::string>({"Press", "ENTER to", "Play"}));
+}
+
+TEST(FontCacheTest, TestWrapTextKeepsLongWordWhole) {
+    // Arrange
+    int advances[FontCache::GLYPH_COUNT];
+    fillAdvances(advances, 10);
+
+    // Act
+    std::vector<std::string> lines = FontCache::wrapText("Bummer", 30, advances);
+
+    // Assert
+    ASSERT_EQ(lines, std::vector<std::string>({"Bummer"}));
+}
+
+TEST(FontCacheTest, TestGlyphIndexReplacesNonAscii) {
+    // Act / Assert
+    ASSERT_EQ(FontCache::glyphIndex('A'), 'A' - FontCache::FIRST_GLYPH);
+    ASSERT_EQ(FontCache::glyphIndex(0xC3), '?' - FontCache::FIRST_GLYPH);
+    ASSERT_EQ(FontCache::glyphIndex('\t'), '?' - FontCache::FIRST_GLYPH);
+}
+
+TEST(FontCacheTest, TestDrawTextWithoutAlphaIsOpaque) {
+    // Arrange, text is drawn by SDL's software renderer into a surface the test reads back
+    ASSERT_EQ(TTF_Init(), 0);
+    TTF_Font* font = TTF_OpenFont("assets/fonts/SuperFunky.ttf", 24);
+    ASSERT_NE(font, nullptr);
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, 128, 48, 32, SDL_PIXELFORMAT_RGBA32);
+    SDL_Renderer* renderer = SDL_CreateSoftwareRenderer(surface);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+
+    // Act
+    {
+        FontCache fontCache(renderer, font);
+        fontCache.drawText("Play", {36, 188, 148}, 0, 0);
+    }
+
+    // Assert
+    int lit = 0;
+    for (int y = 0; y < surface->h; y++) {
+        for (int x = 0; x < surface->w; x++) {
+            const Uint8* pixel = static_cast<const Uint8*>(surface->pixels) + y * surface->pitch + x * 4;
+            if (pixel[1] > 0) {
+                lit++;
+            }
+        }
+    }
+    ASSERT_GT(lit, 0);
+
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+    TTF_CloseFont(font);
+    TTF_Quit();
+}
@@ -0,0 +1,144 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "../src/ECS/HotReloader.h"
+
+namespace {
+    std::string tempPath(const std::string& name) {
+        return (std::filesystem::temp_directory_path() / name).generic_string();
+    }
+
+    void writeTemplate(const std::string& path, float gravity, float scale, int maxHealth) {
+        std::ofstream file(path);
+        file << "{\"components\": {"
+             << "\"Transform\": {\"x\": 10, \"y\": 20, \"scale\": " << scale << "},"
+             << "\"Gravity\": {\"baseGravity\": " << gravity << ", \"gravity\": " << gravity << ", \"ascendFactor\": 1,"
+             << " \"descendFactor\": 1, \"ascendMin\": 0, \"descendMax\": 10},"
+             << "\"Health\": {\"maxHealth\": " << maxHealth << ", \"currentHealth\": " << maxHealth << ", \"invincibilityFrames\": 30},"
+             << "\"Dash\": {\"speed\": " << maxHealth / 10 << ", \"initDuration\": 10, \"initCooldown\": 20}"
+             << "}}";
+    }
+
+    void writeAnimator(const std::string& path, int imageCount) {
+        std::ofstream file(path);
+        file << "{\"Animations\": {\"IDLE\": {\"spriteSheetPath\": \"assets/sprites/alien/alien_02.png\","
+             << " \"framesPerImage\": 6, \"startImage\": 0, \"imageCount\": " << imageCount << ","
+             << " \"imageWidth\": 64, \"imageHeight\": 100, \"imageY\": 0}}}";
+    }
+}
+
+
+TEST(HotReloaderTest, TestReloadTemplatePatchesLiveEntitiesAndKeepsTheirState) {
+    // Arrange
+    TextureManager textureManager;
+    EntityManager entityManager(&textureManager, nullptr);
+    SceneManager sceneManager(entityManager);
+    HotReloader hotReloader(entityManager, sceneManager);
+    std::string templatePath = tempPath("bummer_reload_alien.json");
+    writeTemplate(templatePath, 2.0f, 1.0f, 100);
+    Entity& alien = entityManager.createEntityFromTemplate(templatePath);
+    alien.getComponent<Transform>().x = 500;
+    alien.getComponent<Health>().currentHealth = 80;
+    alien.getComponent<Gravity>().gravity = 3.0f;
+    Dash& dash = alien.getComponent<Dash>();
+    dash.isDashing = true;
+    dash.currentDuration = 4.0f;
+    Entity copy = alien;
+
+    // Act
+    writeTemplate(templatePath, 5.0f, 2.0f, 50);
+    bool reloaded = hotReloader.reload(templatePath);
+
+    // Assert
+    ASSERT_TRUE(reloaded);
+    ASSERT_FLOAT_EQ(alien.getComponent<Gravity>().baseGravity, 5.0f);
+    ASSERT_FLOAT_EQ(alien.getComponent<Gravity>().gravity, 3.0f);
+    ASSERT_FLOAT_EQ(alien.getComponent<Transform>().scale, 2.0f);
+    ASSERT_EQ(alien.getComponent<Transform>().x, 500);
+    ASSERT_EQ(alien.getComponent<Health>().maxHealth, 50);
+    ASSERT_EQ(alien.getComponent<Health>().currentHealth, 50);
+    ASSERT_EQ(dash.speed, 5);
+    ASSERT_TRUE(dash.isDashing);
+    ASSERT_FLOAT_EQ(dash.currentDuration, 4.0f);
+    ASSERT_FLOAT_EQ(copy.getComponent<Gravity>().baseGravity, 5.0f);
+}
+
+TEST(HotReloaderTest, TestBrokenTemplateLeavesEntitiesUnchanged) {
+    // Arrange
+    TextureManager textureManager;
+    EntityManager entityManager(&textureManager, nullptr);
+    SceneManager sceneManager(entityManager);
+    HotReloader hotReloader(entityManager, sceneManager);
+    std::string templatePath = tempPath("bummer_reload_broken.json");
+    writeTemplate(templatePath, 2.0f, 1.0f, 100);
+    Entity& alien = entityManager.createEntityFromTemplate(templatePath);
+
+    // Act
+    std::ofstream(templatePath) << "{\"components\": {\"Gravity\": {\"gravity\": ";
+    bool reloaded = hotReloader.reload(templatePath);
+
+    // Assert
+    ASSERT_FALSE(reloaded);
+    ASSERT_FLOAT_EQ(alien.getComponent<Gravity>().baseGravity, 2.0f);
+}
+
+TEST(HotReloaderTest, TestReloadAnimatorRebuildsClipSetInPlace) {
+    // Arrange
+    TextureManager textureManager;
+    EntityManager entityManager(&textureManager, nullptr);
+    SceneManager sceneManager(entityManager);
+    HotReloader hotReloader(entityManager, sceneManager);
+    std::string animatorPath = tempPath("bummer_reload_anim.json");
+    writeAnimator(animatorPath, 2);
+    Entity& alien = entityManager.createEntity();
+    entityManager.addComponentAnimator(alien, {{"animatorPath", animatorPath}});
+    const ClipSet* clipSet = alien.getComponent<Animator>().clipSet;
+    alien.getComponent<Animator>().currentImage = 1;
+
+    // Act
+    writeAnimator(animatorPath, 4);
+    bool reloaded = hotReloader.reload(animatorPath);
+
+    // Assert
+    ASSERT_TRUE(reloaded);
+    ASSERT_EQ(alien.getComponent<Animator>().clipSet, clipSet);
+    ASSERT_EQ(alien.getComponent<Animator>().getClip(playerState::IDLE)->frames.size(), 4);
+    ASSERT_EQ(alien.getComponent<Animator>().currentImage, 0);
+}
+
+TEST(HotReloaderTest, TestFilesNothingUsesAreNotReloaded) {
+    // Arrange
+    TextureManager textureManager;
+    EntityManager entityManager(&textureManager, nullptr);
+    SceneManager sceneManager(entityManager);
+    HotReloader hotReloader(entityManager, sceneManager);
+
+    // Act
+    bool templateReloaded = hotReloader.reload("etc/templates/alien.json");
+    bool textureReloaded = hotReloader.reload("assets/sprites/alien/alien_02.png");
+
+    // Assert
+    ASSERT_FALSE(templateReloaded);
+    ASSERT_FALSE(textureReloaded);
+}
+
+TEST(HotReloaderTest, TestReloadTemplateInvalidatesRenderIndex) {
+    // Arrange
+    TextureManager textureManager;
+    EntityManager entityManager(&textureManager, nullptr);
+    SceneManager sceneManager(entityManager);
+    HotReloader hotReloader(entityManager, sceneManager);
+    std::string templatePath = tempPath("bummer_reload_scaled.json");
+    writeTemplate(templatePath, 2.0f, 1.0f, 100);
+    entityManager.createEntityFromTemplate(templatePath);
+    unsigned int version = entityManager.getStructureVersion();
+
+    // Act, the scale changes the bounds a static sprite is indexed at
+    writeTemplate(templatePath, 2.0f, 3.0f, 100);
+    hotReloader.reload(templatePath);
+
+    // Assert
+    ASSERT_NE(entityManager.getStructureVersion(), version);
+}
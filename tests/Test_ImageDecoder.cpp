@@ -0,0 +1,136 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "../src/Resources/ImageDecoder.h"
+#include "../src/Resources/TextureManager.h"
+
+namespace {
+    // stands in for a decoded surface, the tests never dereference it
+    SDL_Surface* fakeSurface(const std::string& path) {
+        return reinterpret_cast<SDL_Surface*>(static_cast<uintptr_t>(std::stoi(path) + 1));
+    }
+}
+
+
+TEST(ImageDecoderTest, TestDecodeAllKeepsPathOrder) {
+    // Arrange
+    ImageDecoder decoder(3, fakeSurface);
+    std::vector<std::string> paths = {"4", "0", "7", "2", "9"};
+
+    // Act
+    std::vector<SDL_Surface*> surfaces = decoder.decodeAll(paths);
+
+    // Assert
+    ASSERT_EQ(surfaces.size(), paths.size());
+    for (size_t i = 0; i < paths.size(); i++) {
+        ASSERT_EQ(surfaces[i], fakeSurface(paths[i]));
+    }
+}
+
+TEST(ImageDecoderTest, TestDecodesInParallel) {
+    // Arrange
+    std::atomic<int> running{0};
+    std::atomic<int> maxRunning{0};
+    ImageDecoder decoder(4, [&](const std::string& path) {
+        int now = ++running;
+        int seen = maxRunning.load();
+        while (now > seen && !maxRunning.compare_exchange_weak(seen, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        running--;
+        return fakeSurface(path);
+    });
+
+    // Act
+    decoder.decodeAll({"1", "2", "3", "4"});
+
+    // Assert
+    ASSERT_GT(maxRunning.load(), 1);
+}
+
+TEST(ImageDecoderTest, TestRequestedImagesAreHandedBackWithTheirTexture) {
+    // Arrange
+    ImageDecoder decoder(2, fakeSurface);
+    SDL_Texture* texture = reinterpret_cast<SDL_Texture*>(0x1000);
+
+    // Act
+    decoder.request("5", texture);
+    decoder.waitIdle();
+    ImageDecoder::DecodedImage image;
+    bool taken = decoder.takeDecoded(image);
+
+    // Assert
+    ASSERT_TRUE(taken);
+    ASSERT_EQ(image.target, texture);
+    ASSERT_EQ(image.surface, fakeSurface("5"));
+    ASSERT_EQ(image.path, "5");
+    ASSERT_EQ(decoder.getPendingCount(), 0);
+    ASSERT_FALSE(decoder.takeDecoded(image));
+}
+
+TEST(ImageDecoderTest, TestDiscardedDecodeNeverReachesTextureAtSameAddress) {
+    // Arrange, "1" blocks until released, real surfaces since a dropped result is freed
+    std::mutex gateMutex;
+    std::condition_variable gateChanged;
+    bool started = false;
+    bool released = false;
+    ImageDecoder decoder(2, [&](const std::string& path) {
+        if (path == "1") {
+            std::unique_lock<std::mutex> lock(gateMutex);
+            started = true;
+            gateChanged.notify_all();
+            gateChanged.wait(lock, [&] { return released; });
+        }
+        return SDL_CreateRGBSurfaceWithFormat(0, std::stoi(path), 1, 32, SDL_PIXELFORMAT_RGBA32);
+    });
+    SDL_Texture* texture = reinterpret_cast<SDL_Texture*>(0x1000);
+    decoder.request("1", texture);
+    {
+        std::unique_lock<std::mutex> lock(gateMutex);
+        gateChanged.wait(lock, [&] { return started; });
+    }
+
+    // Act, the texture is destroyed and a new placeholder gets the same address
+    decoder.discard(texture);
+    decoder.request("2", texture);
+    {
+        std::lock_guard<std::mutex> lock(gateMutex);
+        released = true;
+    }
+    gateChanged.notify_all();
+    decoder.waitIdle();
+    ImageDecoder::DecodedImage image;
+    bool taken = decoder.takeDecoded(image);
+    ImageDecoder::DecodedImage stale;
+    bool staleTaken = decoder.takeDecoded(stale);
+
+    // Assert
+    ASSERT_TRUE(taken);
+    ASSERT_EQ(image.path, "2");
+    ASSERT_EQ(image.surface->w, 2);
+    ASSERT_FALSE(staleTaken);
+    SDL_FreeSurface(image.surface);
+}
+
+TEST(ImageDecoderTest, TestReadPngSizeFromHeader) {
+    // Arrange
+    int width = 0;
+    int height = 0;
+
+    // Act
+    bool isPng = TextureManager::readPngSize("tests/data/test_sprite.png", width, height);
+    bool jsonIsPng = TextureManager::readPngSize("tests/data/test_anim.json", width, height);
+
+    // Assert
+    ASSERT_TRUE(isPng);
+    ASSERT_FALSE(jsonIsPng);
+    ASSERT_EQ(width, 512);
+    ASSERT_EQ(height, 100);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "../src/Logger.h"
+
+
+TEST(LoggerTest, TestRateLimitPerCallSite) {
+    // Arrange
+    Logger& logger = Logger::getInstance();
+    Logger::RateLimit rateLimit;
+    int allowed = 0;
+
+    // Act
+    for (int i = 0; i < Logger::MESSAGES_PER_SECOND * 3; i++) {
+        if (logger.shouldLog(LogLevel::ERROR, rateLimit)) {
+            allowed++;
+        }
+    }
+
+    // Assert
+    EXPECT_LE(allowed, Logger::MESSAGES_PER_SECOND * 2);  // at most one window rollover during the loop
+    EXPECT_GE(allowed, Logger::MESSAGES_PER_SECOND);
+    EXPECT_EQ(rateLimit.suppressed.load(), Logger::MESSAGES_PER_SECOND * 3 - allowed);
+}
+
+TEST(LoggerTest, TestLevelFilter) {
+    // Arrange
+    Logger& logger = Logger::getInstance();
+    Logger::RateLimit rateLimit;
+
+    // Act
+    logger.setLevel(LogLevel::WARN);
+    bool infoAllowed = logger.shouldLog(LogLevel::INFO, rateLimit);
+    bool errorAllowed = logger.shouldLog(LogLevel::ERROR, rateLimit);
+    logger.setLevel(LogLevel::INFO);
+
+    // Assert
+    EXPECT_FALSE(infoAllowed);
+    EXPECT_TRUE(errorAllowed);
+}
+
+TEST(LoggerTest, TestLogFromManyThreads) {
+    // Arrange
+    Logger& logger = Logger::getInstance();
+    std::vector<std::thread> threads;
+
+    // Act
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&logger, t]() {
+            for (int i = 0; i < 50; i++) {
+                logger.log(LogLevel::INFO, "test", "thread " + std::to_string(t) + " message " + std::to_string(i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    logger.flush();
+
+    // Assert
+    EXPECT_EQ(logger.getDroppedCount(), 0);
+}
@@ -0,0 +1,114 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "../src/Systems/MusicPlayer.h"
+
+namespace {
+    // 10ms of mono 16 bit samples at 8000Hz
+    constexpr int BLOCK_BYTES = 160;
+
+    // a frame of the game followed by an audio callback
+    std::vector<Sint16> mixBlock(MusicPlayer& player, int bytes = BLOCK_BYTES) {
+        player.update();
+        std::vector<Sint16> samples(bytes / 2, 0);
+        player.mix(reinterpret_cast<Uint8*>(samples.data()), bytes);
+        return samples;
+    }
+}
+
+
+TEST(MusicPlayerTest, TestTrackLoopsAtItsVolume) {
+    // Arrange
+    MusicPlayer player(8000, AUDIO_S16SYS, 1);
+    player.play(MusicPlayer::MUSIC, "tests/data/test_tone.wav", MIX_MAX_VOLUME, 0);
+
+    // Act, the file holds 800 samples
+    std::vector<Sint16> samples = mixBlock(player, 2000);
+
+    // Assert
+    ASSERT_EQ(samples.front(), 1000);
+    ASSERT_EQ(samples.back(), 1000);
+    ASSERT_EQ(player.getPath(MusicPlayer::MUSIC), "tests/data/test_tone.wav");
+}
+
+TEST(MusicPlayerTest, TestCrossfadePlaysBothTracksThenTheNewOne) {
+    // Arrange
+    MusicPlayer player(8000, AUDIO_S16SYS, 1);
+    player.play(MusicPlayer::MUSIC, "tests/data/test_tone.wav", MIX_MAX_VOLUME, 0);
+    player.play(MusicPlayer::MUSIC, "tests/data/test_tone_low.wav", MIX_MAX_VOLUME, 100);
+
+    // Act
+    std::vector<Sint16> during = mixBlock(player);
+    size_t tracksDuring = player.getTrackCount();
+    for (int i = 0; i < 10; i++) {
+        mixBlock(player);
+    }
+    std::vector<Sint16> after = mixBlock(player);
+
+    // Assert
+    ASSERT_EQ(tracksDuring, 2);
+    ASSERT_GT(during.front(), 500);
+    ASSERT_LT(during.front(), 1000);
+    ASSERT_EQ(player.getTrackCount(), 1);
+    ASSERT_EQ(after.front(), 500);
+    ASSERT_EQ(player.getPath(MusicPlayer::MUSIC), "tests/data/test_tone_low.wav");
+}
+
+TEST(MusicPlayerTest, TestStopSilencesLayer) {
+    // Arrange
+    MusicPlayer player(8000, AUDIO_S16SYS, 1);
+    player.play(MusicPlayer::AMBIENCE, "tests/data/test_tone.wav", MIX_MAX_VOLUME, 0);
+
+    // Act
+    player.stop(MusicPlayer::AMBIENCE, 0);
+    std::vector<Sint16> samples = mixBlock(player);
+
+    // Assert
+    ASSERT_EQ(samples.front(), 0);
+    ASSERT_EQ(player.getTrackCount(), 0);
+    ASSERT_EQ(player.getPath(MusicPlayer::AMBIENCE), "");
+}
+
+TEST(MusicPlayerTest, TestMissingTrackKeepsCurrentOne) {
+    // Arrange
+    MusicPlayer player(8000, AUDIO_S16SYS, 1);
+    player.play(MusicPlayer::MUSIC, "tests/data/test_tone.wav", MIX_MAX_VOLUME, 0);
+
+    // Act
+    bool played = player.play(MusicPlayer::MUSIC, "tests/data/missing.wav", MIX_MAX_VOLUME, 0);
+
+    // Assert
+    ASSERT_FALSE(played);
+    ASSERT_EQ(player.getPath(MusicPlayer::MUSIC), "tests/data/test_tone.wav");
+}
+
+TEST(MusicPlayerTest, TestLongCallbackIsMixedWhole) {
+    // Arrange
+    MusicPlayer player(8000, AUDIO_S16SYS, 1);
+    player.play(MusicPlayer::MUSIC, "tests/data/test_tone.wav", MIX_MAX_VOLUME, 0);
+
+    // Act, longer than the block the player mixes at once
+    std::vector<Sint16> samples = mixBlock(player, static_cast<int>(MusicPlayer::READ_BYTES) * 3);
+
+    // Assert
+    ASSERT_EQ(samples.front(), 1000);
+    ASSERT_EQ(samples[samples.size() / 2], 1000);
+    ASSERT_EQ(samples.back(), 1000);
+}
+
+TEST(MusicPlayerTest, TestUnderrunPlaysSilenceUntilUpdate) {
+    // Arrange
+    MusicPlayer player(8000, AUDIO_S16SYS, 1);
+    player.play(MusicPlayer::MUSIC, "tests/data/test_tone.wav", MIX_MAX_VOLUME, 0);
+
+    // Act, callbacks without a frame in between drain what was read ahead
+    std::vector<Sint16> drained(static_cast<int>(MusicPlayer::READ_BYTES) * 4, 0);
+    player.mix(reinterpret_cast<Uint8*>(drained.data()), static_cast<int>(drained.size() * 2));
+    std::vector<Sint16> afterUpdate = mixBlock(player);
+
+    // Assert
+    ASSERT_EQ(drained.front(), 1000);
+    ASSERT_EQ(drained.back(), 0);
+    ASSERT_EQ(afterUpdate.front(), 1000);
+    ASSERT_EQ(player.getTrackCount(), 1);
+}
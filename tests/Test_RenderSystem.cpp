@@ -4,4 +4,36 @@
 
 TEST(RenderSystemTest, Test1) {
     EXPECT_EQ(1,1);
-}
\ No newline at end of file
+}
+
+TEST(RenderSystemTest, TestSpritesAreGroupedByTextureHandle) {
+    // Arrange, the textures are never drawn, only compared
+    TextureManager textureManager;
+    EntityManager entityManager(&textureManager, nullptr);
+    SDL_Texture* pageA = reinterpret_cast<SDL_Texture*>(0x1000);
+    SDL_Texture* pageB = reinterpret_cast<SDL_Texture*>(0x2000);
+    SDL_Texture* textures[] = {pageA, pageB, pageA, pageB};
+    TextureHandle handles[] = {1, 2, 1, 2};
+    for (int i = 0; i < 4; i++) {
+        Entity& entity = entityManager.createEntity();
+        if (i == 0) {
+            entity.addComponent<Player>({1});
+        }
+        entity.addComponent<Transform>({i * 10, 0, 1.0f});
+        entity.addComponent<Collider>({0, 0, 8, 8});
+        entity.addComponent<Sprite>({textures[i], {0, 0, 8, 8}, handles[i]});
+    }
+    RenderSystem renderSystem;
+    RenderCommandList commands;
+
+    // Act
+    renderSystem.buildCommands(entityManager, nullptr, commands);
+
+    // Assert, entity order is kept within a texture
+    ASSERT_EQ(commands.sprites.size(), 4);
+    ASSERT_EQ(commands.sprites[0].texture, pageA);
+    ASSERT_EQ(commands.sprites[1].texture, pageA);
+    ASSERT_EQ(commands.sprites[2].texture, pageB);
+    ASSERT_EQ(commands.sprites[3].texture, pageB);
+    ASSERT_LT(commands.sprites[0].destRect.x, commands.sprites[1].destRect.x);
+}
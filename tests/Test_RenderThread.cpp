@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "../src/GameEngine/RenderThread.h"
+
+
+TEST(RenderThreadTest, TestFramesAreDrawnInOrderOnTheRenderThread) {
+    // Arrange
+    RenderThread renderThread;
+    std::thread::id renderThreadId = std::this_thread::get_id();
+    std::vector<int> drawnX;
+    bool drawnOnRenderThread = true;
+
+    // Act
+    std::thread simulation([&]() {
+        RenderCommandList commands;
+        for (int frame = 0; frame < 20; frame++) {
+            commands.sprites.push_back({nullptr, {0, 0, 8, 8}, {frame, 0, 8, 8}, SDL_FLIP_NONE});
+            renderThread.submit(commands);
+            EXPECT_TRUE(commands.sprites.empty());
+        }
+        renderThread.stop();
+    });
+    renderThread.run([&](const RenderCommandList& commands) {
+        drawnOnRenderThread = drawnOnRenderThread && std::this_thread::get_id() == renderThreadId;
+        drawnX.push_back(commands.sprites[0].destRect.x);
+    });
+    simulation.join();
+
+    // Assert
+    ASSERT_TRUE(drawnOnRenderThread);
+    ASSERT_EQ(drawnX.size(), 20);
+    for (int frame = 0; frame < 20; frame++) {
+        ASSERT_EQ(drawnX[frame], frame);
+    }
+    ASSERT_EQ(renderThread.getFramesDrawn(), 20);
+}
+
+TEST(RenderThreadTest, TestSimulationIsAtMostOneFrameAhead) {
+    // Arrange
+    RenderThread renderThread;
+    std::atomic<int> submitted{0};
+    int drawn = 0;
+    int maxAhead = 0;
+
+    // Act
+    std::thread simulation([&]() {
+        RenderCommandList commands;
+        for (int frame = 0; frame < 10; frame++) {
+            renderThread.submit(commands);
+            submitted++;
+        }
+        renderThread.stop();
+    });
+    renderThread.run([&](const RenderCommandList&) {
+        // give the simulation time to run ahead if it could
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        maxAhead = std::max(maxAhead, submitted.load() - drawn);
+        drawn++;
+    });
+    simulation.join();
+
+    // Assert
+    ASSERT_EQ(drawn, 10);
+    ASSERT_LE(maxAhead, 2);  // the frame being drawn and one waiting
+}
+
+TEST(RenderThreadTest, TestInvokeRunsTaskOnRenderThread) {
+    // Arrange
+    RenderThread renderThread;
+    std::thread::id renderThreadId = std::this_thread::get_id();
+    std::thread::id taskThreadId;
+
+    // Act
+    std::thread simulation([&]() {
+        renderThread.invoke([&]() { taskThreadId = std::this_thread::get_id(); });
+        renderThread.stop();
+    });
+    renderThread.run([](const RenderCommandList&) {});
+    simulation.join();
+
+    // Assert
+    ASSERT_EQ(taskThreadId, renderThreadId);
+}
+
+TEST(RenderThreadTest, TestInvokeRethrowsTaskException) {
+    // Arrange
+    RenderThread renderThread;
+    bool thrown = false;
+
+    // Act
+    std::thread simulation([&]() {
+        try {
+            renderThread.invoke([]() { throw std::runtime_error("texture failed"); });
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        renderThread.stop();
+    });
+    renderThread.run([](const RenderCommandList&) {});
+    simulation.join();
+
+    // Assert
+    ASSERT_TRUE(thrown);
+}
+
+TEST(RenderThreadTest, TestInvokeOnRenderThreadRunsInline) {
+    // Arrange
+    RenderThread renderThread;
+    bool ran = false;
+
+    // Act
+    renderThread.invoke([&]() { ran = true; });
+
+    // Assert
+    ASSERT_TRUE(ran);
+}
+
+TEST(RenderThreadTest, TestEventsAreLeftForInvokedTasks) {
+    // Arrange
+    ASSERT_EQ(SDL_InitSubSystem(SDL_INIT_EVENTS), 0);
+    RenderThread renderThread;
+    SDL_Event pushed = {};
+    pushed.type = SDL_USEREVENT;
+    SDL_PushEvent(&pushed);
+    bool taskSawEvent = false;
+
+    // Act
+    std::thread simulation([&]() {
+        // like the start menu, which reads its own input on the render thread
+        renderThread.invoke([&]() {
+            SDL_Event event;
+            while (SDL_PollEvent(&event) != 0) {
+                taskSawEvent = taskSawEvent || event.type == SDL_USEREVENT;
+            }
+        });
+    });
+    renderThread.runOnce([](const RenderCommandList&) {}, 5000);
+    simulation.join();
+    std::vector<SDL_Event> inbox = renderThread.takeEvents();
+    SDL_QuitSubSystem(SDL_INIT_EVENTS);
+
+    // Assert
+    ASSERT_TRUE(taskSawEvent);
+    ASSERT_TRUE(inbox.empty());
+}
@@ -1,7 +1,82 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+
 #include <gtest/gtest.h>
 #include "../src/ECS/SceneManager.h"
 
+namespace {
+    std::string tempPath(const std::string& name) {
+        return (std::filesystem::temp_directory_path() / name).generic_string();
+    }
+
+    void writeTileset(const std::string& path, int width, int height) {
+        SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+        SDL_FillRect(surface, nullptr, SDL_MapRGBA(surface->format, 255, 0, 0, 255));
+        SDL_SaveBMP(surface, path.c_str());
+        SDL_FreeSurface(surface);
+    }
+
+    std::string writeTilemapScene(const std::string& tilesetPath) {
+        std::string tilemapPath = tempPath("bummer_scene_tilemap.json");
+        std::ofstream(tilemapPath) << "{\"x\": 0, \"y\": 0, \"scale\": 1, \"width\": 2, \"height\": 1,"
+                                   << " \"tileset\": {\"texturePath\": \"" << tilesetPath << "\","
+                                   << " \"tileWidth\": 16, \"tileHeight\": 16, \"columns\": 1},"
+                                   << " \"layers\": [{\"name\": \"ground\", \"tiles\": [0, 0]}]}";
+        std::string scenePath = tempPath("bummer_scene.json");
+        std::ofstream(scenePath) << "{\"entities\": [], \"tilemaps\": [{\"path\": \"" << tilemapPath << "\"}]}";
+        return scenePath;
+    }
+}
+
 
 TEST(SceneManagerTest, Test1) {
     EXPECT_EQ(1,1);
-}
\ No newline at end of file
+}
+
+TEST(SceneManagerTest, TestRefreshTilesetsPicksUpReplacedTexture) {
+    // Arrange
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, 32, 32, 32, SDL_PIXELFORMAT_RGBA32);
+    SDL_Renderer* renderer = SDL_CreateSoftwareRenderer(surface);
+    TextureManager textureManager;
+    EntityManager entityManager(&textureManager, renderer);
+    SceneManager sceneManager(entityManager);
+    std::string tilesetPath = tempPath("bummer_scene_tileset.bmp");
+    writeTileset(tilesetPath, 16, 16);
+    sceneManager.loadSceneFromTemplate(writeTilemapScene(tilesetPath));
+    std::shared_ptr<const std::vector<Tilemap>> before = sceneManager.shareTilemaps();
+
+    // Act, a tileset that grew is replaced by a new texture
+    writeTileset(tilesetPath, 32, 16);
+    textureManager.reloadTexture(renderer, tilesetPath);
+    int unrelated = sceneManager.refreshTilesets(tempPath("bummer_other_tileset.bmp"));
+    std::shared_ptr<const std::vector<Tilemap>> afterUnrelated = sceneManager.shareTilemaps();
+    int refreshed = sceneManager.refreshTilesets(tilesetPath);
+
+    // Assert
+    ASSERT_EQ(unrelated, 0);
+    ASSERT_EQ(afterUnrelated, before);
+    ASSERT_EQ(refreshed, 1);
+    const Tilemap& tilemap = sceneManager.getTilemaps().front();
+    ASSERT_EQ(tilemap.tileset, textureManager.getTexture(tilemap.tilesetHandle));
+    ASSERT_NE(tilemap.tileset, before->front().tileset);
+    ASSERT_NE(tilemap.id, before->front().id);
+
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+}
+
+TEST(SceneManagerTest, TestHomeSceneFloorIsASolidTilemap) {
+    // Arrange
+    TextureManager textureManager;
+    EntityManager entityManager(&textureManager, nullptr);
+    SceneManager sceneManager(entityManager);
+
+    // Act
+    sceneManager.loadSceneFromTemplate("etc/templates/home/home_scene.json");
+
+    // Assert, the player is the only collider left, the floor is tested cell by cell
+    ASSERT_EQ(sceneManager.getTilemaps().size(), 1);
+    ASSERT_TRUE(sceneManager.getTilemaps().front().isSolid(0, 0));
+    ASSERT_EQ(entityManager.getEntities().size(), 1);
+}
@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "../src/ECS/SceneManifest.h"
+
+namespace {
+    bool contains(const std::vector<std::string>& paths, const std::string& path) {
+        return std::find(paths.begin(), paths.end(), path) != paths.end();
+    }
+}
+
+
+TEST(SceneManifestTest, TestBuildFollowsPrefabsToTheirFiles) {
+    // Arrange
+    std::string scenePath = "etc/templates/level_one/level_one.json";
+
+    // Act
+    SceneManifest manifest = SceneManifest::build(scenePath);
+
+    // Assert
+    ASSERT_EQ(manifest.prefabs.size(), 3);
+    ASSERT_TRUE(contains(manifest.files, scenePath));
+    ASSERT_TRUE(contains(manifest.files, "etc/templates/player.json"));
+    ASSERT_TRUE(contains(manifest.files, "assets/animations/player_anim.json"));
+    ASSERT_TRUE(contains(manifest.files, "etc/templates/attacks/basic.json"));
+    ASSERT_TRUE(contains(manifest.textures, "assets/sprites/bb/bb_idle_sheet.png"));
+    ASSERT_EQ(std::count(manifest.textures.begin(), manifest.textures.end(), "assets/sprites/environ/platform.png"), 1);
+    // music is streamed, not preloaded
+    ASSERT_TRUE(manifest.sounds.empty());
+}
+
+TEST(SceneManifestTest, TestBuildListsTilemapTilesetsAndSounds) {
+    // Arrange
+    std::filesystem::path directory = std::filesystem::temp_directory_path();
+    std::string tilemapPath = (directory / "bummer_manifest_tilemap.json").generic_string();
+    std::string scenePath = (directory / "bummer_manifest_scene.json").generic_string();
+    std::ofstream(tilemapPath) << "{\"tileset\": {\"texturePath\": \"assets/tiles/cave.png\"}}";
+    std::ofstream(scenePath) << "{\"tilemaps\": [{\"path\": \"" << tilemapPath << "\"}],"
+                             << " \"sounds\": [\"assets/sounds/jump.wav\", \"assets/sounds/jump.wav\"]}";
+
+    // Act
+    SceneManifest manifest = SceneManifest::build(scenePath);
+
+    // Assert
+    ASSERT_TRUE(contains(manifest.files, tilemapPath));
+    ASSERT_EQ(manifest.textures, std::vector<std::string>{"assets/tiles/cave.png"});
+    ASSERT_EQ(manifest.sounds, std::vector<std::string>{"assets/sounds/jump.wav"});
+}
+
+TEST(SceneManifestTest, TestMissingSceneGivesEmptyManifest) {
+    // Arrange
+    std::string scenePath = "etc/templates/no_such_scene.json";
+
+    // Act
+    SceneManifest manifest = SceneManifest::build(scenePath);
+
+    // Assert
+    ASSERT_EQ(manifest.scenePath, scenePath);
+    ASSERT_TRUE(manifest.files.empty());
+    ASSERT_TRUE(manifest.textures.empty());
+}
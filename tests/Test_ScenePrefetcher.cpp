@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <atomic>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "../src/ECS/ScenePrefetcher.h"
+
+namespace {
+    std::atomic<int> imagesDecoded{0};
+
+    SDL_Surface* fakeDecodeImage(const std::string&) {
+        imagesDecoded++;
+        return SDL_CreateRGBSurfaceWithFormat(0, 4, 4, 32, SDL_PIXELFORMAT_RGBA32);
+    }
+
+    Mix_Chunk* fakeDecodeSound(const std::string&) {
+        return nullptr;
+    }
+}
+
+
+TEST(ScenePrefetcherTest, TestTakeReturnsTheSceneFilesAndImages) {
+    // Arrange
+    ScenePrefetcher prefetcher(fakeDecodeImage, fakeDecodeSound);
+    std::string scenePath = "etc/templates/level_one/level_one.json";
+    prefetcher.start(scenePath, {});
+
+    // Act
+    ScenePrefetcher::Prefetched prefetched = prefetcher.take();
+
+    // Assert
+    ASSERT_EQ(prefetched.manifest.scenePath, scenePath);
+    ASSERT_EQ(prefetched.files.size(), prefetched.manifest.files.size());
+    ASSERT_EQ(prefetched.files[0].first, scenePath);
+    ASSERT_FALSE(prefetched.files[0].second.empty());
+    ASSERT_EQ(prefetched.images.size(), prefetched.manifest.textures.size());
+    ASSERT_TRUE(prefetcher.getScenePath().empty());
+    for (auto& [path, surface] : prefetched.images) {
+        SDL_FreeSurface(surface);
+    }
+}
+
+TEST(ScenePrefetcherTest, TestResidentTexturesAreNotDecodedAgain) {
+    // Arrange
+    ScenePrefetcher prefetcher(fakeDecodeImage, fakeDecodeSound);
+    std::string scenePath = "etc/templates/level_one/level_one.json";
+    std::vector<std::string> resident = SceneManifest::build(scenePath).textures;
+    imagesDecoded = 0;
+
+    // Act
+    prefetcher.start(scenePath, resident);
+    ScenePrefetcher::Prefetched prefetched = prefetcher.take();
+
+    // Assert
+    ASSERT_EQ(imagesDecoded, 0);
+    ASSERT_TRUE(prefetched.images.empty());
+    ASSERT_FALSE(prefetched.files.empty());
+}
+
+TEST(ScenePrefetcherTest, TestStartReplacesThePreviousScene) {
+    // Arrange
+    ScenePrefetcher prefetcher(fakeDecodeImage, fakeDecodeSound);
+    prefetcher.start("etc/templates/level_one/level_one.json", {});
+
+    // Act
+    prefetcher.start("etc/templates/home/home_scene.json", {});
+    ScenePrefetcher::Prefetched prefetched = prefetcher.take();
+
+    // Assert
+    ASSERT_EQ(prefetched.manifest.scenePath, "etc/templates/home/home_scene.json");
+    ASSERT_EQ(prefetched.files[0].first, "etc/templates/home/home_scene.json");
+    for (auto& [path, surface] : prefetched.images) {
+        SDL_FreeSurface(surface);
+    }
+}
@@ -0,0 +1,102 @@
+#include <string>
+
+#include <gtest/gtest.h>
+#include "../src/Resources/SoundBank.h"
+
+namespace {
+    int loads = 0;
+
+    // stands in for Mix_LoadWAV, which needs an open audio device
+    Mix_Chunk* fakeChunk(const std::string& path) {
+        loads++;
+        if (path == "missing.wav") {
+            return nullptr;
+        }
+        return static_cast<Mix_Chunk*>(SDL_calloc(1, sizeof(Mix_Chunk)));
+    }
+}
+
+
+TEST(SoundBankTest, TestLoadDecodesEachSoundOnce) {
+    // Arrange
+    loads = 0;
+    SoundBank soundBank(fakeChunk);
+
+    // Act
+    SoundHandle first = soundBank.load("jump.wav");
+    SoundHandle second = soundBank.load("jump.wav");
+    SoundHandle other = soundBank.load("hit.wav");
+
+    // Assert
+    ASSERT_NE(first, INVALID_SOUND_HANDLE);
+    ASSERT_EQ(first, second);
+    ASSERT_NE(first, other);
+    ASSERT_EQ(loads, 2);
+    ASSERT_EQ(soundBank.getLoadedCount(), 2);
+    ASSERT_EQ(soundBank.getPath(other), "hit.wav");
+}
+
+TEST(SoundBankTest, TestFailedLoadIsNotRetried) {
+    // Arrange
+    loads = 0;
+    SoundBank soundBank(fakeChunk);
+
+    // Act
+    SoundHandle first = soundBank.load("missing.wav");
+    SoundHandle second = soundBank.load("missing.wav");
+
+    // Assert
+    ASSERT_EQ(first, INVALID_SOUND_HANDLE);
+    ASSERT_EQ(second, INVALID_SOUND_HANDLE);
+    ASSERT_EQ(loads, 1);
+    ASSERT_EQ(soundBank.getLoadedCount(), 0);
+    ASSERT_EQ(soundBank.play(first, MIX_MAX_VOLUME), -1);
+}
+
+TEST(SoundBankTest, TestPreloadedSoundsAreNotLoadedAgain) {
+    // Arrange
+    loads = 0;
+    SoundBank soundBank(fakeChunk);
+    soundBank.preload({"jump.wav", "hit.wav", "jump.wav"});
+
+    // Act
+    SoundHandle jump = soundBank.load("jump.wav");
+
+    // Assert
+    ASSERT_EQ(loads, 2);
+    ASSERT_NE(soundBank.getChunk(jump), nullptr);
+}
+
+TEST(SoundBankTest, TestFindOnlyReturnsLoadedSounds) {
+    // Arrange
+    loads = 0;
+    SoundBank soundBank(fakeChunk);
+    SoundHandle jump = soundBank.load("jump.wav");
+
+    // Act
+    SoundHandle found = soundBank.find("jump.wav");
+    SoundHandle notLoaded = soundBank.find("hit.wav");
+
+    // Assert
+    ASSERT_EQ(found, jump);
+    ASSERT_EQ(notLoaded, INVALID_SOUND_HANDLE);
+    ASSERT_EQ(loads, 1);
+    ASSERT_EQ(soundBank.getLoadedCount(), 1);
+}
+
+TEST(SoundBankTest, TestClearForgetsSounds) {
+    // Arrange
+    loads = 0;
+    SoundBank soundBank(fakeChunk);
+    SoundHandle jump = soundBank.load("jump.wav");
+
+    // Act
+    soundBank.clear();
+    soundBank.load("jump.wav");
+
+    // Assert
+    ASSERT_EQ(loads, 2);
+    ASSERT_EQ(soundBank.getLoadedCount(), 1);
+    ASSERT_EQ(soundBank.getChunk(INVALID_SOUND_HANDLE), nullptr);
+    ASSERT_EQ(soundBank.getChunk(jump + 1), nullptr);
+}
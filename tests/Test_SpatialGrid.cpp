@@ -0,0 +1,64 @@
+#include <algorithm>
+
+#include <gtest/gtest.h>
+#include "../src/ECS/SpatialGrid.h"
+
+
+TEST(SpatialGridTest, TestQueryReturnsOnlyOverlappingItems) {
+    // Arrange
+    SpatialGrid grid(100);
+    grid.insert(0, {10, 10, 50, 50});
+    grid.insert(1, {500, 10, 50, 50});
+    grid.insert(2, {-300, -300, 50, 50});
+    std::vector<int> handles;
+
+    // Act
+    grid.query({0, 0, 200, 200}, handles);
+
+    // Assert
+    ASSERT_EQ(handles.size(), 1);
+    ASSERT_EQ(handles[0], 0);
+}
+
+TEST(SpatialGridTest, TestQueryReportsItemSpanningCellsOnce) {
+    // Arrange
+    SpatialGrid grid(32);
+    grid.insert(7, {0, 0, 200, 200});
+    std::vector<int> handles;
+
+    // Act
+    grid.query({-50, -50, 400, 400}, handles);
+
+    // Assert
+    ASSERT_EQ(handles.size(), 1);
+    ASSERT_EQ(handles[0], 7);
+}
+
+TEST(SpatialGridTest, TestQueryHandlesNegativeCoordinates) {
+    // Arrange
+    SpatialGrid grid(64);
+    grid.insert(3, {-10, -10, 5, 5});
+    std::vector<int> handles;
+
+    // Act
+    grid.query({-20, -20, 15, 15}, handles);
+
+    // Assert
+    ASSERT_EQ(handles.size(), 1);
+    ASSERT_EQ(handles[0], 3);
+}
+
+TEST(SpatialGridTest, TestClearRemovesItems) {
+    // Arrange
+    SpatialGrid grid(64);
+    grid.insert(0, {0, 0, 10, 10});
+    std::vector<int> handles;
+
+    // Act
+    grid.clear();
+    grid.query({0, 0, 100, 100}, handles);
+
+    // Assert
+    ASSERT_EQ(grid.size(), 0);
+    ASSERT_TRUE(handles.empty());
+}
@@ -0,0 +1,153 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "../src/Systems/SpriteBatch.h"
+
+namespace {
+    // Quads are drawn by SDL's software renderer into a surface the tests can read back
+    struct SoftwareTarget {
+        SDL_Surface* surface;
+        SDL_Renderer* renderer;
+
+        SoftwareTarget(int width, int height) {
+            surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+            renderer = SDL_CreateSoftwareRenderer(surface);
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+            SDL_RenderClear(renderer);
+        }
+
+        ~SoftwareTarget() {
+            SDL_DestroyRenderer(renderer);
+            SDL_FreeSurface(surface);
+        }
+
+        SDL_Color pixel(int x, int y) const {
+            const Uint8* bytes = static_cast<const Uint8*>(surface->pixels) + y * surface->pitch + x * 4;
+            return {bytes[0], bytes[1], bytes[2], bytes[3]};
+        }
+    };
+
+    SDL_Texture* createTexture(SDL_Renderer* renderer, int width, int height, const std::vector<SDL_Color>& pixels) {
+        // SDL_Color matches the byte order of RGBA32
+        SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, width, height);
+        SDL_UpdateTexture(texture, nullptr, pixels.data(), width * 4);
+        return texture;
+    }
+
+    const SDL_Color RED = {255, 0, 0, 255};
+    const SDL_Color GREEN = {0, 255, 0, 255};
+    const SDL_Color BLUE = {0, 0, 255, 255};
+    const SDL_Color BLACK = {0, 0, 0, 255};
+
+    void expectColor(const SDL_Color& actual, const SDL_Color& expected) {
+        EXPECT_EQ(actual.r, expected.r);
+        EXPECT_EQ(actual.g, expected.g);
+        EXPECT_EQ(actual.b, expected.b);
+    }
+}
+
+
+TEST(SpriteBatchTest, TestDrawGroupsConsecutiveQuadsByTexture) {
+    // Arrange
+    SoftwareTarget target(64, 16);
+    ASSERT_NE(target.renderer, nullptr);
+    SDL_Texture* textureA = createTexture(target.renderer, 4, 4, std::vector<SDL_Color>(16, RED));
+    SDL_Texture* textureB = createTexture(target.renderer, 4, 4, std::vector<SDL_Color>(16, GREEN));
+    SpriteBatch spriteBatch;
+    SDL_Rect srcRect = {0, 0, 4, 4};
+
+    // Act
+    spriteBatch.begin();
+    for (int i = 0; i < 10; i++) {
+        SDL_Rect destRect = {i * 6, 0, 6, 6};
+        spriteBatch.draw(i < 6 ? textureA : textureB, srcRect, destRect, SDL_FLIP_NONE);
+    }
+    int drawCalls = spriteBatch.flush(target.renderer);
+
+    // Assert
+    ASSERT_EQ(spriteBatch.getBatchCount(), 2);
+    ASSERT_EQ(spriteBatch.getQuadCount(), 10);
+    ASSERT_EQ(drawCalls, 2);
+    expectColor(target.pixel(3, 3), RED);
+    expectColor(target.pixel(5 * 6 + 3, 3), RED);
+    expectColor(target.pixel(6 * 6 + 3, 3), GREEN);
+    expectColor(target.pixel(9 * 6 + 3, 3), GREEN);
+    expectColor(target.pixel(3, 10), BLACK);
+
+    SDL_DestroyTexture(textureA);
+    SDL_DestroyTexture(textureB);
+}
+
+TEST(SpriteBatchTest, TestDrawKeepsOrderAcrossTextures) {
+    // Arrange
+    SoftwareTarget target(16, 16);
+    SDL_Texture* textureA = createTexture(target.renderer, 4, 4, std::vector<SDL_Color>(16, RED));
+    SDL_Texture* textureB = createTexture(target.renderer, 4, 4, std::vector<SDL_Color>(16, GREEN));
+    SpriteBatch spriteBatch;
+    SDL_Rect srcRect = {0, 0, 4, 4};
+    SDL_Rect destRect = {0, 0, 16, 16};
+
+    // Act
+    spriteBatch.begin();
+    spriteBatch.draw(textureA, srcRect, destRect, SDL_FLIP_NONE);
+    spriteBatch.draw(textureB, srcRect, destRect, SDL_FLIP_NONE);
+    spriteBatch.draw(textureA, srcRect, destRect, SDL_FLIP_NONE);
+    spriteBatch.flush(target.renderer);
+
+    // Assert
+    ASSERT_EQ(spriteBatch.getBatchCount(), 3);
+    expectColor(target.pixel(8, 8), RED);
+
+    SDL_DestroyTexture(textureA);
+    SDL_DestroyTexture(textureB);
+}
+
+TEST(SpriteBatchTest, TestBeginClearsPreviousFrame) {
+    // Arrange
+    SoftwareTarget target(16, 16);
+    SDL_Texture* texture = createTexture(target.renderer, 4, 4, std::vector<SDL_Color>(16, RED));
+    SpriteBatch spriteBatch;
+    SDL_Rect srcRect = {0, 0, 4, 4};
+    SDL_Rect destRect = {0, 0, 16, 16};
+    spriteBatch.begin();
+    spriteBatch.draw(texture, srcRect, destRect, SDL_FLIP_NONE);
+
+    // Act
+    spriteBatch.begin();
+    int drawCalls = spriteBatch.flush(target.renderer);
+
+    // Assert
+    ASSERT_EQ(spriteBatch.getBatchCount(), 0);
+    ASSERT_EQ(spriteBatch.getQuadCount(), 0);
+    ASSERT_EQ(drawCalls, 0);
+    expectColor(target.pixel(8, 8), BLACK);
+
+    SDL_DestroyTexture(texture);
+}
+
+TEST(SpriteBatchTest, TestHorizontalFlipSwapsTextureCoordinates) {
+    // Arrange
+    SoftwareTarget target(32, 8);
+    SDL_Texture* texture = createTexture(target.renderer, 2, 1, {RED, BLUE});
+    SpriteBatch spriteBatch;
+    SDL_Rect srcRect = {0, 0, 2, 1};
+
+    // Act
+    spriteBatch.begin();
+    spriteBatch.draw(texture, srcRect, {0, 0, 16, 8}, SDL_FLIP_NONE);
+    spriteBatch.draw(texture, srcRect, {16, 0, 16, 8}, SDL_FLIP_HORIZONTAL);
+    spriteBatch.flush(target.renderer);
+
+    // Assert
+    const std::vector<SDL_Vertex>& vertices = spriteBatch.getVertices(0);
+    ASSERT_EQ(vertices.size(), 8);
+    ASSERT_FLOAT_EQ(vertices[0].tex_coord.x, vertices[5].tex_coord.x);
+    ASSERT_FLOAT_EQ(vertices[1].tex_coord.x, vertices[4].tex_coord.x);
+    ASSERT_FLOAT_EQ(vertices[0].tex_coord.y, vertices[4].tex_coord.y);
+    expectColor(target.pixel(2, 4), RED);
+    expectColor(target.pixel(13, 4), BLUE);
+    expectColor(target.pixel(18, 4), BLUE);
+    expectColor(target.pixel(29, 4), RED);
+
+    SDL_DestroyTexture(texture);
+}
@@ -4,4 +4,98 @@
 
 TEST(StateMachineTest, Test1) {
     EXPECT_EQ(1,1);
-}
\ No newline at end of file
+}
+
+Entity makeStateMachineTestEntity(int id) {
+    Entity entity(id);
+    entity.addComponent<State>({playerState::IDLE, false});
+    entity.addComponent<Velocity>({0, 0, 1, 5});
+    entity.addComponent<Jumps>({1, 2, 10});
+    entity.addComponent<Animator>({{}, playerState::IDLE, 0, 0, true});
+    return entity;
+}
+
+TEST(StateMachineTest, TestJumpAndLand) {
+    // Arrange
+    TextureManager textureManager;
+    EntityManager entityManager(&textureManager, nullptr);
+    EventManager eventManager;
+    StateMachine stateMachine(entityManager, eventManager);
+    Entity entity = makeStateMachineTestEntity(1);
+    int landed = 0;
+    EventSubscription subscription = eventManager.subscribe("landed", [&](EventData data) {
+        landed++;
+    });
+
+    // Act
+    eventManager.publish("jump", {&entity});
+    eventManager.publish("airborne", {&entity});
+
+    // Assert
+    EXPECT_EQ(entity.getComponent<State>().state, playerState::FLYING);
+    EXPECT_TRUE(entity.getComponent<State>().isFlying);
+
+    // Act
+    eventManager.publish("groundCollision", {&entity});
+
+    // Assert
+    EXPECT_EQ(entity.getComponent<State>().state, playerState::IDLE);
+    EXPECT_FALSE(entity.getComponent<State>().isFlying);
+    EXPECT_EQ(entity.getComponent<Jumps>().jumps, 0);
+    EXPECT_EQ(landed, 1);
+}
+
+TEST(StateMachineTest, TestGuardsPickTransition) {
+    // Arrange
+    TextureManager textureManager;
+    EntityManager entityManager(&textureManager, nullptr);
+    EventManager eventManager;
+    StateMachine stateMachine(entityManager, eventManager);
+    Entity entity = makeStateMachineTestEntity(1);
+
+    // Act
+    entity.getComponent<Velocity>().dx = 5;
+    eventManager.publish("groundCollision", {&entity});
+
+    // Assert
+    EXPECT_EQ(entity.getComponent<State>().state, playerState::RUN);
+
+    // Act
+    entity.getComponent<Velocity>().dx = 0;
+    eventManager.publish("basicAttack", {&entity});
+    eventManager.publish("airborne", {&entity});
+    eventManager.publish("groundCollision", {&entity});
+
+    // Assert
+    EXPECT_EQ(entity.getComponent<State>().state, playerState::BASIC_ATTACK);
+    EXPECT_FALSE(entity.getComponent<State>().isFlying);
+
+    // Act
+    eventManager.publish("attackEnd", {&entity});
+
+    // Assert
+    EXPECT_EQ(entity.getComponent<State>().state, playerState::IDLE);
+}
+
+TEST(StateMachineTest, TestEnemyHitTargetsSecondaryEntity) {
+    // Arrange
+    TextureManager textureManager;
+    EntityManager entityManager(&textureManager, nullptr);
+    EventManager eventManager;
+    StateMachine stateMachine(entityManager, eventManager);
+    Entity attacker = makeStateMachineTestEntity(1);
+    Entity other = makeStateMachineTestEntity(2);
+
+    // Act
+    eventManager.publish("enemyHit", {&attacker, &other});
+
+    // Assert
+    EXPECT_EQ(attacker.getComponent<State>().state, playerState::IDLE);
+    EXPECT_EQ(other.getComponent<State>().state, playerState::HIT);
+}
+
+TEST(StateMachineTest, TestTransitionTableRejectsUnknownTrigger) {
+    ordered_json tableJson = ordered_json::parse(R"({"transitions": [{"trigger": "notAnEvent", "from": "*"}]})");
+
+    EXPECT_THROW(TransitionTable::fromJson(tableJson), std::runtime_error);
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include "../src/Resources/TextureAtlas.h"
+
+
+TEST(TextureAtlasTest, TestInsertPlacesImagesWithoutOverlap) {
+    // Arrange
+    AtlasPacker packer(64, 64, 1);
+    std::vector<AtlasPlacement> placements(6);
+
+    // Act
+    for (AtlasPlacement& placement : placements) {
+        ASSERT_TRUE(packer.insert(20, 10, placement));
+    }
+
+    // Assert
+    for (size_t i = 0; i < placements.size(); i++) {
+        const SDL_Rect& a = placements[i].rect;
+        ASSERT_EQ(placements[i].page, 0);
+        ASSERT_GE(a.x, 1);
+        ASSERT_GE(a.y, 1);
+        ASSERT_LE(a.x + a.w, 63);
+        ASSERT_LE(a.y + a.h, 63);
+        for (size_t j = i + 1; j < placements.size(); j++) {
+            const SDL_Rect& b = placements[j].rect;
+            bool overlaps = a.x < b.x + b.w + 1 && b.x < a.x + a.w + 1 && a.y < b.y + b.h + 1 && b.y < a.y + a.h + 1;
+            ASSERT_FALSE(overlaps);
+        }
+    }
+    ASSERT_EQ(packer.getPageCount(), 1);
+}
+
+TEST(TextureAtlasTest, TestInsertOpensNewPageWhenFull) {
+    // Arrange
+    AtlasPacker packer(32, 32, 0);
+    AtlasPlacement first;
+    AtlasPlacement second;
+
+    // Act
+    packer.insert(32, 20, first);
+    packer.insert(32, 20, second);
+
+    // Assert
+    ASSERT_EQ(first.page, 0);
+    ASSERT_EQ(second.page, 1);
+    ASSERT_EQ(second.rect.y, 0);
+    ASSERT_EQ(packer.getPageCount(), 2);
+    ASSERT_EQ(packer.getUsedHeight(0), 20);
+}
+
+TEST(TextureAtlasTest, TestInsertRejectsOversizedImage) {
+    // Arrange
+    AtlasPacker packer(32, 32, 1);
+    AtlasPlacement placement;
+
+    // Act
+    bool inserted = packer.insert(32, 8, placement);
+
+    // Assert
+    ASSERT_FALSE(inserted);
+    ASSERT_EQ(packer.getPageCount(), 0);
+}
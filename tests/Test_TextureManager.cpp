@@ -0,0 +1,244 @@
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include "../src/Resources/TextureManager.h"
+#include "../src/Systems/SpriteBatch.h"
+
+namespace {
+    // Textures are created by SDL's software renderer, drawing into a surface the tests can read back
+    struct SoftwareTarget {
+        SDL_Surface* surface;
+        SDL_Renderer* renderer;
+
+        SoftwareTarget(int width, int height) {
+            surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+            renderer = SDL_CreateSoftwareRenderer(surface);
+        }
+
+        ~SoftwareTarget() {
+            SDL_DestroyRenderer(renderer);
+            SDL_FreeSurface(surface);
+        }
+
+        SDL_Color pixel(int x, int y) const {
+            const Uint8* bytes = static_cast<const Uint8*>(surface->pixels) + y * surface->pitch + x * 4;
+            return {bytes[0], bytes[1], bytes[2], bytes[3]};
+        }
+    };
+
+    const std::string SPRITE_PATH = "tests/data/test_sprite.png";
+
+    std::string writeImage(const std::string& name, int width, int height, SDL_Color color) {
+        // BMP, the only format SDL writes by itself, SDL_image reads it like any other
+        std::string path = (std::filesystem::temp_directory_path() / name).generic_string();
+        SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+        SDL_FillRect(surface, nullptr, SDL_MapRGBA(surface->format, color.r, color.g, color.b, color.a));
+        SDL_SaveBMP(surface, path.c_str());
+        SDL_FreeSurface(surface);
+        return path;
+    }
+}
+
+
+TEST(TextureManagerTest, TestAcquireAndReleaseCountReferences) {
+    // Arrange
+    SoftwareTarget target(16, 16);
+    TextureManager textureManager;
+
+    // Act
+    TextureRegion first = textureManager.acquireRegion(target.renderer, SPRITE_PATH);
+    TextureRegion second = textureManager.acquireRegion(target.renderer, SPRITE_PATH);
+    textureManager.release(first.handle);
+
+    // Assert
+    ASSERT_NE(first.texture, nullptr);
+    ASSERT_NE(first.handle, INVALID_TEXTURE_HANDLE);
+    ASSERT_EQ(first.handle, second.handle);
+    ASSERT_EQ(first.texture, second.texture);
+    ASSERT_EQ(textureManager.getRefCount(first.handle), 1);
+}
+
+TEST(TextureManagerTest, TestNothingIsEvictedUnderBudget) {
+    // Arrange
+    SoftwareTarget target(16, 16);
+    TextureManager textureManager;
+    TextureRegion region = textureManager.acquireRegion(target.renderer, SPRITE_PATH);
+    textureManager.release(region.handle);
+
+    // Act
+    int evicted = textureManager.trimToBudget();
+
+    // Assert
+    ASSERT_NE(region.texture, nullptr);
+    ASSERT_EQ(evicted, 0);
+    ASSERT_EQ(textureManager.getTexture(region.handle), region.texture);
+}
+
+TEST(TextureManagerTest, TestTrimEvictsLeastRecentlyUsedUnreferencedTextures) {
+    // Arrange
+    SoftwareTarget target(16, 16);
+    TextureManager textureManager;
+    std::string oldestPath = writeImage("bummer_texture_oldest.bmp", 16, 16, {255, 0, 0, 255});
+    std::string newerPath = writeImage("bummer_texture_newer.bmp", 16, 16, {0, 255, 0, 255});
+    std::string inUsePath = writeImage("bummer_texture_in_use.bmp", 16, 16, {0, 0, 255, 255});
+    TextureRegion oldest = textureManager.acquireRegion(target.renderer, oldestPath);
+    TextureRegion newer = textureManager.acquireRegion(target.renderer, newerPath);
+    TextureRegion inUse = textureManager.acquireRegion(target.renderer, inUsePath);
+    textureManager.release(oldest.handle);
+    textureManager.release(newer.handle);
+    size_t textureBytes = textureManager.getResidentBytes() / 3;
+    textureManager.setMemoryBudget(textureBytes * 2);
+
+    // Act
+    int evicted = textureManager.trimToBudget();
+
+    // Assert
+    ASSERT_EQ(textureBytes, 16 * 16 * 4);
+    ASSERT_EQ(evicted, 1);
+    ASSERT_EQ(textureManager.getTexture(oldest.handle), nullptr);
+    ASSERT_EQ(textureManager.getTexture(newer.handle), newer.texture);
+    ASSERT_EQ(textureManager.getTexture(inUse.handle), inUse.texture);
+    ASSERT_EQ(textureManager.getResidentBytes(), textureBytes * 2);
+}
+
+TEST(TextureManagerTest, TestReferencedTexturesAreNeverEvicted) {
+    // Arrange
+    SoftwareTarget target(16, 16);
+    TextureManager textureManager;
+    TextureRegion inUse = textureManager.acquireRegion(target.renderer, SPRITE_PATH);
+    textureManager.setMemoryBudget(0);
+
+    // Act
+    int evicted = textureManager.trimToBudget();
+
+    // Assert
+    ASSERT_NE(inUse.texture, nullptr);
+    ASSERT_EQ(evicted, 0);
+    ASSERT_EQ(textureManager.getTexture(inUse.handle), inUse.texture);
+}
+
+TEST(TextureManagerTest, TestEvictedTextureReloadsUnderSameHandle) {
+    // Arrange
+    SoftwareTarget target(16, 16);
+    TextureManager textureManager;
+    TextureRegion region = textureManager.acquireRegion(target.renderer, SPRITE_PATH);
+    textureManager.release(region.handle);
+    textureManager.setMemoryBudget(0);
+    int evicted = textureManager.trimToBudget();
+
+    // Act
+    TextureRegion reloaded = textureManager.acquireRegion(target.renderer, SPRITE_PATH);
+
+    // Assert
+    ASSERT_EQ(evicted, 1);
+    ASSERT_EQ(reloaded.handle, region.handle);
+    ASSERT_NE(reloaded.texture, nullptr);
+    ASSERT_EQ(textureManager.getRefCount(reloaded.handle), 1);
+}
+
+TEST(TextureManagerTest, TestRetiredTexturesOutliveFramesInFlight) {
+    // Arrange
+    SoftwareTarget target(16, 16);
+    TextureManager textureManager;
+    SDL_Texture* texture = textureManager.loadTexture(target.renderer, SPRITE_PATH);
+
+    // Act
+    textureManager.freeTexture(texture);
+    int afterFirstFrame = textureManager.destroyRetiredTextures();
+    int afterSecondFrame = textureManager.destroyRetiredTextures();
+
+    // Assert
+    ASSERT_NE(texture, nullptr);
+    ASSERT_EQ(afterFirstFrame, 0);
+    ASSERT_EQ(afterSecondFrame, 1);
+    ASSERT_EQ(textureManager.getResidentBytes(), 0);
+}
+
+TEST(TextureManagerTest, TestAsyncPlaceholderDrawsNothingUntilUploaded) {
+    // Arrange
+    SoftwareTarget target(32, 32);
+    ASSERT_NE(target.renderer, nullptr);
+    TextureManager textureManager;
+    textureManager.enableAsyncLoading(1);
+    SDL_SetRenderDrawColor(target.renderer, 0, 0, 255, 255);
+    SDL_RenderClear(target.renderer);
+
+    // Act
+    SDL_Texture* placeholder = textureManager.loadTexture(target.renderer, "tests/data/test_sprite.png");
+    SpriteBatch spriteBatch;
+    spriteBatch.begin();
+    spriteBatch.draw(placeholder, {0, 0, 32, 32}, {0, 0, 32, 32}, SDL_FLIP_NONE);
+    spriteBatch.flush(target.renderer);
+
+    // Assert
+    ASSERT_NE(placeholder, nullptr);
+    for (int y = 0; y < 32; y += 8) {
+        for (int x = 0; x < 32; x += 8) {
+            SDL_Color color = target.pixel(x, y);
+            ASSERT_EQ(color.r, 0);
+            ASSERT_EQ(color.g, 0);
+            ASSERT_EQ(color.b, 255);
+        }
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (textureManager.getPendingUploadCount() > 0 && std::chrono::steady_clock::now() < deadline) {
+        textureManager.uploadDecodedTextures(TextureManager::UPLOADS_PER_FRAME);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(textureManager.getPendingUploadCount(), 0);
+}
+
+TEST(TextureManagerTest, TestReloadCopiesSameSizeImageIntoItsTexture) {
+    // Arrange
+    SoftwareTarget target(8, 8);
+    TextureManager textureManager;
+    std::string path = writeImage("bummer_reload_same.bmp", 8, 8, {255, 0, 0, 255});
+    TextureRegion region = textureManager.acquireRegion(target.renderer, path);
+
+    // Act
+    writeImage("bummer_reload_same.bmp", 8, 8, {0, 255, 0, 255});
+    bool reloaded = textureManager.reloadTexture(target.renderer, path);
+    SpriteBatch spriteBatch;
+    spriteBatch.begin();
+    spriteBatch.draw(region.texture, {0, 0, 8, 8}, {0, 0, 8, 8}, SDL_FLIP_NONE);
+    spriteBatch.flush(target.renderer);
+
+    // Assert
+    ASSERT_TRUE(reloaded);
+    ASSERT_EQ(textureManager.getTexture(region.handle), region.texture);
+    SDL_Color color = target.pixel(4, 4);
+    ASSERT_EQ(color.r, 0);
+    ASSERT_EQ(color.g, 255);
+    ASSERT_EQ(color.b, 0);
+}
+
+TEST(TextureManagerTest, TestReloadReplacesResizedImageAndRetiresTheOld) {
+    // Arrange
+    SoftwareTarget target(16, 8);
+    TextureManager textureManager;
+    std::string path = writeImage("bummer_reload_resized.bmp", 8, 8, {255, 0, 0, 255});
+    TextureRegion region = textureManager.acquireRegion(target.renderer, path);
+
+    // Act
+    writeImage("bummer_reload_resized.bmp", 16, 8, {0, 0, 255, 255});
+    bool reloaded = textureManager.reloadTexture(target.renderer, path);
+    SDL_Texture* replacement = textureManager.getTexture(region.handle);
+    int width = 0;
+    int height = 0;
+    SDL_QueryTexture(replacement, nullptr, nullptr, &width, &height);
+    int afterFirstFrame = textureManager.destroyRetiredTextures();
+    int afterSecondFrame = textureManager.destroyRetiredTextures();
+
+    // Assert
+    ASSERT_TRUE(reloaded);
+    ASSERT_NE(replacement, nullptr);
+    ASSERT_NE(replacement, region.texture);
+    ASSERT_EQ(width, 16);
+    ASSERT_EQ(height, 8);
+    ASSERT_EQ(textureManager.getRefCount(region.handle), 1);
+    ASSERT_EQ(afterFirstFrame, 0);
+    ASSERT_EQ(afterSecondFrame, 1);
+}
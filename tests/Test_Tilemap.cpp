@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "../src/ECS/Tilemap.h"
+#include "../src/Systems/TilemapRenderer.h"
+
+static nlohmann::json makeTilemapJson(int width, int height) {
+    nlohmann::json tilemapJson;
+    tilemapJson["x"] = 100;
+    tilemapJson["y"] = 50;
+    tilemapJson["scale"] = 2;
+    tilemapJson["width"] = width;
+    tilemapJson["height"] = height;
+    tilemapJson["tileset"] = {{"texturePath", "tests/data/test_sprite.png"}, {"tileWidth", 16}, {"tileHeight", 8}, {"columns", 4}};
+    std::vector<int> tiles(width * height, Tilemap::EMPTY_TILE);
+    tiles[1] = 5;
+    tilemapJson["layers"] = nlohmann::json::array({{{"name", "background"}, {"tiles", tiles}}});
+    return tilemapJson;
+}
+
+TEST(TilemapTest, TestFromJson) {
+    // Act
+    Tilemap tilemap = Tilemap::fromJson(makeTilemapJson(3, 2));
+
+    // Assert
+    ASSERT_EQ(tilemap.width, 3);
+    ASSERT_EQ(tilemap.height, 2);
+    ASSERT_EQ(tilemap.layers.size(), 1);
+    ASSERT_EQ(tilemap.getTile(0, 1, 0), 5);
+    ASSERT_EQ(tilemap.getTile(0, 0, 0), Tilemap::EMPTY_TILE);
+    ASSERT_EQ(tilemap.getTile(0, 5, 0), Tilemap::EMPTY_TILE);
+}
+
+TEST(TilemapTest, TestFromJsonRejectsWrongTileCount) {
+    // Arrange
+    nlohmann::json tilemapJson = makeTilemapJson(3, 2);
+    tilemapJson["width"] = 4;
+
+    // Act / Assert
+    ASSERT_THROW(Tilemap::fromJson(tilemapJson), std::runtime_error);
+}
+
+TEST(TilemapTest, TestLoadDocumentedExample) {
+    // Act
+    Tilemap tilemap = Tilemap::loadFromFile("etc/templates/tilemaps/home.json");
+
+    // Assert
+    ASSERT_EQ(tilemap.width, 16);
+    ASSERT_EQ(tilemap.height, 2);
+    ASSERT_EQ(tilemap.tilesetPath, "assets/sprites/environ/platform.png");
+    ASSERT_EQ(tilemap.getTile(0, 3, 1), 19);
+    ASSERT_TRUE(tilemap.isSolid(15, 0));
+}
+
+TEST(TilemapTest, TestGetTileSourceRect) {
+    // Arrange
+    Tilemap tilemap = Tilemap::fromJson(makeTilemapJson(3, 2));
+    tilemap.tilesetRegion = {200, 300, 64, 16};
+
+    // Act
+    SDL_Rect srcRect = tilemap.getTileSourceRect(5);
+
+    // Assert
+    ASSERT_EQ(srcRect.x, 200 + 16);
+    ASSERT_EQ(srcRect.y, 300 + 8);
+    ASSERT_EQ(srcRect.w, 16);
+    ASSERT_EQ(srcRect.h, 8);
+}
+
+TEST(TilemapTest, TestVisibleChunksOnlyCoverView) {
+    // Arrange
+    Tilemap tilemap = Tilemap::fromJson(makeTilemapJson(64, 20));  // 4 x 2 chunks, 512 x 256 world pixels each
+    int firstX, firstY, lastX, lastY;
+
+    // Act
+    TilemapRenderer::getVisibleChunks(tilemap, {100 + 600, 50, 300, 100}, firstX, firstY, lastX, lastY);
+
+    // Assert
+    ASSERT_EQ(firstX, 1);
+    ASSERT_EQ(lastX, 1);
+    ASSERT_EQ(firstY, 0);
+    ASSERT_EQ(lastY, 0);
+}
+
+TEST(TilemapTest, TestVisibleChunksEmptyWhenOffScreen) {
+    // Arrange
+    Tilemap tilemap = Tilemap::fromJson(makeTilemapJson(64, 20));
+    int firstX, firstY, lastX, lastY;
+
+    // Act
+    TilemapRenderer::getVisibleChunks(tilemap, {-2000, -2000, 500, 500}, firstX, firstY, lastX, lastY);
+
+    // Assert
+    ASSERT_GT(firstX, lastX);
+}
+
+TEST(TilemapTest, TestChunkWorldRectClipsLastChunk) {
+    // Arrange
+    Tilemap tilemap = Tilemap::fromJson(makeTilemapJson(20, 20));
+
+    // Act
+    SDL_Rect first = TilemapRenderer::getChunkWorldRect(tilemap, 0, 0);
+    SDL_Rect last = TilemapRenderer::getChunkWorldRect(tilemap, 1, 1);
+
+    // Assert
+    ASSERT_EQ(first.x, 100);
+    ASSERT_EQ(first.w, 16 * 16 * 2);
+    ASSERT_EQ(last.x, first.x + first.w);
+    ASSERT_EQ(last.w, 4 * 16 * 2);
+    ASSERT_EQ(last.h, 4 * 8 * 2);
+}
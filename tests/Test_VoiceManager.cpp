@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "../src/Systems/VoiceManager.h"
+
+namespace {
+    // every voice keeps playing until the test says otherwise
+    bool alwaysPlaying(int) {
+        return true;
+    }
+}
+
+
+TEST(VoiceManagerTest, TestSoundsGetFreeVoices) {
+    // Arrange
+    VoiceManager voices(3, alwaysPlaying);
+
+    // Act
+    int first = voices.allocate(1, MIX_MAX_VOLUME, 0);
+    int second = voices.allocate(2, MIX_MAX_VOLUME, 0);
+
+    // Assert
+    ASSERT_EQ(first, 0);
+    ASSERT_EQ(second, 1);
+    ASSERT_EQ(voices.getActiveCount(), 2);
+    ASSERT_EQ(voices.getStolenCount(), 0);
+}
+
+TEST(VoiceManagerTest, TestRepeatsWithinCooldownAreDropped) {
+    // Arrange
+    VoiceManager voices(4, alwaysPlaying);
+    voices.setSettings(1, {0, 4, 40});
+    voices.allocate(1, MIX_MAX_VOLUME, 100);
+
+    // Act
+    int repeat = voices.allocate(1, MIX_MAX_VOLUME, 120);
+    int later = voices.allocate(1, MIX_MAX_VOLUME, 140);
+
+    // Assert
+    ASSERT_EQ(repeat, -1);
+    ASSERT_NE(later, -1);
+    ASSERT_EQ(voices.getDroppedCount(), 1);
+}
+
+TEST(VoiceManagerTest, TestInstanceLimitRestartsOldestInstance) {
+    // Arrange
+    VoiceManager voices(4, alwaysPlaying);
+    voices.setSettings(1, {0, 2, 0});
+    int oldest = voices.allocate(1, MIX_MAX_VOLUME, 0);
+    voices.allocate(1, MIX_MAX_VOLUME, 10);
+
+    // Act
+    int third = voices.allocate(1, MIX_MAX_VOLUME, 20);
+
+    // Assert
+    ASSERT_EQ(third, oldest);
+    ASSERT_EQ(voices.getActiveCount(), 2);
+}
+
+TEST(VoiceManagerTest, TestStealsLowestPriorityThenQuietestVoice) {
+    // Arrange
+    VoiceManager voices(3, alwaysPlaying);
+    voices.setSettings(1, {5, 4, 0});
+    voices.setSettings(2, {1, 4, 0});
+    voices.allocate(1, MIX_MAX_VOLUME / 4, 0);
+    int loud = voices.allocate(2, MIX_MAX_VOLUME, 0);
+    int quiet = voices.allocate(2, MIX_MAX_VOLUME / 2, 10);
+
+    // Act
+    int stolen = voices.allocate(1, MIX_MAX_VOLUME, 20);
+    int stolenNext = voices.allocate(1, MIX_MAX_VOLUME, 30);
+
+    // Assert
+    ASSERT_EQ(stolen, quiet);
+    ASSERT_EQ(stolenNext, loud);
+    ASSERT_EQ(voices.getStolenCount(), 2);
+}
+
+TEST(VoiceManagerTest, TestHigherPriorityVoicesAreNotStolen) {
+    // Arrange
+    VoiceManager voices(1, alwaysPlaying);
+    voices.setSettings(1, {10, 1, 0});
+    voices.allocate(1, MIX_MAX_VOLUME, 0);
+
+    // Act
+    int channel = voices.allocate(2, MIX_MAX_VOLUME, 10);
+
+    // Assert
+    ASSERT_EQ(channel, -1);
+    ASSERT_EQ(voices.getDroppedCount(), 1);
+}
+
+TEST(VoiceManagerTest, TestFinishedVoicesAreReused) {
+    // Arrange
+    bool playing = true;
+    VoiceManager voices(1, [&playing](int) { return playing; });
+    voices.allocate(1, MIX_MAX_VOLUME, 0);
+
+    // Act
+    playing = false;
+    int channel = voices.allocate(2, MIX_MAX_VOLUME, 10);
+
+    // Assert
+    ASSERT_EQ(channel, 0);
+    ASSERT_EQ(voices.getStolenCount(), 0);
+}
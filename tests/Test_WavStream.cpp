@@ -0,0 +1,53 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "../src/Resources/WavStream.h"
+
+
+TEST(WavStreamTest, TestOpenReadsHeader) {
+    // Arrange
+    WavStream stream;
+
+    // Act
+    bool opened = stream.open("tests/data/test_tone.wav");
+
+    // Assert
+    ASSERT_TRUE(opened);
+    ASSERT_EQ(stream.getFormat(), AUDIO_S16LSB);
+    ASSERT_EQ(stream.getChannels(), 1);
+    ASSERT_EQ(stream.getFrequency(), 8000);
+    ASSERT_EQ(stream.getDataSize(), 1600);
+}
+
+TEST(WavStreamTest, TestReadsInBlocksAndRewinds) {
+    // Arrange
+    WavStream stream;
+    stream.open("tests/data/test_tone.wav");
+    std::vector<Uint8> buffer(1000);
+
+    // Act
+    size_t first = stream.read(buffer.data(), buffer.size());
+    size_t second = stream.read(buffer.data(), buffer.size());
+    bool ended = stream.atEnd();
+    stream.rewind();
+    size_t afterRewind = stream.read(buffer.data(), buffer.size());
+
+    // Assert
+    ASSERT_EQ(first, 1000);
+    ASSERT_EQ(second, 600);
+    ASSERT_TRUE(ended);
+    ASSERT_EQ(afterRewind, 1000);
+    ASSERT_EQ(reinterpret_cast<Sint16*>(buffer.data())[0], 1000);
+}
+
+TEST(WavStreamTest, TestOpenRejectsOtherFiles) {
+    // Arrange
+    WavStream stream;
+
+    // Act
+    bool opened = stream.open("tests/data/test_sprite.png");
+
+    // Assert
+    ASSERT_FALSE(opened);
+    ASSERT_FALSE(stream.isOpen());
+}
@@ -0,0 +1,52 @@
+#include <filesystem>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../src/Resources/AssetPack.h"
+
+int main(int argc, char* argv[]) {
+    /**
+     * Pack asset directories into one file the game mounts with ASSET_PACK
+     *
+     * usage: pack_assets <pack file> [--compress] <directory>...
+     * Run from the project root, files are packed under their paths relative to it, like the game loads them.
+     * --compress deflates text like templates and animations. Images, sounds and fonts are stored as they are, they
+     * barely shrink and are read straight from the mapped pack.
+     */
+    if (argc < 3) {
+        std::cerr << "usage: pack_assets <pack file> [--compress] <directory>..." << std::endl;
+        return 1;
+    }
+    const std::set<std::string> storedExtensions = {".png", ".wav", ".ogg", ".mp3", ".ttf"};
+    std::string packPath = argv[1];
+    bool compress = false;
+    std::vector<AssetPack::SourceFile> files;
+    for (int i = 2; i < argc; i++) {
+        std::string argument = argv[i];
+        if (argument == "--compress") {
+            compress = true;
+            continue;
+        }
+        std::error_code error;
+        if (!std::filesystem::is_directory(argument, error)) {
+            std::cerr << argument << " is not a directory" << std::endl;
+            return 1;
+        }
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(argument, error)) {
+            if (!entry.is_regular_file()) {
+                continue;
+            }
+            std::string path = entry.path().lexically_normal().generic_string();
+            bool stored = storedExtensions.count(entry.path().extension().string()) > 0;
+            files.push_back({path, path, compress && !stored});
+        }
+    }
+    if (!AssetPack::build(packPath, files)) {
+        std::cerr << "Failed to write " << packPath << std::endl;
+        return 1;
+    }
+    std::cout << "Packed " << files.size() << " files into " << packPath << std::endl;
+    return 0;
+}